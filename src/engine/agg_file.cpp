@@ -125,6 +125,9 @@ namespace fheroes2
 
     bool AGGFile::open( const std::string & fileName )
     {
+        _files.clear();
+        _mappedFile.close();
+
         if ( !_stream.open( fileName, "rb" ) ) {
             return false;
         }
@@ -134,14 +137,23 @@ namespace fheroes2
         const size_t fatStart = _stream.tell();
 
         // Try HoMM2 format first (12-byte entries, 32-bit hash verification).
-        if ( _openHoMM2( count, size ) ) {
-            return true;
+        bool isOpened = _openHoMM2( count, size );
+        if ( !isOpened ) {
+            // Fall back to HoMM1 format (14-byte entries, 2-byte hash, positional name match).
+            _stream.seek( fatStart );
+            _files.clear();
+            isOpened = _openHoMM1( count, size );
         }
 
-        // Fall back to HoMM1 format (14-byte entries, 2-byte hash, positional name match).
-        _stream.seek( fatStart );
-        _files.clear();
-        return _openHoMM1( count, size );
+        if ( !isOpened ) {
+            return false;
+        }
+
+        // Map the whole archive into memory if the platform supports it so that resources can be accessed without copying them.
+        // If it is not possible, then all resources are read from the file stream.
+        _mappedFile.open( fileName );
+
+        return true;
     }
 
     std::vector<std::string> AGGFile::getFileNames() const
@@ -183,12 +195,33 @@ namespace fheroes2
         }
 
         const auto [fileSize, fileOffset] = it->second;
-        if ( fileSize > 0 ) {
-            _stream.seek( fileOffset );
-            return _stream.getRaw( fileSize );
+        if ( fileSize == 0 ) {
+            return {};
+        }
+
+        if ( _mappedFile.isOpen() ) {
+            const auto [data, dataSize] = _mappedFile.getView( fileOffset, fileSize );
+
+            return { data, data + dataSize };
+        }
+
+        _stream.seek( fileOffset );
+        return _stream.getRaw( fileSize );
+    }
+
+    std::pair<const uint8_t *, size_t> AGGFile::getView( const std::string_view fileName ) const
+    {
+        const auto it = _files.find( fileName );
+        if ( it == _files.end() ) {
+            return { nullptr, 0 };
+        }
+
+        const auto [fileSize, fileOffset] = it->second;
+        if ( fileSize == 0 ) {
+            return { nullptr, 0 };
         }
 
-        return {};
+        return _mappedFile.getView( fileOffset, fileSize );
     }
 
     uint32_t calculateAggFilenameHash( const std::string_view str )
@@ -29,6 +29,7 @@
 #include <utility>
 #include <vector>
 
+#include "memory_mapped_file.h"
 #include "serialize.h"
 
 namespace fheroes2
@@ -41,9 +42,21 @@ namespace fheroes2
             return !_stream.fail() && !_files.empty();
         }
 
+        // Returns true if the archive is memory mapped. In this case its content can be accessed through getView() and both
+        // read() and getView() can be safely called from multiple threads at the same time.
+        bool isMapped() const
+        {
+            return _mappedFile.isOpen();
+        }
+
         bool open( const std::string & fileName );
         std::vector<std::string> getFileNames() const;
         std::vector<uint8_t> read( const std::string & fileName );
+
+        // Returns a non-owning view of the given file in the memory mapped archive. The view stays valid as long as this object
+        // exists and is not reopened. An empty view ({ nullptr, 0 }) is returned if the file is absent or the archive is not mapped.
+        std::pair<const uint8_t *, size_t> getView( const std::string_view fileName ) const;
+
         std::vector<std::string> getFileNamesWithExtension( std::string_view ext ) const;
 
     private:
@@ -53,6 +66,7 @@ namespace fheroes2
         bool _openHoMM1( size_t count, size_t size );
 
         StreamFile _stream;
+        MemoryMappedFile _mappedFile;
         std::map<std::string, std::pair<uint32_t, uint32_t>, std::less<>> _files;
     };
 
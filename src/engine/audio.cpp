@@ -115,16 +115,14 @@ namespace
         ~SoundSampleManager()
         {
             // Make sure that all sound samples have been eventually freed
-            assert( std::all_of( _channelSamples.begin(), _channelSamples.end(), []( const auto & item ) {
-                static const decltype( item.second ) nullQueue{ nullptr, nullptr };
-
-                return item.second == nullQueue;
-            } ) );
+            assert( std::all_of( _channelSamples.begin(), _channelSamples.end(),
+                                 []( const auto & item ) { return item.second.first == nullptr && item.second.second == nullptr; } ) );
         }
 
         SoundSampleManager & operator=( const SoundSampleManager & ) = delete;
 
-        void channelStarted( const int channelId, Mix_Chunk * sample )
+        // The sample is freed when it is no longer used by any channel, unless it is also kept in the cache of sounds.
+        void channelStarted( const int channelId, std::shared_ptr<Mix_Chunk> sample )
         {
             assert( channelId >= 0 && sample != nullptr );
 
@@ -134,10 +132,10 @@ namespace
                 auto & sampleQueue = iter->second;
 
                 if ( sampleQueue.first == nullptr ) {
-                    sampleQueue.first = sample;
+                    sampleQueue.first = std::move( sample );
                 }
                 else if ( sampleQueue.second == nullptr ) {
-                    sampleQueue.second = sample;
+                    sampleQueue.second = std::move( sample );
                 }
                 else {
                     // The sample queue is already full, this shouldn't happen
@@ -147,7 +145,7 @@ namespace
                 return;
             }
 
-            const auto res = _channelSamples.try_emplace( channelId, std::make_pair( sample, nullptr ) );
+            const auto res = _channelSamples.try_emplace( channelId, std::move( sample ), nullptr );
             if ( !res.second ) {
                 assert( 0 );
             }
@@ -180,16 +178,14 @@ namespace
                 auto & sampleQueue = iter->second;
                 assert( sampleQueue.first != nullptr );
 
-                Mix_FreeChunk( sampleQueue.first );
-
                 // Shift the sample queue
-                sampleQueue.first = sampleQueue.second;
-                sampleQueue.second = nullptr;
+                sampleQueue.first = std::move( sampleQueue.second );
+                sampleQueue.second.reset();
             }
         }
 
     private:
-        std::map<int, std::pair<Mix_Chunk *, Mix_Chunk *>> _channelSamples;
+        std::map<int, std::pair<std::shared_ptr<Mix_Chunk>, std::shared_ptr<Mix_Chunk>>> _channelSamples;
 
         std::vector<int> _channelsToCleanup;
         // This mutex protects operations with _channelsToCleanup
@@ -198,6 +194,111 @@ namespace
 
     SoundSampleManager soundSampleManager;
 
+    // Decoded sound samples of the sounds with UIDs. Samples are shared with SoundSampleManager while they are being played, so a sample
+    // is considered to be in use if the cache is not its only owner. Samples that are in use are never removed from the cache.
+    class SoundCache
+    {
+    public:
+        SoundCache() = default;
+        SoundCache( const SoundCache & ) = delete;
+
+        ~SoundCache()
+        {
+            assert( _samples.empty() );
+        }
+
+        SoundCache & operator=( const SoundCache & ) = delete;
+
+        std::shared_ptr<Mix_Chunk> get( const uint64_t soundUID )
+        {
+            const auto iter = _sampleIndex.find( soundUID );
+            if ( iter == _sampleIndex.end() ) {
+                ++_statistics.misses;
+                return {};
+            }
+
+            ++_statistics.hits;
+
+            // Move the sample to the beginning of the list of the most recently used samples
+            _samples.splice( _samples.begin(), _samples, iter->second );
+
+            return iter->second->sample;
+        }
+
+        void add( const uint64_t soundUID, std::shared_ptr<Mix_Chunk> sample )
+        {
+            assert( sample != nullptr && _sampleIndex.find( soundUID ) == _sampleIndex.end() );
+
+            _statistics.size += sample->alen;
+
+            _samples.push_front( { soundUID, std::move( sample ) } );
+            _sampleIndex.try_emplace( soundUID, _samples.begin() );
+
+            evictUnusedSamples();
+        }
+
+        void setLimit( const size_t bytes )
+        {
+            _limit = bytes;
+
+            evictUnusedSamples();
+        }
+
+        const Mixer::SoundCacheStatistics & getStatistics() const
+        {
+            return _statistics;
+        }
+
+        void clear()
+        {
+            // All sound samples should have been stopped at this point
+            assert( std::all_of( _samples.begin(), _samples.end(), []( const SampleInfo & info ) { return info.sample.use_count() == 1; } ) );
+
+            _sampleIndex.clear();
+            _samples.clear();
+
+            _statistics.size = 0;
+        }
+
+    private:
+        struct SampleInfo
+        {
+            uint64_t soundUID{ 0 };
+            std::shared_ptr<Mix_Chunk> sample;
+        };
+
+        void evictUnusedSamples()
+        {
+            // Start with the least recently used samples
+            auto iter = _samples.end();
+
+            while ( _statistics.size > _limit && iter != _samples.begin() ) {
+                --iter;
+
+                if ( iter->sample.use_count() > 1 ) {
+                    continue;
+                }
+
+                _statistics.size -= iter->sample->alen;
+                ++_statistics.evictions;
+
+                _sampleIndex.erase( iter->soundUID );
+                iter = _samples.erase( iter );
+            }
+        }
+
+        // The most recently used samples go first
+        std::list<SampleInfo> _samples;
+        std::map<uint64_t, std::list<SampleInfo>::iterator> _sampleIndex;
+
+        // Decoded samples are several times larger than the original WAV data because they are converted to the format of the audio device
+        size_t _limit{ 16 * 1024 * 1024 };
+
+        Mixer::SoundCacheStatistics _statistics;
+    };
+
+    SoundCache soundCache;
+
     // This is the callback function set by Mix_ChannelFinished(). As a rule, it is called from
     // a SDL_Mixer internal thread. Calls of any SDL_Mixer functions are not allowed in callbacks.
     void SDLCALL channelFinished( const int channelId )
@@ -612,6 +713,72 @@ namespace
         return true;
     }
 #endif
+
+    std::shared_ptr<Mix_Chunk> decodeSample( const uint8_t * ptr, const uint32_t size )
+    {
+        const std::unique_ptr<SDL_RWops, void ( * )( SDL_RWops * )> rwops( SDL_RWFromConstMem( ptr, static_cast<int>( size ) ), SDL_FreeRW );
+        if ( !rwops ) {
+            ERROR_LOG( "Failed to create an audio chunk from memory. The error: " << SDL_GetError() )
+            return {};
+        }
+
+        std::shared_ptr<Mix_Chunk> sample( Mix_LoadWAV_RW( rwops.get(), 0 ), Mix_FreeChunk );
+        if ( !sample ) {
+            ERROR_LOG( "Failed to create an audio chunk from memory. The error: " << Mix_GetError() )
+            return {};
+        }
+
+        return sample;
+    }
+
+    // This function should be called under the audioMutex
+    int playSample( std::shared_ptr<Mix_Chunk> sample, const bool loop, const std::optional<std::pair<int16_t, uint8_t>> position )
+    {
+        assert( sample != nullptr );
+
+        // SDL itself maintains all internal channel bookkeeping, so when using the "first free channel"
+        // for playback, it is not known in advance which channel will be used. If additional channel
+        // setup is needed, then, to avoid arbitrary volume fluctuations, we will temporarily mute the
+        // audio chunk itself until we can properly adjust the channel parameters.
+        const int chunkVolume = position ? Mix_VolumeChunk( sample.get(), 0 ) : 0;
+        if ( chunkVolume < 0 ) {
+            ERROR_LOG( "Failed to mute the audio chunk. The error: " << Mix_GetError() )
+            return -1;
+        }
+
+        const int channel = Mix_PlayChannel( -1, sample.get(), loop ? -1 : 0 );
+        if ( channel < 0 ) {
+            ERROR_LOG( "Failed to play the audio chunk. The error: " << Mix_GetError() )
+
+            if ( position ) {
+                Mix_VolumeChunk( sample.get(), chunkVolume );
+            }
+
+            return channel;
+        }
+
+        if ( position ) {
+            // Immediately pause the channel so as not to continue playing while it is being set up
+            Mix_Pause( channel );
+
+            Mixer::setPosition( channel, position->first, position->second );
+
+            // When restoring the volume of an audio chunk, the only correct result of the call is zero,
+            // because this is exactly what the volume of the muted chunk should be
+            if ( Mix_VolumeChunk( sample.get(), chunkVolume ) != 0 ) {
+                ERROR_LOG( "Failed to restore the volume of the audio chunk for channel " << channel << ". The error: " << Mix_GetError() )
+            }
+
+            // Resume the channel as soon as all its parameters are settled
+            Mix_Resume( channel );
+        }
+
+        // There can be a maximum of two items in the sample queue for a channel:
+        // the previous sample (if it hasn't been freed yet) and the current one
+        soundSampleManager.channelStarted( channel, std::move( sample ) );
+
+        return channel;
+    }
 }
 
 void Audio::Init()
@@ -730,6 +897,15 @@ void Audio::Quit()
 
         soundSampleManager.clearFinishedSamples();
 
+        {
+            const Mixer::SoundCacheStatistics & stats = soundCache.getStatistics();
+            DEBUG_LOG( DBG_ENGINE, DBG_INFO,
+                       "Sound cache: " << stats.hits << " hits, " << stats.misses << " misses, " << stats.evictions << " evictions, " << stats.size
+                                       << " bytes in use" )
+        }
+
+        soundCache.clear();
+
         musicTrackManager.clearFinishedMusic();
         musicTrackManager.clearMusicDB();
 
@@ -842,55 +1018,71 @@ int Mixer::Play( const uint8_t * ptr, const uint32_t size, const bool loop, cons
 
     soundSampleManager.clearFinishedSamples();
 
-    const std::unique_ptr<SDL_RWops, void ( * )( SDL_RWops * )> rwops( SDL_RWFromConstMem( ptr, static_cast<int>( size ) ), SDL_FreeRW );
-    if ( !rwops ) {
-        ERROR_LOG( "Failed to create an audio chunk from memory. The error: " << SDL_GetError() )
+    std::shared_ptr<Mix_Chunk> sample = decodeSample( ptr, size );
+    if ( !sample ) {
         return -1;
     }
 
-    std::unique_ptr<Mix_Chunk, void ( * )( Mix_Chunk * )> sample( Mix_LoadWAV_RW( rwops.get(), 0 ), Mix_FreeChunk );
-    if ( !sample ) {
-        ERROR_LOG( "Failed to create an audio chunk from memory. The error: " << Mix_GetError() )
+    return playSample( std::move( sample ), loop, position );
+}
+
+int Mixer::Play( const uint64_t soundUID, const uint8_t * ptr, const uint32_t size, const bool loop,
+                 const std::optional<std::pair<int16_t, uint8_t>> position /* = {} */ )
+{
+    if ( ptr == nullptr || size == 0 ) {
+        // You are trying to play an empty sound. Check your logic!
+        assert( 0 );
         return -1;
     }
 
-    // SDL itself maintains all internal channel bookkeeping, so when using the "first free channel"
-    // for playback, it is not known in advance which channel will be used. If additional channel
-    // setup is needed, then, to avoid arbitrary volume fluctuations, we will temporarily mute the
-    // audio chunk itself until we can properly adjust the channel parameters.
-    const int chunkVolume = position ? Mix_VolumeChunk( sample.get(), 0 ) : 0;
-    if ( chunkVolume < 0 ) {
-        ERROR_LOG( "Failed to mute the audio chunk. The error: " << Mix_GetError() )
+    const std::scoped_lock<std::recursive_mutex> lock( audioMutex );
+
+    if ( !isInitialized ) {
         return -1;
     }
 
-    const int channel = Mix_PlayChannel( -1, sample.get(), loop ? -1 : 0 );
-    if ( channel < 0 ) {
-        ERROR_LOG( "Failed to play the audio chunk. The error: " << Mix_GetError() )
-        return channel;
-    }
+    soundSampleManager.clearFinishedSamples();
 
-    if ( position ) {
-        // Immediately pause the channel so as not to continue playing while it is being set up
-        Mix_Pause( channel );
+    std::shared_ptr<Mix_Chunk> sample = soundCache.get( soundUID );
 
-        setPosition( channel, position->first, position->second );
+    // Positioned sounds temporarily mute the sample itself (see playSample()), so a sample that is being played right now on
+    // another channel cannot be used for them. Use a separate copy of this sample instead.
+    if ( sample && position && sample.use_count() > 2 ) {
+        sample = decodeSample( ptr, size );
+        if ( !sample ) {
+            return -1;
+        }
 
-        // When restoring the volume of an audio chunk, the only correct result of the call is zero,
-        // because this is exactly what the volume of the muted chunk should be
-        if ( Mix_VolumeChunk( sample.get(), chunkVolume ) != 0 ) {
-            ERROR_LOG( "Failed to restore the volume of the audio chunk for channel " << channel << ". The error: " << Mix_GetError() )
+        return playSample( std::move( sample ), loop, position );
+    }
+
+    if ( !sample ) {
+        sample = decodeSample( ptr, size );
+        if ( !sample ) {
+            return -1;
         }
 
-        // Resume the channel as soon as all its parameters are settled
-        Mix_Resume( channel );
+        soundCache.add( soundUID, sample );
     }
 
-    // There can be a maximum of two items in the sample queue for a channel:
-    // the previous sample (if it hasn't been freed yet) and the current one
-    soundSampleManager.channelStarted( channel, sample.release() );
+    return playSample( std::move( sample ), loop, position );
+}
+
+void Mixer::setSoundCacheLimit( const size_t bytes )
+{
+    const std::scoped_lock<std::recursive_mutex> lock( audioMutex );
+
+    // Samples that have finished playing can be removed from the cache right away
+    soundSampleManager.clearFinishedSamples();
+
+    soundCache.setLimit( bytes );
+}
+
+Mixer::SoundCacheStatistics Mixer::getSoundCacheStatistics()
+{
+    const std::scoped_lock<std::recursive_mutex> lock( audioMutex );
 
-    return channel;
+    return soundCache.getStatistics();
 }
 
 void Mixer::setPosition( const int channelId, const int16_t angle, const uint8_t distance )
@@ -23,6 +23,7 @@
 
 #pragma once
 
+#include <cstddef>
 #include <cstdint>
 #include <optional>
 #include <string>
@@ -55,6 +56,26 @@ namespace Mixer
     // of direction to the sound source in degrees and the distance to the sound source).
     int Play( const uint8_t * ptr, const uint32_t size, const bool loop, const std::optional<std::pair<int16_t, uint8_t>> position = {} );
 
+    // Same as above, but the decoded sound is kept in the cache of sounds under the given UID, so the sound data is decoded only
+    // if there is no sound with this UID in the cache. The sound data for the same UID must always be the same.
+    int Play( const uint64_t soundUID, const uint8_t * ptr, const uint32_t size, const bool loop, const std::optional<std::pair<int16_t, uint8_t>> position = {} );
+
+    struct SoundCacheStatistics
+    {
+        uint64_t hits{ 0 };
+        uint64_t misses{ 0 };
+        uint64_t evictions{ 0 };
+
+        // Total size of decoded sounds in the cache, in bytes.
+        size_t size{ 0 };
+    };
+
+    // Sets the maximum total size of decoded sounds in the cache, in bytes. The least recently played sounds are removed from the cache
+    // when this size is exceeded, except for the sounds that are being played at the moment.
+    void setSoundCacheLimit( const size_t bytes );
+
+    SoundCacheStatistics getSoundCacheStatistics();
+
     void setVolume( const int volumePercentage );
 
     // Sets the position of the sound source relative to the listener (the angle of direction to
@@ -46,6 +46,7 @@ namespace fheroes2
     {
         _fileNameAndOffset.clear();
         _fileStream.close();
+        _mappedFile.close();
 
         if ( !_fileStream.open( path, "rb" ) ) {
             return false;
@@ -79,6 +80,9 @@ namespace fheroes2
             _fileNameAndOffset.try_emplace( std::move( name ), std::make_pair( offset, size ) );
         }
 
+        // If mapping fails, all files are read through the file stream.
+        _mappedFile.open( path );
+
         return true;
     }
 
@@ -89,10 +93,33 @@ namespace fheroes2
             return std::vector<uint8_t>();
         }
 
+        if ( _mappedFile.isOpen() ) {
+            const auto [data, size] = _mappedFile.getView( it->second.first, it->second.second );
+
+            return { data, data + size };
+        }
+
         _fileStream.seek( it->second.first );
         return _fileStream.getRaw( it->second.second );
     }
 
+    std::pair<const uint8_t *, size_t> H2DReader::getFileView( const std::string & fileName, std::vector<uint8_t> & buffer )
+    {
+        const auto it = _fileNameAndOffset.find( fileName );
+        if ( it == _fileNameAndOffset.end() ) {
+            return { nullptr, 0 };
+        }
+
+        if ( _mappedFile.isOpen() ) {
+            return _mappedFile.getView( it->second.first, it->second.second );
+        }
+
+        _fileStream.seek( it->second.first );
+        buffer = _fileStream.getRaw( it->second.second );
+
+        return { buffer.data(), buffer.size() };
+    }
+
     std::set<std::string, std::less<>> H2DReader::getAllFileNames() const
     {
         std::set<std::string, std::less<>> names;
@@ -171,20 +198,21 @@ namespace fheroes2
     {
         const size_t imageInfoLength{ 4 + 4 + 4 + 4 + 1 };
 
-        const std::vector<uint8_t> & data = reader.getFile( name );
-        if ( data.size() < imageInfoLength + 1 ) {
+        std::vector<uint8_t> buffer;
+        const auto [data, dataSize] = reader.getFileView( name, buffer );
+        if ( dataSize < imageInfoLength + 1 ) {
             // Empty or invalid image.
             return false;
         }
 
-        ROStreamBuf stream( data );
+        ROStreamBuf stream( data, dataSize );
         const int32_t width = static_cast<int32_t>( stream.getLE32() );
         const int32_t height = static_cast<int32_t>( stream.getLE32() );
         const int32_t x = static_cast<int32_t>( stream.getLE32() );
         const int32_t y = static_cast<int32_t>( stream.getLE32() );
         const bool isSingleLayer = ( stream.get() != 0 );
 
-        if ( ( static_cast<size_t>( width ) * height * ( isSingleLayer ? 1 : 2 ) + imageInfoLength ) != data.size() ) {
+        if ( ( static_cast<size_t>( width ) * height * ( isSingleLayer ? 1 : 2 ) + imageInfoLength ) != dataSize ) {
             return false;
         }
 
@@ -194,10 +222,10 @@ namespace fheroes2
         }
 
         image.resize( width, height );
-        memcpy( image.image(), data.data() + imageInfoLength, size );
+        memcpy( image.image(), data + imageInfoLength, size );
 
         if ( !isSingleLayer ) {
-            memcpy( image.transform(), data.data() + imageInfoLength + size, size );
+            memcpy( image.transform(), data + imageInfoLength + size, size );
         }
 
         image.setPosition( x, y );
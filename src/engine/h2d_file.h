@@ -20,6 +20,7 @@
 
 #pragma once
 
+#include <cstddef>
 #include <cstdint>
 #include <functional>
 #include <map>
@@ -28,6 +29,7 @@
 #include <utility>
 #include <vector>
 
+#include "memory_mapped_file.h"
 #include "serialize.h"
 
 namespace fheroes2
@@ -44,6 +46,11 @@ namespace fheroes2
         // Returns non-empty vector if requested file exists.
         std::vector<uint8_t> getFile( const std::string & fileName );
 
+        // Returns a non-owning view of the requested file. If the archive is memory mapped the view points directly into the mapped
+        // memory, otherwise the file is read into the provided buffer and the view points to it. An empty view is returned if the
+        // requested file does not exist.
+        std::pair<const uint8_t *, size_t> getFileView( const std::string & fileName, std::vector<uint8_t> & buffer );
+
         std::set<std::string, std::less<>> getAllFileNames() const;
 
     private:
@@ -52,6 +59,9 @@ namespace fheroes2
 
         // Stream for reading h2d file.
         StreamFile _fileStream;
+
+        // Memory mapped h2d file, if mapping is supported by the platform.
+        MemoryMappedFile _mappedFile;
     };
 
     // This class is not designed to be performance optimized as it will be used very rarely and out of game running session.
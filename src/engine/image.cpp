@@ -26,7 +26,20 @@
 #include <cstdlib>
 #include <cstring>
 
+#if defined( __SSE2__ ) || defined( _M_X64 ) || ( defined( _M_IX86_FP ) && _M_IX86_FP >= 2 )
+#include <emmintrin.h>
+
+#define FHEROES2_IMAGE_SSE2
+#define FHEROES2_IMAGE_SIMD
+#elif defined( __ARM_NEON ) || defined( __ARM_NEON__ )
+#include <arm_neon.h>
+
+#define FHEROES2_IMAGE_NEON
+#define FHEROES2_IMAGE_SIMD
+#endif
+
 #include "image_palette.h"
+#include "image_row.h"
 
 namespace
 {
@@ -394,6 +407,186 @@ namespace
         return rgbToId[red + green * 64 + blue * 64 * 64];
     }
 
+    // Most sprites consist of long runs of either opaque (transform value 0) or fully transparent (transform value 1) pixels.
+    // With vector instructions the transform layer is analyzed by blocks of pixels so such runs are copied or skipped at once
+    // and only blocks containing transformations (shadows) fall back to per-pixel processing. The result is always identical
+    // to the scalar code.
+    constexpr int32_t pixelBlockSize = 16;
+
+    enum class TransformBlock : uint8_t
+    {
+        // All pixels in the block are opaque.
+        OPAQUE,
+        // All pixels in the block are transparent.
+        TRANSPARENT,
+        // The block contains only opaque and transparent pixels.
+        OPAQUE_OR_TRANSPARENT,
+        // The block contains no opaque pixels but some of them have a transformation.
+        NO_OPAQUE,
+        // The block contains opaque pixels and pixels with a transformation.
+        MIXED
+    };
+
+#if defined( FHEROES2_IMAGE_SSE2 )
+    TransformBlock getTransformBlockType( const uint8_t * transform )
+    {
+        const __m128i value = _mm_loadu_si128( reinterpret_cast<const __m128i *>( transform ) );
+        const int opaqueMask = _mm_movemask_epi8( _mm_cmpeq_epi8( value, _mm_setzero_si128() ) );
+        if ( opaqueMask == 0xFFFF ) {
+            return TransformBlock::OPAQUE;
+        }
+
+        const int transparentMask = _mm_movemask_epi8( _mm_cmpeq_epi8( value, _mm_set1_epi8( 1 ) ) );
+        if ( transparentMask == 0xFFFF ) {
+            return TransformBlock::TRANSPARENT;
+        }
+
+        if ( opaqueMask == 0 ) {
+            return TransformBlock::NO_OPAQUE;
+        }
+
+        return ( ( opaqueMask | transparentMask ) == 0xFFFF ) ? TransformBlock::OPAQUE_OR_TRANSPARENT : TransformBlock::MIXED;
+    }
+
+    // Copies opaque pixels of the block and leaves all other output pixels untouched. If the output transform layer is provided
+    // it is reset for all copied pixels.
+    void copyOpaquePixelBlock( const uint8_t * imageIn, const uint8_t * transformIn, uint8_t * imageOut, uint8_t * transformOut )
+    {
+        const __m128i opaqueMask = _mm_cmpeq_epi8( _mm_loadu_si128( reinterpret_cast<const __m128i *>( transformIn ) ), _mm_setzero_si128() );
+
+        __m128i * imageOutBlock = reinterpret_cast<__m128i *>( imageOut );
+        const __m128i inValue = _mm_loadu_si128( reinterpret_cast<const __m128i *>( imageIn ) );
+        const __m128i outValue = _mm_loadu_si128( imageOutBlock );
+        _mm_storeu_si128( imageOutBlock, _mm_or_si128( _mm_and_si128( opaqueMask, inValue ), _mm_andnot_si128( opaqueMask, outValue ) ) );
+
+        if ( transformOut != nullptr ) {
+            __m128i * transformOutBlock = reinterpret_cast<__m128i *>( transformOut );
+            _mm_storeu_si128( transformOutBlock, _mm_andnot_si128( opaqueMask, _mm_loadu_si128( transformOutBlock ) ) );
+        }
+    }
+#elif defined( FHEROES2_IMAGE_NEON )
+    bool areAllBitsSet( const uint8x16_t mask )
+    {
+        const uint64x2_t value = vreinterpretq_u64_u8( mask );
+        return ( vgetq_lane_u64( value, 0 ) & vgetq_lane_u64( value, 1 ) ) == UINT64_MAX;
+    }
+
+    bool areNoBitsSet( const uint8x16_t mask )
+    {
+        const uint64x2_t value = vreinterpretq_u64_u8( mask );
+        return ( vgetq_lane_u64( value, 0 ) | vgetq_lane_u64( value, 1 ) ) == 0;
+    }
+
+    TransformBlock getTransformBlockType( const uint8_t * transform )
+    {
+        const uint8x16_t value = vld1q_u8( transform );
+        const uint8x16_t opaqueMask = vceqq_u8( value, vdupq_n_u8( 0 ) );
+        if ( areAllBitsSet( opaqueMask ) ) {
+            return TransformBlock::OPAQUE;
+        }
+
+        const uint8x16_t transparentMask = vceqq_u8( value, vdupq_n_u8( 1 ) );
+        if ( areAllBitsSet( transparentMask ) ) {
+            return TransformBlock::TRANSPARENT;
+        }
+
+        if ( areNoBitsSet( opaqueMask ) ) {
+            return TransformBlock::NO_OPAQUE;
+        }
+
+        return areAllBitsSet( vorrq_u8( opaqueMask, transparentMask ) ) ? TransformBlock::OPAQUE_OR_TRANSPARENT : TransformBlock::MIXED;
+    }
+
+    // Copies opaque pixels of the block and leaves all other output pixels untouched. If the output transform layer is provided
+    // it is reset for all copied pixels.
+    void copyOpaquePixelBlock( const uint8_t * imageIn, const uint8_t * transformIn, uint8_t * imageOut, uint8_t * transformOut )
+    {
+        const uint8x16_t opaqueMask = vceqq_u8( vld1q_u8( transformIn ), vdupq_n_u8( 0 ) );
+
+        vst1q_u8( imageOut, vbslq_u8( opaqueMask, vld1q_u8( imageIn ), vld1q_u8( imageOut ) ) );
+
+        if ( transformOut != nullptr ) {
+            vst1q_u8( transformOut, vbicq_u8( vld1q_u8( transformOut ), opaqueMask ) );
+        }
+    }
+#endif
+
+    // Blits pixels of a double-layer image row into a single-layer image row one by one.
+    void blitPixelsToSingleLayer( const uint8_t * imageIn, const uint8_t * transformIn, uint8_t * imageOut, const int32_t width )
+    {
+        const uint8_t * imageInEnd = imageIn + width;
+
+        for ( ; imageIn != imageInEnd; ++imageIn, ++transformIn, ++imageOut ) {
+            if ( *transformIn > 0 ) { // apply a transformation
+                if ( *transformIn != 1 ) { // skip pixel
+                    *imageOut = *( transformTable + ( *transformIn ) * 256 + *imageOut );
+                }
+            }
+            else { // copy a pixel
+                *imageOut = *imageIn;
+            }
+        }
+    }
+
+    // Blits pixels of a double-layer image row into a double-layer image row one by one.
+    void blitPixelsToDoubleLayer( const uint8_t * imageIn, const uint8_t * transformIn, uint8_t * imageOut, uint8_t * transformOut, const int32_t width )
+    {
+        const uint8_t * imageInEnd = imageIn + width;
+
+        for ( ; imageIn != imageInEnd; ++imageIn, ++transformIn, ++imageOut, ++transformOut ) {
+            if ( *transformIn == 1 ) { // skip pixel
+                continue;
+            }
+
+            if ( *transformIn > 0 && *transformOut == 0 ) { // apply a transformation
+                *imageOut = *( transformTable + ( *transformIn ) * 256 + *imageOut );
+            }
+            else { // copy a pixel
+                *transformOut = *transformIn;
+                *imageOut = *imageIn;
+            }
+        }
+    }
+
+    // Applies the palette to opaque pixels (transform value 0) of a double-layer image row one by one. Input and output rows may be the same.
+    void applyPaletteToOpaquePixels( const uint8_t * imageIn, const uint8_t * transformIn, uint8_t * imageOut, const int32_t width, const uint8_t * palette )
+    {
+        const uint8_t * imageInEnd = imageIn + width;
+
+        for ( ; imageIn != imageInEnd; ++imageIn, ++imageOut, ++transformIn ) {
+            if ( *transformIn == 0 ) { // only modify pixels with data
+                *imageOut = palette[*imageIn];
+            }
+        }
+    }
+
+    // Blends non-transparent pixels of a double-layer image row with an image row one by one.
+    void alphaBlitPixels( const uint8_t * imageIn, const uint8_t * transformIn, uint8_t * imageOut, const int32_t width, const uint8_t alphaValue,
+                          const uint8_t * gamePalette )
+    {
+        const uint8_t behindValue = 255 - alphaValue;
+        const uint8_t * imageInEnd = imageIn + width;
+
+        for ( ; imageIn != imageInEnd; ++imageIn, ++transformIn, ++imageOut ) {
+            if ( *transformIn == 1 ) { // skip pixel
+                continue;
+            }
+
+            uint8_t inValue = *imageIn;
+            if ( *transformIn > 1 ) {
+                inValue = *( transformTable + static_cast<ptrdiff_t>( *transformIn ) * 256 + *imageOut );
+            }
+
+            const uint8_t * inPAL = gamePalette + static_cast<ptrdiff_t>( inValue ) * 3;
+            const uint8_t * outPAL = gamePalette + static_cast<ptrdiff_t>( *imageOut ) * 3;
+
+            const uint32_t red = static_cast<uint32_t>( *inPAL ) * alphaValue + static_cast<uint32_t>( *outPAL ) * behindValue;
+            const uint32_t green = static_cast<uint32_t>( *( inPAL + 1 ) ) * alphaValue + static_cast<uint32_t>( *( outPAL + 1 ) ) * behindValue;
+            const uint32_t blue = static_cast<uint32_t>( *( inPAL + 2 ) ) * alphaValue + static_cast<uint32_t>( *( outPAL + 2 ) ) * behindValue;
+            *imageOut = GetPALColorId( static_cast<uint8_t>( red / 255 ), static_cast<uint8_t>( green / 255 ), static_cast<uint8_t>( blue / 255 ) );
+        }
+    }
+
     void ApplyRawPalette( const fheroes2::Image & in, int32_t inX, int32_t inY, fheroes2::Image & out, int32_t outX, int32_t outY, int32_t width, int32_t height,
                           const uint8_t * palette )
     {
@@ -424,19 +617,113 @@ namespace
             const uint8_t * transformInY = in.transform() + static_cast<ptrdiff_t>( inY ) * widthIn + inX;
 
             for ( ; imageInY != imageInYEnd; imageInY += widthIn, transformInY += widthIn, imageOutY += widthOut ) {
-                const uint8_t * imageInX = imageInY;
-                const uint8_t * transformInX = transformInY;
-                uint8_t * imageOutX = imageOutY;
-                const uint8_t * imageInXEnd = imageInX + width;
+                fheroes2::ImageRow::applyPalette<true>( imageInY, transformInY, imageOutY, width, palette );
+            }
+        }
+    }
+}
+
+namespace fheroes2::ImageRow
+{
+    bool isBlockProcessingSupported()
+    {
+#if defined( FHEROES2_IMAGE_SIMD )
+        return true;
+#else
+        return false;
+#endif
+    }
+
+    template <bool useBlocks>
+    void blit( const uint8_t * imageIn, const uint8_t * transformIn, uint8_t * imageOut, uint8_t * transformOut, const int32_t width )
+    {
+        int32_t offset = 0;
 
-                for ( ; imageInX != imageInXEnd; ++imageInX, ++imageOutX, ++transformInX ) {
-                    if ( *transformInX == 0 ) { // only modify pixels with data
-                        *imageOutX = palette[*imageInX];
+#if defined( FHEROES2_IMAGE_SIMD )
+        if constexpr ( useBlocks ) {
+            for ( ; offset + pixelBlockSize <= width; offset += pixelBlockSize ) {
+                uint8_t * transformOutBlock = ( transformOut == nullptr ) ? nullptr : transformOut + offset;
+
+                const TransformBlock blockType = getTransformBlockType( transformIn + offset );
+                if ( blockType == TransformBlock::TRANSPARENT ) {
+                    continue;
+                }
+
+                if ( blockType == TransformBlock::OPAQUE ) {
+                    memcpy( imageOut + offset, imageIn + offset, pixelBlockSize );
+                    if ( transformOutBlock != nullptr ) {
+                        memset( transformOutBlock, 0, pixelBlockSize );
                     }
                 }
+                else if ( blockType == TransformBlock::OPAQUE_OR_TRANSPARENT ) {
+                    copyOpaquePixelBlock( imageIn + offset, transformIn + offset, imageOut + offset, transformOutBlock );
+                }
+                else if ( transformOutBlock == nullptr ) {
+                    blitPixelsToSingleLayer( imageIn + offset, transformIn + offset, imageOut + offset, pixelBlockSize );
+                }
+                else {
+                    blitPixelsToDoubleLayer( imageIn + offset, transformIn + offset, imageOut + offset, transformOutBlock, pixelBlockSize );
+                }
+            }
+        }
+#endif
+
+        if ( transformOut == nullptr ) {
+            blitPixelsToSingleLayer( imageIn + offset, transformIn + offset, imageOut + offset, width - offset );
+        }
+        else {
+            blitPixelsToDoubleLayer( imageIn + offset, transformIn + offset, imageOut + offset, transformOut + offset, width - offset );
+        }
+    }
+
+    template <bool useBlocks>
+    void alphaBlit( const uint8_t * imageIn, const uint8_t * transformIn, uint8_t * imageOut, const int32_t width, const uint8_t alphaValue,
+                    const uint8_t * gamePalette )
+    {
+        int32_t offset = 0;
+
+#if defined( FHEROES2_IMAGE_SIMD )
+        if constexpr ( useBlocks ) {
+            for ( ; offset + pixelBlockSize <= width; offset += pixelBlockSize ) {
+                if ( getTransformBlockType( transformIn + offset ) != TransformBlock::TRANSPARENT ) {
+                    alphaBlitPixels( imageIn + offset, transformIn + offset, imageOut + offset, pixelBlockSize, alphaValue, gamePalette );
+                }
+            }
+        }
+#endif
+
+        alphaBlitPixels( imageIn + offset, transformIn + offset, imageOut + offset, width - offset, alphaValue, gamePalette );
+    }
+
+    template <bool useBlocks>
+    void applyPalette( const uint8_t * imageIn, const uint8_t * transformIn, uint8_t * imageOut, const int32_t width, const uint8_t * palette )
+    {
+        int32_t offset = 0;
+
+#if defined( FHEROES2_IMAGE_SIMD )
+        if constexpr ( useBlocks ) {
+            for ( ; offset + pixelBlockSize <= width; offset += pixelBlockSize ) {
+                const TransformBlock blockType = getTransformBlockType( transformIn + offset );
+                if ( blockType != TransformBlock::TRANSPARENT && blockType != TransformBlock::NO_OPAQUE ) {
+                    applyPaletteToOpaquePixels( imageIn + offset, transformIn + offset, imageOut + offset, pixelBlockSize, palette );
+                }
             }
         }
+#endif
+
+        applyPaletteToOpaquePixels( imageIn + offset, transformIn + offset, imageOut + offset, width - offset, palette );
     }
+
+    template void blit<true>( const uint8_t * imageIn, const uint8_t * transformIn, uint8_t * imageOut, uint8_t * transformOut, const int32_t width );
+    template void blit<false>( const uint8_t * imageIn, const uint8_t * transformIn, uint8_t * imageOut, uint8_t * transformOut, const int32_t width );
+
+    template void alphaBlit<true>( const uint8_t * imageIn, const uint8_t * transformIn, uint8_t * imageOut, const int32_t width, const uint8_t alphaValue,
+                                   const uint8_t * gamePalette );
+    template void alphaBlit<false>( const uint8_t * imageIn, const uint8_t * transformIn, uint8_t * imageOut, const int32_t width, const uint8_t alphaValue,
+                                    const uint8_t * gamePalette );
+
+    template void applyPalette<true>( const uint8_t * imageIn, const uint8_t * transformIn, uint8_t * imageOut, const int32_t width, const uint8_t * palette );
+    template void applyPalette<false>( const uint8_t * imageIn, const uint8_t * transformIn, uint8_t * imageOut, const int32_t width, const uint8_t * palette );
 }
 
 namespace fheroes2
@@ -1022,29 +1309,7 @@ namespace fheroes2
                 const uint8_t * transformInY = in.transform() + offsetInY;
 
                 for ( ; imageInY != imageInYEnd; imageInY += widthIn, transformInY += widthIn, imageOutY += widthOut ) {
-                    const uint8_t * imageInX = imageInY;
-                    const uint8_t * transformInX = transformInY;
-                    uint8_t * imageOutX = imageOutY;
-                    const uint8_t * imageInXEnd = imageInX + width;
-
-                    for ( ; imageInX != imageInXEnd; ++imageInX, ++transformInX, ++imageOutX ) {
-                        if ( *transformInX == 1 ) { // skip pixel
-                            continue;
-                        }
-
-                        uint8_t inValue = *imageInX;
-                        if ( *transformInX > 1 ) {
-                            inValue = *( transformTable + static_cast<ptrdiff_t>( *transformInX ) * 256 + *imageOutX );
-                        }
-
-                        const uint8_t * inPAL = gamePalette + static_cast<ptrdiff_t>( inValue ) * 3;
-                        const uint8_t * outPAL = gamePalette + static_cast<ptrdiff_t>( *imageOutX ) * 3;
-
-                        const uint32_t red = static_cast<uint32_t>( *inPAL ) * alphaValue + static_cast<uint32_t>( *outPAL ) * behindValue;
-                        const uint32_t green = static_cast<uint32_t>( *( inPAL + 1 ) ) * alphaValue + static_cast<uint32_t>( *( outPAL + 1 ) ) * behindValue;
-                        const uint32_t blue = static_cast<uint32_t>( *( inPAL + 2 ) ) * alphaValue + static_cast<uint32_t>( *( outPAL + 2 ) ) * behindValue;
-                        *imageOutX = GetPALColorId( static_cast<uint8_t>( red / 255 ), static_cast<uint8_t>( green / 255 ), static_cast<uint8_t>( blue / 255 ) );
-                    }
+                    ImageRow::alphaBlit<true>( imageInY, transformInY, imageOutY, width, alphaValue, gamePalette );
                 }
             }
         }
@@ -1140,16 +1405,10 @@ namespace fheroes2
         else {
             const uint8_t * transformY = image.transform() + y * imageWidth + x;
 
-            for ( ; imageY != imageYEnd; imageY += imageWidth, transformY += imageWidth ) {
-                uint8_t * imageX = imageY;
-                const uint8_t * transformX = transformY;
-                const uint8_t * imageXEnd = imageX + width;
+            const uint8_t * palette = transformTable + transformId * 256;
 
-                for ( ; imageX != imageXEnd; ++imageX, ++transformX ) {
-                    if ( *transformX == 0 ) {
-                        *imageX = *( transformTable + transformId * 256 + *imageX );
-                    }
-                }
+            for ( ; imageY != imageYEnd; imageY += imageWidth, transformY += imageWidth ) {
+                ImageRow::applyPalette<true>( imageY, transformY, imageY, width, palette );
             }
         }
     }
@@ -1255,46 +1514,14 @@ namespace fheroes2
             if ( out.singleLayer() ) {
                 assert( !in.singleLayer() );
                 for ( ; imageInY != imageInYEnd; imageInY += widthIn, transformInY += widthIn, imageOutY += widthOut ) {
-                    const uint8_t * imageInX = imageInY;
-                    const uint8_t * transformInX = transformInY;
-                    uint8_t * imageOutX = imageOutY;
-                    const uint8_t * imageInXEnd = imageInX + width;
-
-                    for ( ; imageInX != imageInXEnd; ++imageInX, ++transformInX, ++imageOutX ) {
-                        if ( *transformInX > 0 ) { // apply a transformation
-                            if ( *transformInX != 1 ) { // skip pixel
-                                *imageOutX = *( transformTable + ( *transformInX ) * 256 + *imageOutX );
-                            }
-                        }
-                        else { // copy a pixel
-                            *imageOutX = *imageInX;
-                        }
-                    }
+                    ImageRow::blit<true>( imageInY, transformInY, imageOutY, nullptr, width );
                 }
             }
             else {
                 uint8_t * transformOutY = out.transform() + offsetOutY;
 
                 for ( ; imageInY != imageInYEnd; imageInY += widthIn, transformInY += widthIn, imageOutY += widthOut, transformOutY += widthOut ) {
-                    const uint8_t * imageInX = imageInY;
-                    const uint8_t * transformInX = transformInY;
-                    uint8_t * imageOutX = imageOutY;
-                    uint8_t * transformOutX = transformOutY;
-                    const uint8_t * imageInXEnd = imageInX + width;
-
-                    for ( ; imageInX != imageInXEnd; ++imageInX, ++transformInX, ++imageOutX, ++transformOutX ) {
-                        if ( *transformInX == 1 ) { // skip pixel
-                            continue;
-                        }
-
-                        if ( *transformInX > 0 && *transformOutX == 0 ) { // apply a transformation
-                            *imageOutX = *( transformTable + ( *transformInX ) * 256 + *imageOutX );
-                        }
-                        else { // copy a pixel
-                            *transformOutX = *transformInX;
-                            *imageOutX = *imageInX;
-                        }
-                    }
+                    ImageRow::blit<true>( imageInY, transformInY, imageOutY, transformOutY, width );
                 }
             }
         }
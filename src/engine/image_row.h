@@ -0,0 +1,47 @@
+/***************************************************************************
+ *   fheroes2: https://github.com/ihhub/fheroes2                           *
+ *   Copyright (C) 2026                                                    *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
+ ***************************************************************************/
+
+#pragma once
+
+#include <cstdint>
+
+// Row processing functions used internally by Blit, AlphaBlit, ApplyPalette and ApplyTransform of a double-layer image.
+// They are not a part of the image API and must be used only by tools verifying the block processing.
+//
+// The block versions (useBlocks = true) analyze the input transform layer by blocks of pixels using vector instructions
+// and the pixel versions (useBlocks = false) process all pixels one by one. Both versions must produce identical results.
+namespace fheroes2::ImageRow
+{
+    // Returns true if the block versions use vector instructions on this platform, otherwise both versions are the same.
+    bool isBlockProcessingSupported();
+
+    // Blits a row of a double-layer image into a row of an image. The output transform layer must be nullptr for single-layer images.
+    template <bool useBlocks>
+    void blit( const uint8_t * imageIn, const uint8_t * transformIn, uint8_t * imageOut, uint8_t * transformOut, const int32_t width );
+
+    // Blends non-transparent pixels of a row of a double-layer image with a row of an image using the given game palette.
+    template <bool useBlocks>
+    void alphaBlit( const uint8_t * imageIn, const uint8_t * transformIn, uint8_t * imageOut, const int32_t width, const uint8_t alphaValue,
+                    const uint8_t * gamePalette );
+
+    // Applies the palette to opaque pixels of a row of a double-layer image. Input and output rows may be the same.
+    template <bool useBlocks>
+    void applyPalette( const uint8_t * imageIn, const uint8_t * transformIn, uint8_t * imageOut, const int32_t width, const uint8_t * palette );
+}
@@ -0,0 +1,113 @@
+/***************************************************************************
+ *   fheroes2: https://github.com/ihhub/fheroes2                           *
+ *   Copyright (C) 2025                                                    *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
+ ***************************************************************************/
+
+#include "memory_arena.h"
+
+#include <algorithm>
+#include <cassert>
+#include <new>
+
+namespace
+{
+    // Size of the memory blocks taken from the system. It is big enough to hold many elements but small enough to not waste memory for
+    // rarely used element types.
+    const size_t arenaBlockSize = 64 * 1024;
+}
+
+namespace fheroes2
+{
+    FixedSizeArena::FixedSizeArena( const size_t elementSize, [[maybe_unused]] const size_t elementAlignment )
+        : _elementSize( ( std::max( elementSize, sizeof( FreeElement ) ) + alignof( std::max_align_t ) - 1 ) / alignof( std::max_align_t ) * alignof( std::max_align_t ) )
+    {
+        // Blocks are allocated by operator new[] so they are suitably aligned for any fundamental type.
+        assert( elementAlignment <= alignof( std::max_align_t ) );
+        assert( _elementSize <= arenaBlockSize );
+    }
+
+    FixedSizeArena::FreeElement * FixedSizeArena::allocateBatch( const size_t count )
+    {
+        assert( count > 0 );
+
+        const std::scoped_lock<std::mutex> lock( _mutex );
+
+        FreeElement * first = nullptr;
+
+        for ( size_t i = 0; i < count; ++i ) {
+            FreeElement * element = _freeElements;
+
+            if ( element != nullptr ) {
+                _freeElements = element->next;
+            }
+            else {
+                if ( _nextElement == _blockEnd ) {
+                    _blocks.emplace_back( std::make_unique<std::byte[]>( arenaBlockSize / _elementSize * _elementSize ) );
+
+                    _nextElement = _blocks.back().get();
+                    _blockEnd = _nextElement + arenaBlockSize / _elementSize * _elementSize;
+                }
+
+                element = reinterpret_cast<FreeElement *>( _nextElement );
+                _nextElement += _elementSize;
+            }
+
+            first = new ( element ) FreeElement{ first };
+        }
+
+        return first;
+    }
+
+    void FixedSizeArena::deallocateBatch( FreeElement * first, FreeElement * last )
+    {
+        assert( first != nullptr && last != nullptr );
+
+        const std::scoped_lock<std::mutex> lock( _mutex );
+
+        last->next = _freeElements;
+        _freeElements = first;
+    }
+
+    void FixedSizeArenaCache::deallocate( FixedSizeArena & arena, void * element )
+    {
+        if ( element == nullptr ) {
+            return;
+        }
+
+        _freeElements = new ( element ) FixedSizeArena::FreeElement{ _freeElements };
+        ++_freeElementCount;
+
+        // Threads that release more elements than they allocate (e.g. when containers are destroyed by another thread) return
+        // the excess to the arena, so other threads could reuse them.
+        if ( _freeElementCount < 2 * batchSize ) {
+            return;
+        }
+
+        FixedSizeArena::FreeElement * first = _freeElements;
+        FixedSizeArena::FreeElement * last = first;
+
+        for ( size_t i = 1; i < batchSize; ++i ) {
+            last = last->next;
+        }
+
+        _freeElements = last->next;
+        _freeElementCount -= batchSize;
+
+        arena.deallocateBatch( first, last );
+    }
+}
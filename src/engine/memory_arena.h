@@ -0,0 +1,165 @@
+/***************************************************************************
+ *   fheroes2: https://github.com/ihhub/fheroes2                           *
+ *   Copyright (C) 2025                                                    *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
+ ***************************************************************************/
+
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <type_traits>
+#include <vector>
+
+namespace fheroes2
+{
+    // Memory arena for elements of the same size. Memory is taken from the system in large blocks, so elements allocated one after
+    // another are located close to each other in memory. Released elements are reused by subsequent allocations, the blocks themselves
+    // are returned to the system only when the arena is destroyed.
+    //
+    // Elements are not allocated from the arena one by one: every thread takes them in batches into its own FixedSizeArenaCache and
+    // allocates and releases elements there without any locking. All methods of the arena itself are thread-safe.
+    class FixedSizeArena
+    {
+    public:
+        struct FreeElement
+        {
+            FreeElement * next;
+        };
+
+        FixedSizeArena( const size_t elementSize, const size_t elementAlignment );
+        FixedSizeArena( const FixedSizeArena & ) = delete;
+
+        ~FixedSizeArena() = default;
+
+        FixedSizeArena & operator=( const FixedSizeArena & ) = delete;
+
+        // Returns a list of the given number of free elements.
+        FreeElement * allocateBatch( const size_t count );
+
+        // Takes back the list of free elements of the given length.
+        void deallocateBatch( FreeElement * first, FreeElement * last );
+
+    private:
+        std::vector<std::unique_ptr<std::byte[]>> _blocks;
+
+        FreeElement * _freeElements{ nullptr };
+
+        std::byte * _nextElement{ nullptr };
+        std::byte * _blockEnd{ nullptr };
+
+        const size_t _elementSize;
+
+        std::mutex _mutex;
+    };
+
+    // Per-thread cache of free elements of an arena. It must be trivially destructible, since it is used as a thread-local object
+    // by containers which can be destroyed after the destruction of thread-local objects (e.g. static containers at the application
+    // exit). Because of this, the free elements of the cache of a thread that has exited are not returned to the arena; there are
+    // no more than 2 * batchSize of them.
+    class FixedSizeArenaCache
+    {
+    public:
+        void * allocate( FixedSizeArena & arena )
+        {
+            if ( _freeElements == nullptr ) {
+                _freeElements = arena.allocateBatch( batchSize );
+                _freeElementCount = batchSize;
+            }
+
+            FixedSizeArena::FreeElement * element = _freeElements;
+            _freeElements = element->next;
+            --_freeElementCount;
+
+            return element;
+        }
+
+        void deallocate( FixedSizeArena & arena, void * element );
+
+    private:
+        static constexpr size_t batchSize{ 64 };
+
+        FixedSizeArena::FreeElement * _freeElements{ nullptr };
+        size_t _freeElementCount{ 0 };
+    };
+
+    static_assert( std::is_trivially_destructible_v<FixedSizeArenaCache> );
+
+    // Allocator for node-based containers (such as std::list) which takes single elements from an arena shared by all containers
+    // of the same type. Elements can be released by any thread, not only by the one that allocated them. Allocations of arrays
+    // are forwarded to the standard allocator.
+    template <typename T>
+    class ArenaAllocator
+    {
+    public:
+        using value_type = T;
+
+        ArenaAllocator() = default;
+
+        // Containers convert the allocator to allocators of their internal node types.
+        template <typename U>
+        ArenaAllocator( const ArenaAllocator<U> & /* unused */ ) noexcept // NOLINT(google-explicit-constructor, hicpp-explicit-conversions)
+        {
+            // Do nothing.
+        }
+
+        T * allocate( const size_t count )
+        {
+            if ( count == 1 ) {
+                return static_cast<T *>( _cache.allocate( _arena() ) );
+            }
+
+            return std::allocator<T>().allocate( count );
+        }
+
+        void deallocate( T * element, const size_t count ) noexcept
+        {
+            if ( count == 1 ) {
+                _cache.deallocate( _arena(), element );
+                return;
+            }
+
+            std::allocator<T>().deallocate( element, count );
+        }
+
+        template <typename U>
+        bool operator==( const ArenaAllocator<U> & /* unused */ ) const noexcept
+        {
+            return true;
+        }
+
+        template <typename U>
+        bool operator!=( const ArenaAllocator<U> & /* unused */ ) const noexcept
+        {
+            return false;
+        }
+
+    private:
+        static FixedSizeArena & _arena()
+        {
+            // The arena is never destroyed as containers using it can be destroyed after the destruction of other static objects.
+            static FixedSizeArena * arena = new FixedSizeArena( sizeof( T ), alignof( T ) );
+            return *arena;
+        }
+
+        static thread_local FixedSizeArenaCache _cache;
+    };
+
+    template <typename T>
+    thread_local FixedSizeArenaCache ArenaAllocator<T>::_cache;
+}
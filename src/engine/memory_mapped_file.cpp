@@ -0,0 +1,128 @@
+/***************************************************************************
+ *   fheroes2: https://github.com/ihhub/fheroes2                           *
+ *   Copyright (C) 2025                                                    *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
+ ***************************************************************************/
+
+#include "memory_mapped_file.h"
+
+#if defined( _WIN32 )
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#elif !defined( TARGET_PS_VITA ) && !defined( TARGET_NINTENDO_SWITCH ) && !defined( __EMSCRIPTEN__ )
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#define FHEROES2_USE_MMAP
+#endif
+
+#include "logging.h"
+
+namespace fheroes2
+{
+    bool MemoryMappedFile::open( const std::string & path )
+    {
+        close();
+
+#if defined( _WIN32 )
+        const HANDLE file = CreateFileA( path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr );
+        if ( file == INVALID_HANDLE_VALUE ) {
+            return false;
+        }
+
+        LARGE_INTEGER fileSize;
+        if ( !GetFileSizeEx( file, &fileSize ) || fileSize.QuadPart <= 0 || static_cast<uint64_t>( fileSize.QuadPart ) > SIZE_MAX ) {
+            CloseHandle( file );
+            return false;
+        }
+
+        const HANDLE mapping = CreateFileMappingA( file, nullptr, PAGE_READONLY, 0, 0, nullptr );
+
+        // The mapping keeps its own reference to the file.
+        CloseHandle( file );
+
+        if ( mapping == nullptr ) {
+            ERROR_LOG( "Failed to create a file mapping for " << path << ", error code: " << GetLastError() )
+            return false;
+        }
+
+        const void * view = MapViewOfFile( mapping, FILE_MAP_READ, 0, 0, 0 );
+        if ( view == nullptr ) {
+            ERROR_LOG( "Failed to map file " << path << ", error code: " << GetLastError() )
+            CloseHandle( mapping );
+            return false;
+        }
+
+        _mappingHandle = mapping;
+        _data = static_cast<const uint8_t *>( view );
+        _size = static_cast<size_t>( fileSize.QuadPart );
+
+        return true;
+#elif defined( FHEROES2_USE_MMAP )
+        const int file = ::open( path.c_str(), O_RDONLY );
+        if ( file < 0 ) {
+            return false;
+        }
+
+        struct stat fileStat;
+        if ( fstat( file, &fileStat ) != 0 || fileStat.st_size <= 0 ) {
+            ::close( file );
+            return false;
+        }
+
+        const size_t fileSize = static_cast<size_t>( fileStat.st_size );
+        void * view = mmap( nullptr, fileSize, PROT_READ, MAP_PRIVATE, file, 0 );
+
+        // The mapping stays valid after the file descriptor is closed.
+        ::close( file );
+
+        if ( view == MAP_FAILED ) {
+            ERROR_LOG( "Failed to map file " << path )
+            return false;
+        }
+
+        _data = static_cast<const uint8_t *>( view );
+        _size = fileSize;
+
+        return true;
+#else
+        (void)path;
+
+        return false;
+#endif
+    }
+
+    void MemoryMappedFile::close()
+    {
+        if ( _data == nullptr ) {
+            return;
+        }
+
+#if defined( _WIN32 )
+        UnmapViewOfFile( _data );
+        CloseHandle( _mappingHandle );
+        _mappingHandle = nullptr;
+#elif defined( FHEROES2_USE_MMAP )
+        munmap( const_cast<uint8_t *>( _data ), _size );
+#endif
+
+        _data = nullptr;
+        _size = 0;
+    }
+}
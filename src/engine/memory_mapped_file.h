@@ -0,0 +1,85 @@
+/***************************************************************************
+ *   fheroes2: https://github.com/ihhub/fheroes2                           *
+ *   Copyright (C) 2025                                                    *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
+ ***************************************************************************/
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <utility>
+
+namespace fheroes2
+{
+    // Read-only memory mapping of an entire file. The mapped memory is shared between all threads and stays valid until the object
+    // is closed or destroyed, so non-owning views into it can be handed out without copying the underlying data. Memory mapping is
+    // not available on all platforms: in this case open() returns false and the caller is expected to fall back to regular file reads.
+    class MemoryMappedFile
+    {
+    public:
+        MemoryMappedFile() = default;
+        MemoryMappedFile( const MemoryMappedFile & ) = delete;
+
+        ~MemoryMappedFile()
+        {
+            close();
+        }
+
+        MemoryMappedFile & operator=( const MemoryMappedFile & ) = delete;
+
+        // Returns true if the file has been successfully mapped into memory.
+        bool open( const std::string & path );
+
+        void close();
+
+        bool isOpen() const
+        {
+            return _data != nullptr;
+        }
+
+        const uint8_t * data() const
+        {
+            return _data;
+        }
+
+        size_t size() const
+        {
+            return _size;
+        }
+
+        // Returns a view of 'size' bytes starting from the given offset or an empty view ({ nullptr, 0 }) if the requested range
+        // is out of bounds of the file.
+        std::pair<const uint8_t *, size_t> getView( const size_t offset, const size_t size ) const
+        {
+            if ( _data == nullptr || offset > _size || size > _size - offset ) {
+                return { nullptr, 0 };
+            }
+
+            return { _data + offset, size };
+        }
+
+    private:
+        const uint8_t * _data{ nullptr };
+        size_t _size{ 0 };
+
+#if defined( _WIN32 )
+        void * _mappingHandle{ nullptr };
+#endif
+    };
+}
@@ -0,0 +1,143 @@
+/***************************************************************************
+ *   fheroes2: https://github.com/ihhub/fheroes2                           *
+ *   Copyright (C) 2026                                                    *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
+ ***************************************************************************/
+
+#pragma once
+
+#include <array>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace fheroes2
+{
+    // Monotone priority queue with unsigned integer keys (a radix heap). The key of every added element must not be less than the key
+    // of the last extracted element, which is always true for Dijkstra-like searches with non-negative costs. In exchange, both adding
+    // and extracting an element take amortized O(log C) time, where C is the range of keys, without any comparisons between elements.
+    template <typename Value>
+    class RadixHeap
+    {
+    public:
+        bool empty() const
+        {
+            return _size == 0;
+        }
+
+        size_t size() const
+        {
+            return _size;
+        }
+
+        // Removes all elements but keeps the allocated memory so that the queue can be reused.
+        void clear()
+        {
+            for ( auto & bucket : _buckets ) {
+                bucket.clear();
+            }
+
+            _size = 0;
+            _lastKey = 0;
+        }
+
+        void push( const uint32_t key, Value value )
+        {
+            assert( key >= _lastKey );
+
+            _buckets[_getBucketIndex( key )].emplace_back( key, std::move( value ) );
+            ++_size;
+        }
+
+        // Returns the smallest key in the queue. The queue must not be empty.
+        uint32_t topKey()
+        {
+            assert( !empty() );
+
+            _refill();
+
+            return _lastKey;
+        }
+
+        // Removes and returns the element with the smallest key. The queue must not be empty.
+        std::pair<uint32_t, Value> pop()
+        {
+            assert( !empty() );
+
+            _refill();
+
+            std::pair<uint32_t, Value> result = std::move( _buckets[0].back() );
+            _buckets[0].pop_back();
+            --_size;
+
+            return result;
+        }
+
+    private:
+        // Elements with keys equal to the last extracted key are stored in the first bucket. Other elements are stored in the bucket
+        // with the index of the highest bit in which their keys differ from the last extracted key.
+        size_t _getBucketIndex( const uint32_t key ) const
+        {
+            uint32_t difference = key ^ _lastKey;
+            size_t index = 0;
+
+            while ( difference != 0 ) {
+                difference >>= 1;
+                ++index;
+            }
+
+            return index;
+        }
+
+        // Makes sure that the first bucket contains elements with the smallest key.
+        void _refill()
+        {
+            if ( !_buckets[0].empty() ) {
+                return;
+            }
+
+            size_t bucketId = 1;
+            while ( _buckets[bucketId].empty() ) {
+                ++bucketId;
+                assert( bucketId < _buckets.size() );
+            }
+
+            auto & bucket = _buckets[bucketId];
+
+            _lastKey = bucket.front().first;
+            for ( const auto & element : bucket ) {
+                if ( element.first < _lastKey ) {
+                    _lastKey = element.first;
+                }
+            }
+
+            // All elements of this bucket go to buckets with smaller indexes because their keys share more high bits with the new last key.
+            for ( auto & element : bucket ) {
+                _buckets[_getBucketIndex( element.first )].push_back( std::move( element ) );
+            }
+
+            bucket.clear();
+        }
+
+        std::array<std::vector<std::pair<uint32_t, Value>>, 33> _buckets;
+
+        size_t _size{ 0 };
+        uint32_t _lastKey{ 0 };
+    };
+}
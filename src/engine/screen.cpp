@@ -19,8 +19,10 @@
  ***************************************************************************/
 
 #include <algorithm>
+#include <array>
 #include <cassert>
 #include <cmath>
+#include <cstddef>
 #include <cstdint>
 #include <cstring>
 #include <iterator>
@@ -29,6 +31,22 @@
 #include <set>
 #include <utility>
 
+#if defined( __SSE2__ ) || defined( _M_X64 ) || ( defined( _M_IX86_FP ) && _M_IX86_FP >= 2 )
+#include <emmintrin.h>
+
+#define FHEROES2_SCREEN_SSE2
+#elif defined( __ARM_NEON ) || defined( __ARM_NEON__ )
+#include <arm_neon.h>
+
+#define FHEROES2_SCREEN_NEON
+#endif
+
+#if defined( __AVX2__ )
+#include <immintrin.h>
+
+#define FHEROES2_SCREEN_AVX2
+#endif
+
 // Managing compiler warnings for SDL headers
 #if defined( __GNUC__ )
 #pragma GCC diagnostic push
@@ -267,12 +285,205 @@ namespace
 
 // If SDL library is used
 #if !defined( TARGET_PS_VITA )
+    // Palette colors which have been changed since the last time the whole frame or all areas containing them were rendered.
+    struct PaletteChange
+    {
+        void reset()
+        {
+            isChanged.fill( false );
+            count = 0;
+            minColor = 255;
+            maxColor = 0;
+        }
+
+        void add( const uint8_t color )
+        {
+            if ( isChanged[color] ) {
+                return;
+            }
+
+            isChanged[color] = true;
+            ++count;
+            minColor = std::min( minColor, color );
+            maxColor = std::max( maxColor, color );
+        }
+
+        std::array<bool, 256> isChanged{};
+        uint32_t count{ 0 };
+        uint8_t minColor{ 255 };
+        uint8_t maxColor{ 0 };
+    };
+
+    // The image is split into blocks to find areas containing changed palette colors.
+    const int32_t paletteChangeBlockWidth{ 64 };
+    const int32_t paletteChangeBlockHeight{ 16 };
+
+    // If the number of changed colors is bigger than this value most likely the whole image is affected so there is no need to look for them.
+    const uint32_t maxPaletteChangeToTrack{ 32 };
+
+    void convertTo32BitPixels( const uint8_t * in, uint32_t * out, const int32_t count, const uint32_t * palette )
+    {
+        const uint32_t * outEnd = out + count;
+
+#if defined( FHEROES2_SCREEN_AVX2 )
+        const int * paletteData = reinterpret_cast<const int *>( palette );
+
+        for ( ; outEnd - out >= 8; in += 8, out += 8 ) {
+            const __m256i colorIds = _mm256_cvtepu8_epi32( _mm_loadl_epi64( reinterpret_cast<const __m128i *>( in ) ) );
+            _mm256_storeu_si256( reinterpret_cast<__m256i *>( out ), _mm256_i32gather_epi32( paletteData, colorIds, 4 ) );
+        }
+#else
+        // Table lookups cannot be vectorized without gather instructions but loop unrolling still removes most of the loop overhead.
+        for ( ; outEnd - out >= 8; in += 8, out += 8 ) {
+            out[0] = palette[in[0]];
+            out[1] = palette[in[1]];
+            out[2] = palette[in[2]];
+            out[3] = palette[in[3]];
+            out[4] = palette[in[4]];
+            out[5] = palette[in[5]];
+            out[6] = palette[in[6]];
+            out[7] = palette[in[7]];
+        }
+#endif
+
+        for ( ; out != outEnd; ++out, ++in ) {
+            *out = palette[*in];
+        }
+    }
+
+    bool hasChangedPixel( const uint8_t * data, const int32_t count, const PaletteChange & change )
+    {
+        const uint8_t colorRange = change.maxColor - change.minColor;
+
+        int32_t i = 0;
+
+#if defined( FHEROES2_SCREEN_SSE2 )
+        const __m128i minColor = _mm_set1_epi8( static_cast<char>( change.minColor ) );
+        const __m128i maxOffset = _mm_set1_epi8( static_cast<char>( colorRange ) );
+
+        for ( ; i + 16 <= count; i += 16 ) {
+            // A color is within the range if ( color - minColor ) <= ( maxColor - minColor ) as unsigned values.
+            const __m128i offset = _mm_sub_epi8( _mm_loadu_si128( reinterpret_cast<const __m128i *>( data + i ) ), minColor );
+            if ( _mm_movemask_epi8( _mm_cmpeq_epi8( _mm_min_epu8( offset, maxOffset ), offset ) ) == 0 ) {
+                continue;
+            }
+
+            for ( int32_t j = i; j < i + 16; ++j ) {
+                if ( change.isChanged[data[j]] ) {
+                    return true;
+                }
+            }
+        }
+#elif defined( FHEROES2_SCREEN_NEON )
+        const uint8x16_t minColor = vdupq_n_u8( change.minColor );
+        const uint8x16_t maxOffset = vdupq_n_u8( colorRange );
+
+        for ( ; i + 16 <= count; i += 16 ) {
+            const uint64x2_t mask = vreinterpretq_u64_u8( vcleq_u8( vsubq_u8( vld1q_u8( data + i ), minColor ), maxOffset ) );
+            if ( ( vgetq_lane_u64( mask, 0 ) | vgetq_lane_u64( mask, 1 ) ) == 0 ) {
+                continue;
+            }
+
+            for ( int32_t j = i; j < i + 16; ++j ) {
+                if ( change.isChanged[data[j]] ) {
+                    return true;
+                }
+            }
+        }
+#endif
+
+        for ( ; i < count; ++i ) {
+            if ( static_cast<uint8_t>( data[i] - change.minColor ) <= colorRange && change.isChanged[data[i]] ) {
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    // Finds areas of the image containing changed palette colors. Returns false if it is cheaper to update the whole image.
+    bool getPaletteChangeAreas( const fheroes2::Image & image, const PaletteChange & change, std::vector<fheroes2::Rect> & areas )
+    {
+        areas.clear();
+
+        if ( change.count == 0 ) {
+            return true;
+        }
+
+        if ( change.count > maxPaletteChangeToTrack ) {
+            return false;
+        }
+
+        const int32_t width = image.width();
+        const int32_t height = image.height();
+
+        const uint8_t * imageData = image.image();
+
+        const int32_t columnCount = ( width + paletteChangeBlockWidth - 1 ) / paletteChangeBlockWidth;
+        std::vector<uint8_t> isColumnChanged( static_cast<size_t>( columnCount ) );
+
+        for ( int32_t y = 0; y < height; y += paletteChangeBlockHeight ) {
+            const int32_t blockHeight = std::min( paletteChangeBlockHeight, height - y );
+
+            std::fill( isColumnChanged.begin(), isColumnChanged.end(), static_cast<uint8_t>( 0 ) );
+
+            int32_t minColumn = columnCount;
+            int32_t maxColumn = -1;
+
+            for ( int32_t row = 0; row < blockHeight; ++row ) {
+                const uint8_t * imageX = imageData + static_cast<ptrdiff_t>( y + row ) * width;
+
+                for ( int32_t column = 0; column < columnCount; ++column ) {
+                    if ( isColumnChanged[column] ) {
+                        continue;
+                    }
+
+                    const int32_t offsetX = column * paletteChangeBlockWidth;
+                    if ( hasChangedPixel( imageX + offsetX, std::min( paletteChangeBlockWidth, width - offsetX ), change ) ) {
+                        isColumnChanged[column] = 1;
+                        minColumn = std::min( minColumn, column );
+                        maxColumn = std::max( maxColumn, column );
+                    }
+                }
+            }
+
+            if ( maxColumn < 0 ) {
+                continue;
+            }
+
+            const int32_t areaX = minColumn * paletteChangeBlockWidth;
+            const int32_t areaRight = std::min( ( maxColumn + 1 ) * paletteChangeBlockWidth, width );
+
+            if ( !areas.empty() && areas.back().y + areas.back().height == y ) {
+                // Merge adjacent areas to reduce the number of texture updates.
+                fheroes2::Rect & area = areas.back();
+                const int32_t right = std::max( area.x + area.width, areaRight );
+                area.x = std::min( area.x, areaX );
+                area.width = right - area.x;
+                area.height += blockHeight;
+            }
+            else {
+                areas.emplace_back( areaX, y, areaRight - areaX, blockHeight );
+            }
+        }
+
+        int64_t changedArea = 0;
+        for ( const fheroes2::Rect & area : areas ) {
+            changedArea += static_cast<int64_t>( area.width ) * area.height;
+        }
+
+        // Many texture updates covering most of the image are slower than a single update.
+        return changedArea * 2 <= static_cast<int64_t>( width ) * height;
+    }
+
     class BaseSDLRenderer
     {
     protected:
         std::vector<uint32_t> _palette32Bit;
         std::vector<SDL_Color> _palette8Bit;
 
+        PaletteChange _paletteChange;
+
         void copyImageToSurface( const fheroes2::Image & image, SDL_Surface * surface, const fheroes2::Rect & roi )
         {
             assert( surface != nullptr && !image.empty() );
@@ -293,13 +504,7 @@ namespace
 
             if ( fullFrame ) {
                 if ( surface->format->BitsPerPixel == 32 ) {
-                    uint32_t * out = static_cast<uint32_t *>( surface->pixels );
-                    const uint32_t * outEnd = out + imageWidth * imageHeight;
-                    const uint8_t * in = imageIn;
-                    const uint32_t * transform = _palette32Bit.data();
-
-                    for ( ; out != outEnd; ++out, ++in )
-                        *out = *( transform + *in );
+                    convertTo32BitPixels( imageIn, static_cast<uint32_t *>( surface->pixels ), imageWidth * imageHeight, _palette32Bit.data() );
                 }
                 else if ( ( surface->format->BitsPerPixel == 8 ) && ( surface->pixels != imageIn ) ) {
                     if ( imageWidth % 4 != 0 ) {
@@ -321,12 +526,7 @@ namespace
                     const uint32_t * transform = _palette32Bit.data();
 
                     for ( ; outY != outYEnd; outY += imageWidth, inY += imageWidth ) {
-                        uint32_t * outX = outY;
-                        const uint32_t * outXEnd = outX + roi.width;
-                        const uint8_t * inX = inY;
-
-                        for ( ; outX != outXEnd; ++outX, ++inX )
-                            *outX = *( transform + *inX );
+                        convertTo32BitPixels( inY, outY, roi.width, transform );
                     }
                 }
                 else if ( ( surface->format->BitsPerPixel == 8 ) && ( surface->pixels != imageIn ) ) {
@@ -349,18 +549,17 @@ namespace
             assert( surface != nullptr );
 
             if ( surface->format->BitsPerPixel == 32 ) {
+                const bool hasPreviousPalette = ( _palette32Bit.size() == 256u );
                 _palette32Bit.resize( 256u );
 
-                if ( surface->format->Amask > 0 ) {
-                    for ( size_t i = 0; i < 256u; ++i ) {
-                        const uint8_t * value = currentPalette + colorIds[i] * 3;
-                        _palette32Bit[i] = SDL_MapRGBA( surface->format, *value, *( value + 1 ), *( value + 2 ), 255 );
-                    }
-                }
-                else {
-                    for ( size_t i = 0; i < 256u; ++i ) {
-                        const uint8_t * value = currentPalette + colorIds[i] * 3;
-                        _palette32Bit[i] = SDL_MapRGB( surface->format, *value, *( value + 1 ), *( value + 2 ) );
+                for ( size_t i = 0; i < 256u; ++i ) {
+                    const uint8_t * value = currentPalette + colorIds[i] * 3;
+                    const uint32_t color = ( surface->format->Amask > 0 ) ? SDL_MapRGBA( surface->format, *value, *( value + 1 ), *( value + 2 ), 255 )
+                                                                          : SDL_MapRGB( surface->format, *value, *( value + 1 ), *( value + 2 ) );
+
+                    if ( !hasPreviousPalette || _palette32Bit[i] != color ) {
+                        _paletteChange.add( static_cast<uint8_t>( i ) );
+                        _palette32Bit[i] = color;
                     }
                 }
             }
@@ -1086,6 +1285,50 @@ namespace
 
         RenderEngine() = default;
 
+        void _updateTexture( const fheroes2::Display & display, const fheroes2::Rect & roi )
+        {
+            copyImageToSurface( display, _surface, roi );
+
+            const bool fullFrame = ( roi.width == display.width() ) && ( roi.height == display.height() );
+            if ( fullFrame ) {
+                const int returnCode = SDL_UpdateTexture( _texture, nullptr, _surface->pixels, _surface->pitch );
+                if ( returnCode < 0 ) {
+                    ERROR_LOG( "Failed to update texture. The error value: " << returnCode << ", description: " << SDL_GetError() )
+                }
+
+                _paletteChange.reset();
+            }
+            else {
+                SDL_Rect area;
+                area.x = roi.x;
+                area.y = roi.y;
+                area.w = roi.width;
+                area.h = roi.height;
+
+                const int returnCode = SDL_UpdateTexture( _texture, &area, _surface->pixels, _surface->pitch );
+                if ( returnCode < 0 ) {
+                    ERROR_LOG( "Failed to update texture. The error value: " << returnCode << ", description: " << SDL_GetError() )
+                }
+            }
+        }
+
+        void _present()
+        {
+            int returnCode = SDL_RenderClear( _renderer );
+            if ( returnCode < 0 ) {
+                ERROR_LOG( "Failed to clear renderer. The error value: " << returnCode << ", description: " << SDL_GetError() )
+                return;
+            }
+
+            returnCode = SDL_RenderCopy( _renderer, _texture, nullptr, nullptr );
+            if ( returnCode < 0 ) {
+                ERROR_LOG( "Failed to copy render.The error value: " << returnCode << ", description: " << SDL_GetError() )
+                return;
+            }
+
+            SDL_RenderPresent( _renderer );
+        }
+
         void clear() override
         {
             if ( _texture != nullptr ) {
@@ -1126,41 +1369,40 @@ namespace
 
             assert( _renderer != nullptr && _texture != nullptr );
 
-            copyImageToSurface( display, _surface, roi );
+            _updateTexture( display, roi );
+            _present();
+        }
 
-            const bool fullFrame = ( roi.width == display.width() ) && ( roi.height == display.height() );
-            if ( fullFrame ) {
-                const int returnCode = SDL_UpdateTexture( _texture, nullptr, _surface->pixels, _surface->pitch );
-                if ( returnCode < 0 ) {
-                    ERROR_LOG( "Failed to update texture. The error value: " << returnCode << ", description: " << SDL_GetError() )
-                }
+        void renderPaletteUpdate( const fheroes2::Display & display, const fheroes2::Rect & roi ) override
+        {
+            if ( _surface == nullptr ) {
+                return;
             }
-            else {
-                SDL_Rect area;
-                area.x = roi.x;
-                area.y = roi.y;
-                area.w = roi.width;
-                area.h = roi.height;
 
-                const int returnCode = SDL_UpdateTexture( _texture, &area, _surface->pixels, _surface->pitch );
-                if ( returnCode < 0 ) {
-                    ERROR_LOG( "Failed to update texture. The error value: " << returnCode << ", description: " << SDL_GetError() )
-                }
-            }
+            assert( _renderer != nullptr && _texture != nullptr );
 
-            int returnCode = SDL_RenderClear( _renderer );
-            if ( returnCode < 0 ) {
-                ERROR_LOG( "Failed to clear renderer. The error value: " << returnCode << ", description: " << SDL_GetError() )
+            // Color cycling changes only a few palette colors so only the areas containing them must be updated.
+            std::vector<fheroes2::Rect> areas;
+            if ( _surface->format->BitsPerPixel != 32 || !getPaletteChangeAreas( display, _paletteChange, areas ) ) {
+                render( display, { 0, 0, display.width(), display.height() } );
                 return;
             }
 
-            returnCode = SDL_RenderCopy( _renderer, _texture, nullptr, nullptr );
-            if ( returnCode < 0 ) {
-                ERROR_LOG( "Failed to copy render.The error value: " << returnCode << ", description: " << SDL_GetError() )
+            if ( roi.width > 0 && roi.height > 0 ) {
+                areas.push_back( roi );
+            }
+
+            _paletteChange.reset();
+
+            if ( areas.empty() ) {
                 return;
             }
 
-            SDL_RenderPresent( _renderer );
+            for ( const fheroes2::Rect & area : areas ) {
+                _updateTexture( display, area );
+            }
+
+            _present();
         }
 
         bool allocate( fheroes2::ResolutionInfo & resolutionInfo, bool isFullScreen ) override
@@ -1567,8 +1809,8 @@ namespace fheroes2
                 // when we change a palette for 8-bit image we unwillingly call render so we don't need to re-render the same frame again
                 updateImage = ( _renderSurface == nullptr );
                 if ( updateImage ) {
-                    // Pre-processing step is applied to the whole image so we forcefully render the full frame.
-                    _engine->render( *this, { 0, 0, width(), height() } );
+                    // Pre-processing step is applied to the whole image so every area containing the updated colors must be rendered.
+                    _engine->renderPaletteUpdate( *this, getBoundaryRect( roi, _prevRoi ) );
                     return;
                 }
             }
@@ -1614,6 +1856,11 @@ namespace fheroes2
         return engine().isMouseCursorActive();
     }
 
+    void BaseRenderEngine::renderPaletteUpdate( const Display & display, const Rect & /* roi */ )
+    {
+        render( display, { 0, 0, display.width(), display.height() } );
+    }
+
     BaseRenderEngine & engine()
     {
         const fheroes2::Display & display = Display::instance();
@@ -167,6 +167,9 @@ namespace fheroes2
             // Do nothing.
         }
 
+        // Renders the frame after a palette update. Since any pixel can be affected by the update the whole frame is rendered by default.
+        virtual void renderPaletteUpdate( const Display & display, const Rect & roi );
+
         virtual bool allocate( ResolutionInfo & /*unused*/, bool /*unused*/ )
         {
             return false;
@@ -24,10 +24,13 @@
 #include "serialize.h"
 
 #include <algorithm>
+#include <array>
+#include <cassert>
 #include <cstring>
 #include <ostream>
 #include <string>
 #include <string_view>
+#include <utility>
 
 #ifdef __EMSCRIPTEN__
 #include <cstdio>
@@ -44,6 +47,35 @@
 namespace
 {
     const size_t minBufferCapacity = 1024;
+
+    // Size of the temporary buffer used to change the byte order of arrays while writing them. It must be a multiple of all supported value sizes.
+    const size_t byteSwapBufferSize = 4096;
+
+    void swapBytes( uint8_t * data, const size_t size, const size_t elementSize )
+    {
+        assert( size % elementSize == 0 );
+
+        uint8_t * end = data + size;
+
+        switch ( elementSize ) {
+        case 1:
+            break;
+        case 2:
+            for ( ; data != end; data += 2 ) {
+                std::swap( data[0], data[1] );
+            }
+            break;
+        case 4:
+            for ( ; data != end; data += 4 ) {
+                std::swap( data[0], data[3] );
+                std::swap( data[1], data[2] );
+            }
+            break;
+        default:
+            assert( 0 );
+            break;
+        }
+    }
 }
 
 void StreamBase::setBigendian( bool f )
@@ -136,7 +168,7 @@ IStreamBase & IStreamBase::operator>>( std::string & v )
 {
     v.resize( get32() );
 
-    std::for_each( v.begin(), v.end(), [this]( char & item ) { item = get8(); } );
+    getArray( v.data(), v.size() );
 
     return *this;
 }
@@ -146,6 +178,18 @@ IStreamBase & IStreamBase::operator>>( fheroes2::Point & v )
     return *this >> v.x >> v.y;
 }
 
+void IStreamBase::getArrayData( void * data, const size_t count, const size_t elementSize )
+{
+    uint8_t * out = static_cast<uint8_t *>( data );
+    const size_t size = count * elementSize;
+
+    getRawData( out, size );
+
+    if ( elementSize > 1 && bigendian() != IS_BIGENDIAN ) {
+        swapBytes( out, size, elementSize );
+    }
+}
+
 void OStreamBase::put16( uint16_t v )
 {
     bigendian() ? putBE16( v ) : putLE16( v );
@@ -156,6 +200,31 @@ void OStreamBase::put32( uint32_t v )
     bigendian() ? putBE32( v ) : putLE32( v );
 }
 
+void OStreamBase::putArrayData( const void * data, const size_t count, const size_t elementSize )
+{
+    const uint8_t * in = static_cast<const uint8_t *>( data );
+    const size_t size = count * elementSize;
+
+    // The values are already stored in the byte order of the stream.
+    if ( elementSize == 1 || bigendian() == IS_BIGENDIAN ) {
+        putRaw( in, size );
+        return;
+    }
+
+    static_assert( byteSwapBufferSize % 4 == 0, "The buffer size must be a multiple of all supported value sizes." );
+
+    std::array<uint8_t, byteSwapBufferSize> buffer;
+
+    for ( size_t offset = 0; offset < size; offset += buffer.size() ) {
+        const size_t chunkSize = std::min( buffer.size(), size - offset );
+
+        std::copy( in + offset, in + offset + chunkSize, buffer.data() );
+        swapBytes( buffer.data(), chunkSize, elementSize );
+
+        putRaw( buffer.data(), chunkSize );
+    }
+}
+
 OStreamBase & OStreamBase::operator<<( const bool v )
 {
     put8( v );
@@ -366,6 +435,18 @@ ROStreamBuf::ROStreamBuf( const std::vector<uint8_t> & buf )
     setBigendian( IS_BIGENDIAN );
 }
 
+ROStreamBuf::ROStreamBuf( const uint8_t * data, const size_t size )
+{
+    assert( data != nullptr || size == 0 );
+
+    _itbeg = data;
+    _itend = _itbeg + size;
+    _itget = _itbeg;
+    _itput = _itend;
+
+    setBigendian( IS_BIGENDIAN );
+}
+
 ROStreamBuf::ROStreamBuf( std::vector<uint8_t> && buf )
     : _buf( std::move( buf ) )
 {
@@ -543,6 +624,24 @@ uint8_t StreamFile::get8()
     return getUint<uint8_t>();
 }
 
+void StreamFile::getRawData( uint8_t * data, const size_t size )
+{
+    if ( size == 0 ) {
+        return;
+    }
+
+    if ( !_file ) {
+        std::fill( data, data + size, static_cast<uint8_t>( 0 ) );
+        return;
+    }
+
+    if ( std::fread( data, size, 1, _file.get() ) != 1 ) {
+        std::fill( data, data + size, static_cast<uint8_t>( 0 ) );
+
+        setFail();
+    }
+}
+
 void StreamFile::put8( const uint8_t v )
 {
     putUint<uint8_t>( v );
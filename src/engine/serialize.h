@@ -108,6 +108,14 @@
 
 #define IS_BIGENDIAN ( BYTE_ORDER == BIG_ENDIAN )
 
+namespace fheroes2
+{
+    // Arrays of values of these types can be read and written as a whole. The result is the same as if every value was processed separately.
+    template <typename T>
+    inline constexpr bool isBulkSerializable
+        = ( std::is_integral_v<T> || std::is_enum_v<T> ) && !std::is_same_v<T, bool> && ( sizeof( T ) == 1 || sizeof( T ) == 2 || sizeof( T ) == 4 );
+}
+
 // Base class for all I/O facilities
 class StreamBase
 {
@@ -178,6 +186,13 @@ public:
         return get8();
     }
 
+    // Reads an array of values using a single read operation and a single byte order conversion pass.
+    template <typename Type, std::enable_if_t<fheroes2::isBulkSerializable<Type>, bool> = true>
+    void getArray( Type * data, const size_t count )
+    {
+        getArrayData( data, count, sizeof( Type ) );
+    }
+
     IStreamBase & operator>>( bool & v );
     IStreamBase & operator>>( char & v );
     IStreamBase & operator>>( int8_t & v );
@@ -231,13 +246,18 @@ public:
     {
         v.resize( get32() );
 
-        std::for_each( v.begin(), v.end(), [this]( auto & item ) { *this >> item; } );
+        if constexpr ( fheroes2::isBulkSerializable<Type> ) {
+            getArray( v.data(), v.size() );
+        }
+        else {
+            std::for_each( v.begin(), v.end(), [this]( auto & item ) { *this >> item; } );
+        }
 
         return *this;
     }
 
-    template <class Type>
-    IStreamBase & operator>>( std::list<Type> & v )
+    template <class Type, class Allocator>
+    IStreamBase & operator>>( std::list<Type, Allocator> & v )
     {
         v.resize( get32() );
 
@@ -276,7 +296,12 @@ public:
             return *this;
         }
 
-        std::for_each( v.begin(), v.end(), [this]( auto & item ) { *this >> item; } );
+        if constexpr ( fheroes2::isBulkSerializable<Type> ) {
+            getArray( v.data(), v.size() );
+        }
+        else {
+            std::for_each( v.begin(), v.end(), [this]( auto & item ) { *this >> item; } );
+        }
 
         return *this;
     }
@@ -285,6 +310,12 @@ protected:
     IStreamBase() = default;
 
     virtual uint8_t get8() = 0;
+
+    // Reads exactly 'size' bytes of data. If there is not enough data, then the stream is marked as failed and the output is filled with zeros.
+    virtual void getRawData( uint8_t * data, const size_t size ) = 0;
+
+private:
+    void getArrayData( void * data, const size_t count, const size_t elementSize );
 };
 
 // Interface that declares the methods needed to write to a stream
@@ -312,6 +343,13 @@ public:
         put8( ch );
     }
 
+    // Writes an array of values using a single write operation and a single byte order conversion pass.
+    template <typename Type, std::enable_if_t<fheroes2::isBulkSerializable<Type>, bool> = true>
+    void putArray( const Type * data, const size_t count )
+    {
+        putArrayData( data, count, sizeof( Type ) );
+    }
+
     OStreamBase & operator<<( const bool v );
     OStreamBase & operator<<( const char v );
     OStreamBase & operator<<( const int8_t v );
@@ -354,13 +392,18 @@ public:
     {
         put32( static_cast<uint32_t>( v.size() ) );
 
-        std::for_each( v.begin(), v.end(), [this]( const auto & item ) { *this << item; } );
+        if constexpr ( fheroes2::isBulkSerializable<Type> ) {
+            putArray( v.data(), v.size() );
+        }
+        else {
+            std::for_each( v.begin(), v.end(), [this]( const auto & item ) { *this << item; } );
+        }
 
         return *this;
     }
 
-    template <class Type>
-    OStreamBase & operator<<( const std::list<Type> & v )
+    template <class Type, class Allocator>
+    OStreamBase & operator<<( const std::list<Type, Allocator> & v )
     {
         put32( static_cast<uint32_t>( v.size() ) );
 
@@ -384,7 +427,12 @@ public:
     {
         put32( static_cast<uint32_t>( v.size() ) );
 
-        std::for_each( v.begin(), v.end(), [this]( const auto & item ) { *this << item; } );
+        if constexpr ( fheroes2::isBulkSerializable<Type> ) {
+            putArray( v.data(), v.size() );
+        }
+        else {
+            std::for_each( v.begin(), v.end(), [this]( const auto & item ) { *this << item; } );
+        }
 
         return *this;
     }
@@ -393,6 +441,9 @@ protected:
     OStreamBase() = default;
 
     virtual void put8( const uint8_t ) = 0;
+
+private:
+    void putArrayData( const void * data, const size_t count, const size_t elementSize );
 };
 
 // Interface that declares a stream with an in-memory storage backend that can be read from
@@ -544,6 +595,23 @@ protected:
         return 0;
     }
 
+    void getRawData( uint8_t * data, const size_t size ) override
+    {
+        if ( size > sizeg() ) {
+            _itget = _itput;
+
+            std::fill( data, data + size, static_cast<uint8_t>( 0 ) );
+
+            setFail();
+
+            return;
+        }
+
+        std::copy( _itget, _itget + size, data );
+
+        _itget += size;
+    }
+
     size_t capacity() const
     {
         assert( _itbeg <= _itend );
@@ -597,6 +665,8 @@ class ROStreamBuf final : public StreamBufTmpl<const uint8_t>
 public:
     // Creates a non-owning stream on top of an external buffer ("view mode")
     explicit ROStreamBuf( const std::vector<uint8_t> & buf );
+    // Creates a non-owning stream on top of an external memory region ("view mode")
+    ROStreamBuf( const uint8_t * data, const size_t size );
     // Takes ownership of the given buffer (through the move operation) and creates a stream on top of it
     explicit ROStreamBuf( std::vector<uint8_t> && buf );
 
@@ -672,6 +742,8 @@ private:
     uint8_t get8() override;
     void put8( const uint8_t v ) override;
 
+    void getRawData( uint8_t * data, const size_t size ) override;
+
     template <typename T>
     T getUint()
     {
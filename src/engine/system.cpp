@@ -313,6 +313,16 @@ bool System::Unlink( const std::string_view path )
     return std::filesystem::remove( path, ec );
 }
 
+bool System::Rename( const std::string_view from, const std::string_view to )
+{
+    std::error_code ec;
+
+    // Using the non-throwing overload
+    std::filesystem::rename( from, to, ec );
+
+    return !ec;
+}
+
 std::string System::concatPath( const std::string_view left, const std::string_view right )
 {
     return fsPathToString( std::filesystem::path{ left }.append( right ) );
@@ -433,6 +443,36 @@ bool System::IsFile( const std::string_view path )
     return std::filesystem::is_regular_file( correctedPath, ec );
 }
 
+bool System::getFileStatus( const std::string_view path, uint64_t & size, int64_t & modificationTime )
+{
+    if ( path.empty() ) {
+        return false;
+    }
+
+    std::string correctedPath;
+    if ( !GetCaseInsensitivePath( path, correctedPath ) ) {
+        return false;
+    }
+
+    std::error_code ec;
+
+    // Using the non-throwing overloads
+    const uintmax_t fileSize = std::filesystem::file_size( correctedPath, ec );
+    if ( ec ) {
+        return false;
+    }
+
+    const std::filesystem::file_time_type lastWriteTime = std::filesystem::last_write_time( correctedPath, ec );
+    if ( ec ) {
+        return false;
+    }
+
+    size = static_cast<uint64_t>( fileSize );
+    modificationTime = static_cast<int64_t>( lastWriteTime.time_since_epoch().count() );
+
+    return true;
+}
+
 bool System::IsDirectory( const std::string_view path )
 {
     if ( path.empty() ) {
@@ -23,6 +23,7 @@
 
 #pragma once
 
+#include <cstdint>
 #include <ctime>
 #include <filesystem>
 #include <string>
@@ -45,6 +46,9 @@ namespace System
     bool MakeDirectory( const std::string_view path );
     bool Unlink( const std::string_view path );
 
+    // Renames the file. If the target file exists it is replaced.
+    bool Rename( const std::string_view from, const std::string_view to );
+
     std::string concatPath( const std::string_view left, const std::string_view right );
 
     void appendOSSpecificDirectories( std::vector<std::string> & directories );
@@ -64,6 +68,10 @@ namespace System
     bool IsFile( const std::string_view path );
     bool IsDirectory( const std::string_view path );
 
+    // Retrieves the size and the time of the last modification of the given file. The modification time is only suitable for comparison with
+    // other values returned by this function. Returns false if the file does not exist or its status cannot be retrieved.
+    bool getFileStatus( const std::string_view path, uint64_t & size, int64_t & modificationTime );
+
     bool GetCaseInsensitivePath( const std::string_view path, std::string & correctedPath );
 
     // Resolves the wildcard pattern 'glob' and appends matching paths to 'fileNames'. Supported wildcards are '?' and '*'.
@@ -21,7 +21,10 @@
 #include "thread.h"
 
 #include <cassert>
+#include <exception>
 #include <memory>
+#include <utility>
+#include <vector>
 
 #if defined( __EMSCRIPTEN__ ) && !defined( __EMSCRIPTEN_PTHREADS__ )
 namespace
@@ -50,6 +53,172 @@ namespace
 }
 #endif
 
+#if !defined( __EMSCRIPTEN__ ) || defined( __EMSCRIPTEN_PTHREADS__ )
+namespace
+{
+    // This flag is set for the worker threads of the pool to detect nested calls of parallelFor().
+    thread_local bool isPoolWorkerThread{ false };
+
+    class WorkerPool
+    {
+    public:
+        WorkerPool()
+        {
+            const uint32_t hardwareThreads = std::thread::hardware_concurrency();
+            const uint32_t workerCount = ( hardwareThreads > 1 ) ? hardwareThreads - 1 : 0;
+
+            _workers.reserve( workerCount );
+
+            for ( uint32_t i = 0; i < workerCount; ++i ) {
+                _workers.emplace_back( &WorkerPool::_workerThread, this );
+            }
+        }
+
+        WorkerPool( const WorkerPool & ) = delete;
+
+        ~WorkerPool()
+        {
+            {
+                const std::scoped_lock<std::mutex> lock( _mutex );
+
+                _exitFlag = true;
+            }
+
+            _workerNotification.notify_all();
+
+            for ( std::thread & worker : _workers ) {
+                worker.join();
+            }
+        }
+
+        WorkerPool & operator=( const WorkerPool & ) = delete;
+
+        static WorkerPool & instance()
+        {
+            static WorkerPool pool;
+            return pool;
+        }
+
+        uint32_t threadCount() const
+        {
+            return static_cast<uint32_t>( _workers.size() ) + 1;
+        }
+
+        // Returns false if the pool cannot be used at the moment. In this case the caller should execute tasks by itself.
+        bool run( const size_t count, const std::function<void( size_t )> & task )
+        {
+            if ( _workers.empty() || isPoolWorkerThread ) {
+                return false;
+            }
+
+            std::unique_lock<std::mutex> runLock( _runMutex, std::try_to_lock );
+            if ( !runLock.owns_lock() ) {
+                // Another thread is already using the pool.
+                return false;
+            }
+
+            {
+                const std::scoped_lock<std::mutex> lock( _mutex );
+
+                _task = &task;
+                _taskCount = count;
+                _nextTaskIndex = 0;
+                _activeWorkers = _workers.size();
+                _exception = nullptr;
+
+                ++_generation;
+            }
+
+            _workerNotification.notify_all();
+
+            _processTasks();
+
+            std::unique_lock<std::mutex> lock( _mutex );
+
+            _masterNotification.wait( lock, [this] { return _activeWorkers == 0; } );
+
+            _task = nullptr;
+
+            if ( _exception ) {
+                std::rethrow_exception( std::exchange( _exception, nullptr ) );
+            }
+
+            return true;
+        }
+
+    private:
+        std::vector<std::thread> _workers;
+
+        std::mutex _runMutex;
+        std::mutex _mutex;
+
+        std::condition_variable _workerNotification;
+        std::condition_variable _masterNotification;
+
+        const std::function<void( size_t )> * _task{ nullptr };
+        size_t _taskCount{ 0 };
+        std::atomic<size_t> _nextTaskIndex{ 0 };
+        size_t _activeWorkers{ 0 };
+        uint64_t _generation{ 0 };
+        std::exception_ptr _exception;
+        bool _exitFlag{ false };
+
+        void _processTasks()
+        {
+            while ( true ) {
+                const size_t index = _nextTaskIndex.fetch_add( 1 );
+                if ( index >= _taskCount ) {
+                    break;
+                }
+
+                try {
+                    ( *_task )( index );
+                }
+                catch ( ... ) {
+                    const std::scoped_lock<std::mutex> lock( _mutex );
+
+                    if ( !_exception ) {
+                        _exception = std::current_exception();
+                    }
+                }
+            }
+        }
+
+        void _workerThread()
+        {
+            isPoolWorkerThread = true;
+
+            uint64_t processedGeneration = 0;
+
+            while ( true ) {
+                {
+                    std::unique_lock<std::mutex> lock( _mutex );
+
+                    _workerNotification.wait( lock, [this, processedGeneration] { return _exitFlag || _generation != processedGeneration; } );
+
+                    if ( _exitFlag ) {
+                        return;
+                    }
+
+                    processedGeneration = _generation;
+                }
+
+                _processTasks();
+
+                {
+                    const std::scoped_lock<std::mutex> lock( _mutex );
+
+                    assert( _activeWorkers > 0 );
+                    --_activeWorkers;
+                }
+
+                _masterNotification.notify_one();
+            }
+        }
+    };
+}
+#endif
+
 namespace MultiThreading
 {
     void AsyncManager::createWorker()
@@ -150,4 +319,30 @@ namespace MultiThreading
             manager->executeTask();
         }
     }
+
+    uint32_t getParallelThreadCount()
+    {
+#if defined( __EMSCRIPTEN__ ) && !defined( __EMSCRIPTEN_PTHREADS__ )
+        return 1;
+#else
+        return WorkerPool::instance().threadCount();
+#endif
+    }
+
+    void parallelFor( const size_t count, const std::function<void( size_t )> & task )
+    {
+        if ( count == 0 ) {
+            return;
+        }
+
+#if !defined( __EMSCRIPTEN__ ) || defined( __EMSCRIPTEN_PTHREADS__ )
+        if ( count > 1 && WorkerPool::instance().run( count, task ) ) {
+            return;
+        }
+#endif
+
+        for ( size_t i = 0; i < count; ++i ) {
+            task( i );
+        }
+    }
 }
@@ -22,6 +22,9 @@
 
 #include <atomic>
 #include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
 #include <memory>
 #include <mutex>
 #include <thread>
@@ -70,4 +73,14 @@ namespace MultiThreading
 
         static void _workerThread( AsyncManager * manager );
     };
+
+    // Returns the number of threads (including the calling one) that are used by parallelFor() to execute tasks.
+    uint32_t getParallelThreadCount();
+
+    // Executes the given task for every index in the [0, count) range and returns when all of them are completed. Tasks are
+    // distributed between the calling thread and a pool of worker threads, so the task must be thread-safe and the order in
+    // which indexes are processed is not defined. Nested calls, as well as calls made while another thread is running its own
+    // parallelFor(), are executed sequentially in the calling thread. If any of the tasks throws an exception, the first caught
+    // exception is re-thrown in the calling thread after all tasks are completed.
+    void parallelFor( const size_t count, const std::function<void( size_t )> & task );
 }
@@ -23,6 +23,9 @@
 
 #include "zzlib.h"
 
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
 #include <cstring>
 #include <ostream>
 
@@ -31,10 +34,87 @@
 
 #include "logging.h"
 #include "serialize.h"
+#include "thread.h"
 
 namespace
 {
+    // The whole data is zipped as a single chunk.
     constexpr uint16_t FORMAT_VERSION_0 = 0;
+    // The data is split into chunks which are zipped independently. The zipped data starts from the number of chunks
+    // followed by the unzipped size, the zipped size and the zipped data of every chunk.
+    constexpr uint16_t FORMAT_VERSION_1 = 1;
+
+    // Smaller chunks allow to use more threads but make the compression ratio worse.
+    constexpr size_t zipChunkSize{ 256 * 1024 };
+
+    struct ZipChunk
+    {
+        size_t rawOffset{ 0 };
+        size_t rawSize{ 0 };
+        size_t zipOffset{ 0 };
+        size_t zipSize{ 0 };
+    };
+
+    bool unzipChunks( const std::vector<uint8_t> & zip, const uint32_t rawSize, OStreamBase & outputStream )
+    {
+        ROStreamBuf zipStream( zip.data(), zip.size() );
+        zipStream.setBigendian( true );
+
+        const uint32_t chunkCount = zipStream.get32();
+        if ( chunkCount == 0 || chunkCount > zip.size() ) {
+            return false;
+        }
+
+        std::vector<ZipChunk> chunks( chunkCount );
+
+        size_t rawOffset = 0;
+        size_t zipOffset = sizeof( uint32_t );
+
+        for ( ZipChunk & chunk : chunks ) {
+            chunk.rawOffset = rawOffset;
+            chunk.rawSize = zipStream.get32();
+            chunk.zipSize = zipStream.get32();
+
+            zipOffset += 2 * sizeof( uint32_t );
+            chunk.zipOffset = zipOffset;
+
+            if ( zipStream.fail() || chunk.rawSize == 0 || chunk.zipSize == 0 || chunk.zipSize > zip.size() - zipOffset ) {
+                return false;
+            }
+
+            zipStream.skip( chunk.zipSize );
+
+            rawOffset += chunk.rawSize;
+            zipOffset += chunk.zipSize;
+        }
+
+        if ( rawOffset != rawSize || zipOffset != zip.size() ) {
+            return false;
+        }
+
+        std::vector<uint8_t> raw( rawSize );
+        std::atomic<bool> isFailed{ false };
+
+        MultiThreading::parallelFor( chunks.size(), [&zip, &chunks, &raw, &isFailed]( const size_t chunkId ) {
+            const ZipChunk & chunk = chunks[chunkId];
+
+            const std::vector<uint8_t> data = Compression::unzipData( zip.data() + chunk.zipOffset, chunk.zipSize, chunk.rawSize );
+            if ( data.size() != chunk.rawSize ) {
+                isFailed = true;
+                return;
+            }
+
+            memcpy( raw.data() + chunk.rawOffset, data.data(), data.size() );
+        } );
+
+        if ( isFailed ) {
+            return false;
+        }
+
+        outputStream.putRaw( raw.data(), raw.size() );
+
+        return !outputStream.fail();
+    }
 }
 
 std::vector<uint8_t> Compression::unzipData( const uint8_t * src, const size_t srcSize, size_t realSize /* = 0 */ )
@@ -100,7 +180,7 @@ std::vector<uint8_t> Compression::unzipData( const uint8_t * src, const size_t s
     return res;
 }
 
-std::vector<uint8_t> Compression::zipData( const uint8_t * src, const size_t srcSize )
+std::vector<uint8_t> Compression::zipData( const uint8_t * src, const size_t srcSize, const int level /* = defaultCompressionLevel */ )
 {
     if ( src == nullptr || srcSize == 0 ) {
         return {};
@@ -120,7 +200,7 @@ std::vector<uint8_t> Compression::zipData( const uint8_t * src, const size_t src
         return {};
     }
 
-    const int ret = compress( res.data(), &dstSizeULong, src, srcSizeULong );
+    const int ret = compress2( res.data(), &dstSizeULong, src, srcSizeULong, level );
 
     if ( ret != Z_OK ) {
         ERROR_LOG( "zlib error: " << ret )
@@ -141,13 +221,21 @@ bool Compression::unzipStream( IStreamBase & inputStream, OStreamBase & outputSt
     }
 
     const uint16_t version = inputStream.get16();
-    if ( version != FORMAT_VERSION_0 ) {
+    if ( version != FORMAT_VERSION_0 && version != FORMAT_VERSION_1 ) {
         return false;
     }
 
     inputStream.skip( 2 ); // Unused bytes
 
     const std::vector<uint8_t> zip = inputStream.getRaw( zipSize );
+    if ( zip.size() != zipSize ) {
+        return false;
+    }
+
+    if ( version == FORMAT_VERSION_1 ) {
+        return unzipChunks( zip, rawSize, outputStream );
+    }
+
     const std::vector<uint8_t> raw = unzipData( zip.data(), zip.size(), rawSize );
     if ( raw.size() != rawSize ) {
         return false;
@@ -174,6 +262,54 @@ bool Compression::zipStreamBuf( const IStreamBuf & inputStream, OStreamBase & ou
     return !outputStream.fail();
 }
 
+bool Compression::zipStreamBufInChunks( const IStreamBuf & inputStream, OStreamBase & outputStream, const int level /* = defaultCompressionLevel */ )
+{
+    const uint8_t * data = inputStream.data();
+    const size_t dataSize = inputStream.size();
+
+    if ( dataSize == 0 || dataSize > UINT32_MAX ) {
+        return false;
+    }
+
+    std::vector<std::vector<uint8_t>> zipChunks( ( dataSize + zipChunkSize - 1 ) / zipChunkSize );
+
+    MultiThreading::parallelFor( zipChunks.size(), [data, dataSize, level, &zipChunks]( const size_t chunkId ) {
+        const size_t offset = chunkId * zipChunkSize;
+        zipChunks[chunkId] = zipData( data + offset, std::min( zipChunkSize, dataSize - offset ), level );
+    } );
+
+    size_t zipSize = sizeof( uint32_t );
+
+    for ( const std::vector<uint8_t> & zip : zipChunks ) {
+        if ( zip.empty() ) {
+            return false;
+        }
+
+        zipSize += 2 * sizeof( uint32_t ) + zip.size();
+    }
+
+    if ( zipSize > UINT32_MAX ) {
+        return false;
+    }
+
+    outputStream.put32( static_cast<uint32_t>( dataSize ) );
+    outputStream.put32( static_cast<uint32_t>( zipSize ) );
+    outputStream.put16( FORMAT_VERSION_1 );
+    outputStream.put16( 0 ); // Unused bytes
+
+    outputStream.put32( static_cast<uint32_t>( zipChunks.size() ) );
+
+    for ( size_t chunkId = 0; chunkId < zipChunks.size(); ++chunkId ) {
+        const std::vector<uint8_t> & zip = zipChunks[chunkId];
+
+        outputStream.put32( static_cast<uint32_t>( std::min( zipChunkSize, dataSize - chunkId * zipChunkSize ) ) );
+        outputStream.put32( static_cast<uint32_t>( zip.size() ) );
+        outputStream.putRaw( zip.data(), zip.size() );
+    }
+
+    return !outputStream.fail();
+}
+
 fheroes2::Image Compression::CreateImageFromZlib( int32_t width, int32_t height, const uint8_t * imageData, size_t imageSize, bool doubleLayer )
 {
     if ( imageData == nullptr || imageSize == 0 || width <= 0 || height <= 0 ) {
@@ -35,14 +35,18 @@ class IStreamBuf;
 
 namespace Compression
 {
+    // zlib compression levels: from 1 (the fastest compression) to 9 (the best compression). The default level is a compromise between them.
+    constexpr int defaultCompressionLevel{ -1 };
+    constexpr int fastestCompressionLevel{ 1 };
+
     // Unzips the input data and returns the uncompressed data or an empty vector in case of an error.
     // The 'realSize' parameter represents the planned size of the decompressed data and is optional
     // (it is only used to speed up the decompression process). If this parameter is omitted or set to
     // zero, the size of the decompressed data will be determined automatically.
     std::vector<uint8_t> unzipData( const uint8_t * src, const size_t srcSize, size_t realSize = 0 );
 
-    // Zips the input data and returns the compressed data or an empty vector in case of an error.
-    std::vector<uint8_t> zipData( const uint8_t * src, const size_t srcSize );
+    // Zips the input data using the given compression level and returns the compressed data or an empty vector in case of an error.
+    std::vector<uint8_t> zipData( const uint8_t * src, const size_t srcSize, const int level = defaultCompressionLevel );
 
     // Reads & unzips the zipped chunk from the given input stream and writes it to the given output
     // stream. Returns true on success or false on error.
@@ -53,5 +57,10 @@ namespace Compression
     // true on success and false on error.
     bool zipStreamBuf( const IStreamBuf & inputStream, OStreamBase & outputStream );
 
+    // Does the same as zipStreamBuf() but splits the contents of the buffer into chunks which are zipped in parallel using the given
+    // compression level. The written data can be read by unzipStream() which also unzips chunks in parallel. Returns true on success
+    // and false on error.
+    bool zipStreamBufInChunks( const IStreamBuf & inputStream, OStreamBase & outputStream, const int level = defaultCompressionLevel );
+
     fheroes2::Image CreateImageFromZlib( int32_t width, int32_t height, const uint8_t * imageData, size_t imageSize, bool doubleLayer );
 }
@@ -22,6 +22,7 @@
  ***************************************************************************/
 
 #include <list>
+#include <mutex>
 #include <stdexcept>
 #include <utility>
 
@@ -34,13 +35,38 @@
 namespace
 {
     fheroes2::AGGFile heroes_agg;
+
+    // Resources can be read by several threads at the same time, but the AGG file has a single stream. The lock is not needed
+    // if the AGG file is memory mapped.
+    std::mutex heroesAggMutex;
 }
 
 std::vector<uint8_t> AGG::getDataFromAggFile( const std::string & key, const bool /*ignoreExpansion*/ )
 {
+    if ( heroes_agg.isMapped() ) {
+        return heroes_agg.read( key );
+    }
+
+    const std::scoped_lock<std::mutex> lock( heroesAggMutex );
+
     return heroes_agg.read( key );
 }
 
+std::pair<const uint8_t *, size_t> AGG::getDataViewFromAggFile( const std::string & key, std::vector<uint8_t> & buffer )
+{
+    if ( heroes_agg.isMapped() ) {
+        return heroes_agg.getView( key );
+    }
+
+    buffer = getDataFromAggFile( key, false );
+
+    if ( buffer.empty() ) {
+        return { nullptr, 0 };
+    }
+
+    return { buffer.data(), buffer.size() };
+}
+
 std::vector<std::string> AGG::getHoMM1MapNames()
 {
     return heroes_agg.getFileNamesWithExtension( ".MAP" );
@@ -23,8 +23,10 @@
 
 #pragma once
 
+#include <cstddef>
 #include <cstdint>
 #include <string>
+#include <utility>
 #include <vector>
 
 namespace AGG
@@ -51,6 +53,10 @@ namespace AGG
 
     std::vector<uint8_t> getDataFromAggFile( const std::string & key, const bool ignoreExpansion );
 
+    // Returns a non-owning view of the given AGG file entry without copying it when the AGG file is memory mapped. Otherwise, the entry
+    // is read into the provided buffer and the returned view points to it. An empty view is returned if the entry does not exist.
+    std::pair<const uint8_t *, size_t> getDataViewFromAggFile( const std::string & key, std::vector<uint8_t> & buffer );
+
     std::vector<std::string> getHoMM1MapNames();
 
     // Only for internal usage within AGG namespace.
@@ -22,15 +22,20 @@
 
 #include <algorithm>
 #include <array>
+#include <atomic>
 #include <cassert>
 #include <cmath>
 #include <cstddef>
+#include <deque>
 #include <initializer_list>
 #include <map>
+#include <mutex>
 #include <numeric>
+#include <optional>
 #include <set>
 #include <stdexcept>
 #include <string>
+#include <string_view>
 #include <utility>
 #include <vector>
 
@@ -43,12 +48,15 @@
 #include "icn.h"
 #include "image.h"
 #include "image_tool.h"
+#include "logging.h"
 #include "math_base.h"
 #include "pal.h"
 #include "rand.h"
 #include "screen.h"
 #include "serialize.h"
+#include "thread.h"
 #include "til.h"
+#include "timing.h"
 #include "tools.h"
 #include "translations.h"
 #include "ui_button.h"
@@ -69,6 +77,54 @@ namespace
 
     std::map<int, std::vector<fheroes2::Sprite>> _icnVsScaledSprite;
 
+    // Resources decoded in the background. They are moved to the main cache by the main thread when they are requested for the first time.
+    // The key is the resource id, the value of the ICN entry indicates whether the ICN was found in AGG file.
+    std::mutex _preloadMutex;
+    std::map<int, std::pair<bool, std::vector<fheroes2::Sprite>>> _preloadedIcnVsSprite;
+    std::map<int, std::vector<std::vector<fheroes2::Image>>> _preloadedTilVsImage;
+
+    // Resources which the main thread has requested before they were decoded in the background. The main thread decodes them by itself
+    // so the background decoding of them must be skipped or its result must be dropped.
+    std::set<int> _mainThreadIcnIds;
+    std::set<int> _mainThreadTilIds;
+
+    // Returns an empty value if the ICN has not been decoded in the background, otherwise moves the decoded sprites to the given
+    // container and returns whether the ICN was found in AGG file.
+    std::optional<bool> takePreloadedICN( const int id, std::vector<fheroes2::Sprite> & sprites )
+    {
+        const std::scoped_lock<std::mutex> lock( _preloadMutex );
+
+        const auto iter = _preloadedIcnVsSprite.find( id );
+        if ( iter == _preloadedIcnVsSprite.end() ) {
+            _mainThreadIcnIds.insert( id );
+            return {};
+        }
+
+        const bool isFound = iter->second.first;
+        sprites = std::move( iter->second.second );
+
+        _preloadedIcnVsSprite.erase( iter );
+
+        return isFound;
+    }
+
+    bool takePreloadedTIL( const int id, std::vector<std::vector<fheroes2::Image>> & images )
+    {
+        const std::scoped_lock<std::mutex> lock( _preloadMutex );
+
+        const auto iter = _preloadedTilVsImage.find( id );
+        if ( iter == _preloadedTilVsImage.end() ) {
+            _mainThreadTilIds.insert( id );
+            return false;
+        }
+
+        images = std::move( iter->second );
+
+        _preloadedTilVsImage.erase( iter );
+
+        return true;
+    }
+
     // Some resources are language dependent. These are mostly buttons with a text of them.
     // Once a user changes a language we have to update resources. To do this we need to clear the existing images.
 
@@ -721,16 +777,17 @@ namespace
         return offsets;
     }
 
-    // This function returns true if sprites were successfully loaded from AGG file.
-    // WARNING: this function must be called once - only in the beginning of `loadICN()` function.
-    bool readIcnFromAgg( const int id )
+    // Decodes sprites of the given ICN from AGG file. Returns true if sprites were successfully decoded. This function does not access
+    // any cached resources, so it can be called from any thread.
+    bool decodeIcnFromAgg( const int id, std::vector<fheroes2::Sprite> & sprites )
     {
-        // If this assertion blows up then something wrong with your logic and you load resources more than once!
-        assert( _icnVsSprite[id].empty() );
+        assert( sprites.empty() );
 
-        const std::vector<uint8_t> & body = ::AGG::getDataFromAggFile( ICN::getIcnFileName( id ), false );
+        // The data is accessed directly in the AGG file when possible so no copy of the whole ICN is made.
+        std::vector<uint8_t> bodyBuffer;
+        const auto [body, bodySize] = ::AGG::getDataViewFromAggFile( ICN::getIcnFileName( id ), bodyBuffer );
 
-        if ( body.empty() ) {
+        if ( bodySize == 0 ) {
             return false;
         }
 
@@ -742,21 +799,22 @@ namespace
             const bool isBmpFile = icnFileName.size() >= 4
                                    && icnFileName.compare( icnFileName.size() - 4, 4, ".BMP" ) == 0;
             if ( isBmpFile ) {
-                if ( body.size() < 6 )
+                if ( bodySize < 6 )
                     return false;
                 const uint32_t w = static_cast<uint32_t>( body[2] ) | ( static_cast<uint32_t>( body[3] ) << 8 );
                 const uint32_t h = static_cast<uint32_t>( body[4] ) | ( static_cast<uint32_t>( body[5] ) << 8 );
-                if ( w == 0 || h == 0 || body.size() != 6 + w * h )
+                if ( w == 0 || h == 0 || bodySize != 6 + w * h )
                     return false;
 
                 fheroes2::Sprite sprite( static_cast<int32_t>( w ), static_cast<int32_t>( h ), 0, 0 );
                 sprite.reset();
                 uint8_t * imageData = sprite.image();
                 uint8_t * transformData = sprite.transform();
-                const uint8_t * pixels = body.data() + 6;
+                const uint8_t * pixels = body + 6;
 
-                const std::vector<uint8_t> & palData = ::AGG::getDataFromAggFile( "KB.PAL", false );
-                if ( palData.size() >= 256 * 3 ) {
+                std::vector<uint8_t> palBuffer;
+                const auto [palData, palDataSize] = ::AGG::getDataViewFromAggFile( "KB.PAL", palBuffer );
+                if ( palDataSize >= 256 * 3 ) {
                     for ( uint32_t i = 0; i < w * h; ++i ) {
                         const uint8_t idx = pixels[i];
                         const uint8_t r = static_cast<uint8_t>( palData[idx * 3 + 0] << 2 );
@@ -774,13 +832,13 @@ namespace
                     }
                 }
 
-                _icnVsSprite[id].resize( 1 );
-                _icnVsSprite[id][0] = std::move( sprite );
+                sprites.resize( 1 );
+                sprites[0] = std::move( sprite );
                 return true;
             }
         }
 
-        ROStreamBuf imageStream( body );
+        ROStreamBuf imageStream( body, bodySize );
 
         const uint32_t count = imageStream.getLE16();
         const uint32_t blockSize = imageStream.getLE32();
@@ -789,9 +847,9 @@ namespace
         }
 
         // HoMM1 ICN detection: blockSize covers the entire post-preamble content
-        // (both the header table and the sprite data), so blockSize == body.size() - headerSize.
+        // (both the header table and the sprite data), so blockSize == bodySize - headerSize.
         // HoMM2 ICN: blockSize is the sprite-data-only block, which is smaller.
-        const bool isHoMM1 = ( blockSize + headerSize == static_cast<uint32_t>( body.size() ) );
+        const bool isHoMM1 = ( blockSize + headerSize == static_cast<uint32_t>( bodySize ) );
 
         if ( isHoMM1 ) {
             // HoMM1 ICN format:
@@ -801,20 +859,20 @@ namespace
 
             const uint32_t icnHdrStride = 12;
             const uint32_t dataBlockOffset = headerSize + count * icnHdrStride;
-            if ( dataBlockOffset > static_cast<uint32_t>( body.size() ) )
+            if ( dataBlockOffset > static_cast<uint32_t>( bodySize ) )
                 return false;
 
-            const uint32_t dataOnlySize = static_cast<uint32_t>( body.size() ) - dataBlockOffset;
+            const uint32_t dataOnlySize = static_cast<uint32_t>( bodySize ) - dataBlockOffset;
 
             // Font ICNs (FONT.ICN, SMALFONT.ICN) are monochromatic; all other HoMM1 ICNs are colour.
             const std::string & filename = ICN::getIcnFileName( id );
             const bool isMonoFont = ( filename.find( "FONT" ) != std::string::npos );
 
             // Build sequential sprite offset table by scanning the data block.
-            const uint8_t * db = body.data() + dataBlockOffset;
+            const uint8_t * db = body + dataBlockOffset;
             const std::vector<uint32_t> spriteOffsets = buildHoMM1SpriteOffsets( db, dataOnlySize, count, isMonoFont );
 
-            _icnVsSprite[id].resize( count );
+            sprites.resize( count );
 
             for ( uint32_t i = 0; i < count; ++i ) {
                 // Construct a synthetic ICNHeader from the 12-byte HoMM1 header.
@@ -832,26 +890,26 @@ namespace
                 header1.animationFrames = isMonoFont ? 0x20 : 0;
 
                 // Encode sprite data offset so the existing pointer arithmetic still holds:
-                //   body.data() + headerSize + offsetData  ==  db + spriteOffsets[i]
+                //   body + headerSize + offsetData  ==  db + spriteOffsets[i]
                 header1.offsetData = count * icnHdrStride + spriteOffsets[i];
 
                 const uint32_t dataSize = ( i + 1 != count ) ? ( spriteOffsets[i + 1] - spriteOffsets[i] )
                                                               : ( dataOnlySize - spriteOffsets[i] );
 
-                if ( headerSize + header1.offsetData + dataSize > body.size() ) {
+                if ( headerSize + header1.offsetData + dataSize > bodySize ) {
                     throw fheroes2::InvalidDataResources( "ICN Id " + std::to_string( id ) + ", index " + std::to_string( i )
                                                           + " is being corrupted. "
                                                             "Make sure that you own an official version of the game." );
                 }
 
-                const uint8_t * data = body.data() + headerSize + header1.offsetData;
+                const uint8_t * data = body + headerSize + header1.offsetData;
                 const uint8_t * dataEnd = data + dataSize;
-                _icnVsSprite[id][i] = fheroes2::decodeICNSprite( data, dataEnd, header1 );
+                sprites[i] = fheroes2::decodeICNSprite( data, dataEnd, header1 );
 
                 // If the sprite has no transparent pixels, decodeICNSprite disables its transform layer.
                 // Promote single-layer sprites back to double-layer so that downstream code
                 // (e.g. copyTransformLayer, cursor rendering) never sees a single-layer source sprite.
-                fheroes2::Sprite & s = _icnVsSprite[id][i];
+                fheroes2::Sprite & s = sprites[i];
                 if ( s.singleLayer() && !s.empty() ) {
                     fheroes2::Sprite doubleLayer( s.width(), s.height(), s.x(), s.y() );
                     fheroes2::Copy( s, doubleLayer );
@@ -864,7 +922,7 @@ namespace
             // The color-remapping tables (WHITE_FONT, YELLOW_FONT, etc.) only operate on indices 10-36,
             // so remap 0 -> 10 (the start of the white range) to make palette-based coloring work.
             if ( isMonoFont ) {
-                for ( fheroes2::Sprite & s : _icnVsSprite[id] ) {
+                for ( fheroes2::Sprite & s : sprites ) {
                     fheroes2::ReplaceColorId( s, 0, 10 );
                 }
             }
@@ -873,7 +931,7 @@ namespace
         }
 
         // HoMM2 ICN format (original code path).
-        _icnVsSprite[id].resize( count );
+        sprites.resize( count );
 
         for ( uint32_t i = 0; i < count; ++i ) {
             imageStream.seek( headerSize + i * 13 );
@@ -894,23 +952,38 @@ namespace
                 dataSize = blockSize - header1.offsetData;
             }
 
-            if ( headerSize + header1.offsetData + dataSize > body.size() ) {
+            if ( headerSize + header1.offsetData + dataSize > bodySize ) {
                 // This is a corrupted AGG file.
                 throw fheroes2::InvalidDataResources( "ICN Id " + std::to_string( id ) + ", index " + std::to_string( i )
                                                       + " is being corrupted. "
                                                         "Make sure that you own an official version of the game." );
             }
 
-            const uint8_t * data = body.data() + headerSize + header1.offsetData;
+            const uint8_t * data = body + headerSize + header1.offsetData;
             const uint8_t * dataEnd = data + dataSize;
 
-            _icnVsSprite[id][i] = fheroes2::decodeICNSprite( data, dataEnd, header1 );
+            sprites[i] = fheroes2::decodeICNSprite( data, dataEnd, header1 );
         }
 
         return true;
     }
 
     // Helper function for processICN
+    // This function returns true if sprites were successfully loaded from AGG file.
+    // WARNING: this function must be called once - only in the beginning of `loadICN()` function.
+    bool readIcnFromAgg( const int id )
+    {
+        // If this assertion blows up then something wrong with your logic and you load resources more than once!
+        assert( _icnVsSprite[id].empty() );
+
+        // The ICN could have already been decoded in the background.
+        if ( const std::optional<bool> isPreloaded = takePreloadedICN( id, _icnVsSprite[id] ); isPreloaded ) {
+            return *isPreloaded;
+        }
+
+        return decodeIcnFromAgg( id, _icnVsSprite[id] );
+    }
+
     void CopyICNWithPalette( const int icnId, const int originalIcnId, const PAL::PaletteType paletteType )
     {
         assert( icnId != originalIcnId );
@@ -2660,8 +2733,9 @@ namespace
                 throw std::logic_error( "The game resources are corrupted. Please use resources from a licensed version of Heroes of Might and Magic II." );
             }
 
-            const std::vector<uint8_t> & body = ::AGG::getDataFromAggFile( ICN::getIcnFileName( id ), false );
-            const uint32_t crc32 = fheroes2::calculateCRC32( body.data(), body.size() );
+            std::vector<uint8_t> bodyBuffer;
+            const auto [body, bodySize] = ::AGG::getDataViewFromAggFile( ICN::getIcnFileName( id ), bodyBuffer );
+            const uint32_t crc32 = fheroes2::calculateCRC32( body, bodySize );
 
             if ( id == ICN::SMALFONT ) {
                 // Small font in official Polish GoG version has all letters shifted 1 pixel down.
@@ -5858,50 +5932,60 @@ namespace
         return _icnVsSprite[id].size();
     }
 
-    size_t GetMaximumTILIndex( const int id )
+    // Decodes images of the given TIL from AGG file. This function does not access any cached resources, so it can be called from any thread.
+    void decodeTilFromAgg( const int id, std::vector<std::vector<fheroes2::Image>> & tilImages )
     {
-        auto & tilImages = _tilVsImage[id];
+        assert( tilImages.empty() );
 
-        if ( tilImages.empty() ) {
-            tilImages.resize( 4 ); // 4 possible sides
+        tilImages.resize( 4 ); // 4 possible sides
 
-            const std::vector<uint8_t> & data = ::AGG::getDataFromAggFile( tilFileName[id], false );
-            if ( data.size() < headerSize ) {
-                // The important resource is absent! Make sure that you are using the correct version of the game.
-                assert( 0 );
-                return 0;
-            }
+        std::vector<uint8_t> dataBuffer;
+        const auto [data, dataSize] = ::AGG::getDataViewFromAggFile( tilFileName[id], dataBuffer );
+        if ( dataSize < headerSize ) {
+            // The important resource is absent! Make sure that you are using the correct version of the game.
+            assert( 0 );
+            return;
+        }
 
-            ROStreamBuf buffer( data );
+        ROStreamBuf buffer( data, dataSize );
 
-            const size_t count = buffer.getLE16();
-            const int32_t width = buffer.getLE16();
-            const int32_t height = buffer.getLE16();
-            if ( count < 1 || width < 1 || height < 1 || ( headerSize + count * width * height ) != data.size() ) {
-                return 0;
-            }
+        const size_t count = buffer.getLE16();
+        const int32_t width = buffer.getLE16();
+        const int32_t height = buffer.getLE16();
+        if ( count < 1 || width < 1 || height < 1 || ( headerSize + count * width * height ) != dataSize ) {
+            return;
+        }
 
-            std::vector<fheroes2::Image> & originalTIL = tilImages[0];
-            decodeTILImages( data.data() + headerSize, count, width, height, originalTIL );
+        std::vector<fheroes2::Image> & originalTIL = tilImages[0];
+        decodeTILImages( data + headerSize, count, width, height, originalTIL );
 
-            for ( uint32_t shapeId = 1; shapeId < 4; ++shapeId ) {
-                tilImages[shapeId].resize( count );
-            }
+        for ( uint32_t shapeId = 1; shapeId < 4; ++shapeId ) {
+            tilImages[shapeId].resize( count );
+        }
 
-            for ( size_t i = 0; i < count; ++i ) {
-                for ( uint32_t shapeId = 1; shapeId < 4; ++shapeId ) {
-                    fheroes2::Image & image = tilImages[shapeId][i];
+        for ( size_t i = 0; i < count; ++i ) {
+            for ( uint32_t shapeId = 1; shapeId < 4; ++shapeId ) {
+                fheroes2::Image & image = tilImages[shapeId][i];
 
-                    const bool horizontalFlip = ( shapeId & 2 ) != 0;
-                    const bool verticalFlip = ( shapeId & 1 ) != 0;
+                const bool horizontalFlip = ( shapeId & 2 ) != 0;
+                const bool verticalFlip = ( shapeId & 1 ) != 0;
 
-                    image._disableTransformLayer();
-                    image.resize( width, height );
+                image._disableTransformLayer();
+                image.resize( width, height );
 
-                    Flip( originalTIL[i], 0, 0, image, 0, 0, width, height, horizontalFlip, verticalFlip );
-                }
+                Flip( originalTIL[i], 0, 0, image, 0, 0, width, height, horizontalFlip, verticalFlip );
             }
         }
+    }
+
+    size_t GetMaximumTILIndex( const int id )
+    {
+        auto & tilImages = _tilVsImage[id];
+
+        // The TIL could have already been decoded in the background.
+        if ( tilImages.empty() && !takePreloadedTIL( id, tilImages ) ) {
+            decodeTilFromAgg( id, tilImages );
+        }
 
         return tilImages[0].size();
     }
@@ -5964,10 +6048,249 @@ namespace
 
         return resizedIcn;
     }
+
+    struct PreloadGroup
+    {
+        std::string name;
+        std::vector<int> icnIds;
+        std::vector<int> tilIds;
+    };
+
+    std::vector<PreloadGroup> getPreloadGroups( const std::vector<std::string> & resources )
+    {
+        const std::array<PreloadGroup, 4> predefinedGroups
+            = { PreloadGroup{ "adventure", { ICN::ADVBORD, ICN::ADVBTNS, ICN::ADVMCO, ICN::MINIHERO, ICN::RADAR }, { TIL::CLOF32, TIL::GROUND32, TIL::STON } },
+                PreloadGroup{ "castle",
+                              { ICN::CSTLBARB, ICN::CSTLKNGT, ICN::CSTLNECR, ICN::CSTLSORC, ICN::CSTLWRLK, ICN::CSTLWZRD, ICN::CSTLCAPB, ICN::CSTLCAPK,
+                                ICN::CSTLCAPN, ICN::CSTLCAPS, ICN::CSTLCAPW, ICN::CSTLCAPZ, ICN::BUYBUILD, ICN::STRIP },
+                              {} },
+                PreloadGroup{ "battle",
+                              { ICN::CBKGBEAC, ICN::CBKGCRCK, ICN::CBKGDIMT, ICN::CBKGDITR, ICN::CBKGDSRT, ICN::CBKGGRAV, ICN::CBKGGRMT, ICN::CBKGGRTR,
+                                ICN::CBKGLAVA, ICN::CBKGSNMT, ICN::CBKGSNTR, ICN::CBKGSWMP, ICN::CBKGWATR, ICN::CMBTMISC, ICN::CMBTSURR, ICN::CMSECO },
+                              {} },
+                PreloadGroup{ "dialogs",
+                              { ICN::REQUESTS, ICN::REQSBKG, ICN::SYSTEM, ICN::TEXTBACK, ICN::STONBACK, ICN::SPELLS, ICN::SPELCO, ICN::RESOURCE, ICN::VIEWARMY,
+                                ICN::HEROBKG, ICN::HSBKG, ICN::PORTXTRA },
+                              {} } };
+
+        std::vector<PreloadGroup> result;
+
+        // Resources that are specified by their file names are combined into a separate group.
+        PreloadGroup customGroup{ "custom", {}, {} };
+
+        for ( const std::string & resource : resources ) {
+            const auto groupIter = std::find_if( predefinedGroups.begin(), predefinedGroups.end(),
+                                                 [name = StringLower( resource )]( const PreloadGroup & group ) { return group.name == name; } );
+            if ( groupIter != predefinedGroups.end() ) {
+                result.push_back( *groupIter );
+                continue;
+            }
+
+            const std::string fileName = StringUpper( resource );
+
+            const auto tilIter = std::find( tilFileName.begin(), tilFileName.end(), fileName );
+            if ( tilIter != tilFileName.end() && tilIter != tilFileName.begin() ) {
+                customGroup.tilIds.push_back( static_cast<int>( tilIter - tilFileName.begin() ) );
+                continue;
+            }
+
+            bool isFound = false;
+
+            for ( int id = ICN::UNKNOWN + 1; id < ICN::LAST_VALID_FILE_ICN; ++id ) {
+                if ( fileName == ICN::getIcnFileName( id ) ) {
+                    customGroup.icnIds.push_back( id );
+                    isFound = true;
+                    break;
+                }
+            }
+
+            if ( !isFound ) {
+                ERROR_LOG( "Unknown resource to preload: " << resource )
+            }
+        }
+
+        if ( !customGroup.icnIds.empty() || !customGroup.tilIds.empty() ) {
+            result.emplace_back( std::move( customGroup ) );
+        }
+
+        // Only the ICNs which are read directly from AGG file can be decoded in the background. Raw BMP images are skipped because their
+        // conversion uses the lazily initialized palette lookup table which is not thread-safe.
+        for ( PreloadGroup & group : result ) {
+            group.icnIds.erase( std::remove_if( group.icnIds.begin(), group.icnIds.end(),
+                                                []( const int id ) {
+                                                    if ( id >= ICN::LAST_VALID_FILE_ICN || isLanguageDependentIcnId( id ) ) {
+                                                        return true;
+                                                    }
+
+                                                    const std::string_view icnFileName = ICN::getIcnFileName( id );
+                                                    return icnFileName.size() >= 4 && icnFileName.substr( icnFileName.size() - 4 ) == ".BMP";
+                                                } ),
+                                group.icnIds.end() );
+        }
+
+        return result;
+    }
+
+    // Decodes groups of resources in the background one by one, the resources of each group are decoded in parallel.
+    class ResourcePreloadManager final : public MultiThreading::AsyncManager
+    {
+    public:
+        void preload( std::vector<PreloadGroup> groups )
+        {
+            createWorker();
+
+            const std::scoped_lock<std::mutex> lock( _mutex );
+
+            _isStopRequested = false;
+
+            for ( PreloadGroup & group : groups ) {
+                _groups.emplace_back( std::move( group ) );
+            }
+
+            notifyWorker();
+        }
+
+        void stop()
+        {
+            {
+                const std::scoped_lock<std::mutex> lock( _mutex );
+
+                _groups.clear();
+            }
+
+            // Interrupt the decoding of the current group as well.
+            _isStopRequested = true;
+
+            stopWorker();
+
+            // Resources which have not been requested yet will be decoded by the main thread when they are needed.
+            const std::scoped_lock<std::mutex> lock( _preloadMutex );
+
+            _preloadedIcnVsSprite.clear();
+            _preloadedTilVsImage.clear();
+        }
+
+    private:
+        std::deque<PreloadGroup> _groups;
+        std::optional<PreloadGroup> _currentGroup;
+
+        std::atomic<bool> _isStopRequested{ false };
+
+        // This method is called by the worker thread and is protected by _mutex
+        bool prepareTask() override
+        {
+            if ( _groups.empty() ) {
+                _currentGroup.reset();
+
+                return false;
+            }
+
+            _currentGroup = std::move( _groups.front() );
+            _groups.pop_front();
+
+            return true;
+        }
+
+        // This method is called by the worker thread, but is not protected by _mutex
+        void executeTask() override
+        {
+            if ( !_currentGroup ) {
+                return;
+            }
+
+            const PreloadGroup & group = *_currentGroup;
+
+            const fheroes2::Time timer;
+
+            try {
+                decodeGroup( group );
+            }
+            catch ( const std::exception & ex ) {
+                // The main thread will try to decode these resources again and will handle the error properly.
+                ERROR_LOG( "Failed to preload the '" << group.name << "' resource group: " << ex.what() )
+                return;
+            }
+
+            VERBOSE_LOG( "Preloading of the '" << group.name << "' resource group (" << group.icnIds.size() << " ICN, " << group.tilIds.size() << " TIL) took "
+                                               << timer.getMs() << " ms." )
+        }
+
+        static bool isRequestedByMainThread( const std::set<int> & ids, const int id )
+        {
+            const std::scoped_lock<std::mutex> lock( _preloadMutex );
+
+            return ids.count( id ) > 0;
+        }
+
+        void decodeGroup( const PreloadGroup & group )
+        {
+            MultiThreading::parallelFor( group.icnIds.size() + group.tilIds.size(), [this, &group]( const size_t idx ) {
+                if ( _isStopRequested ) {
+                    return;
+                }
+
+                if ( idx < group.icnIds.size() ) {
+                    const int id = group.icnIds[idx];
+                    if ( isRequestedByMainThread( _mainThreadIcnIds, id ) ) {
+                        return;
+                    }
+
+                    std::vector<fheroes2::Sprite> sprites;
+                    const bool isFound = decodeIcnFromAgg( id, sprites );
+
+                    const std::scoped_lock<std::mutex> lock( _preloadMutex );
+
+                    // The main thread could have decoded this ICN by itself while it was being decoded here.
+                    if ( _mainThreadIcnIds.count( id ) == 0 ) {
+                        _preloadedIcnVsSprite.try_emplace( id, isFound, std::move( sprites ) );
+                    }
+
+                    return;
+                }
+
+                const int id = group.tilIds[idx - group.icnIds.size()];
+                if ( isRequestedByMainThread( _mainThreadTilIds, id ) ) {
+                    return;
+                }
+
+                std::vector<std::vector<fheroes2::Image>> images;
+                decodeTilFromAgg( id, images );
+
+                const std::scoped_lock<std::mutex> lock( _preloadMutex );
+
+                // The main thread could have decoded this TIL by itself while it was being decoded here.
+                if ( _mainThreadTilIds.count( id ) == 0 ) {
+                    _preloadedTilVsImage.try_emplace( id, std::move( images ) );
+                }
+            } );
+        }
+    };
+
+    ResourcePreloadManager resourcePreloadManager;
 }
 
 namespace fheroes2::AGG
 {
+    ResourcePreloader::ResourcePreloader( const std::vector<std::string> & resources )
+    {
+#if !defined( __EMSCRIPTEN__ ) || defined( __EMSCRIPTEN_PTHREADS__ )
+        std::vector<PreloadGroup> groups = getPreloadGroups( resources );
+        if ( groups.empty() ) {
+            return;
+        }
+
+        resourcePreloadManager.preload( std::move( groups ) );
+#else
+        // Without threads all resources would be decoded right here, which makes no sense.
+        (void)resources;
+#endif
+    }
+
+    ResourcePreloader::~ResourcePreloader()
+    {
+        resourcePreloadManager.stop();
+    }
+
     const Sprite & GetICN( int icnId, uint32_t index )
     {
         if ( !IsValidICNId( icnId ) ) {
@@ -21,6 +21,8 @@
 #pragma once
 
 #include <cstdint>
+#include <string>
+#include <vector>
 
 namespace fheroes2
 {
@@ -39,5 +41,18 @@ namespace fheroes2
 
         // This function must be called only at the time of setting up a new language.
         void updateLanguageDependentResources( const SupportedLanguage language, const bool loadOriginalAlphabet );
+
+        // Decodes the given resources in the background while this object exists. Every item is either the name of a predefined group of
+        // resources ("adventure", "battle", "castle" or "dialogs") or the name of an ICN or TIL file. Decoded resources are taken by GetICN()
+        // and GetTIL() when they are requested for the first time. The time spent on each group is written to the log.
+        class ResourcePreloader
+        {
+        public:
+            explicit ResourcePreloader( const std::vector<std::string> & resources );
+            ResourcePreloader( const ResourcePreloader & ) = delete;
+            ResourcePreloader & operator=( const ResourcePreloader & ) = delete;
+
+            ~ResourcePreloader();
+        };
     }
 }
@@ -24,6 +24,7 @@
 #include <cstdlib>
 #include <initializer_list>
 #include <map>
+#include <mutex>
 #include <ostream>
 #include <string>
 #include <utility>
@@ -53,6 +54,9 @@ namespace
     public:
         Bin_Info::MonsterAnimInfo getAnimInfo( const int monsterID )
         {
+            // Battle units can be created in parallel threads (e.g. by the battle simulator).
+            const std::scoped_lock<std::mutex> lock( _mutex );
+
             auto mapIterator = _animMap.find( monsterID );
             if ( mapIterator != _animMap.end() ) {
                 return mapIterator->second;
@@ -70,6 +74,7 @@ namespace
 
     private:
         std::map<int, Bin_Info::MonsterAnimInfo> _animMap;
+        std::mutex _mutex;
     };
 
     MonsterAnimCache _infoCache;
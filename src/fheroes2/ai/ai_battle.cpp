@@ -604,7 +604,7 @@ namespace
 
 AI::BattlePlanner & AI::BattlePlanner::Get()
 {
-    static BattlePlanner ai;
+    thread_local BattlePlanner ai;
     return ai;
 }
 
@@ -710,7 +710,7 @@ Battle::Actions AI::BattlePlanner::planUnitTurn( Battle::Arena & arena, const Ba
         };
 
         const Outcome outcome = [this, &arena, actualHero]() {
-            if ( !_considerRetreat ) {
+            if ( !_considerRetreat || !_isRetreatAndSurrenderAllowed ) {
                 return Outcome::ContinueBattle;
             }
 
@@ -73,11 +73,25 @@ namespace AI
     class BattlePlanner
     {
     public:
+        // Every thread has its own instance of the battle planner, so battles can be played in parallel threads.
         static BattlePlanner & Get();
 
         // Should be called at the beginning of the battle
         void battleBegins();
 
+        // Allows or forbids AI-controlled heroes to retreat or surrender at their own discretion. This decision depends on the state
+        // of the hero's kingdom, so it should be forbidden when battles are played outside of the adventure map (e.g. in the battle
+        // simulator). The retreat caused by the limit of turns without deaths is not affected by this setting.
+        void setRetreatAndSurrenderAllowed( const bool allow )
+        {
+            _isRetreatAndSurrenderAllowed = allow;
+        }
+
+        bool isRetreatAndSurrenderAllowed() const
+        {
+            return _isRetreatAndSurrenderAllowed;
+        }
+
         void BattleTurn( Battle::Arena & arena, const Battle::Unit & currentUnit, Battle::Actions & actions );
 
     private:
@@ -145,6 +159,7 @@ namespace AI
         bool _attackingCastle{ false };
         bool _defendingCastle{ false };
         bool _considerRetreat{ false };
+        bool _isRetreatAndSurrenderAllowed{ true };
         bool _defensiveTactics{ false };
         bool _cautiousOffensive{ false };
         bool _avoidStackingUnits{ false };
@@ -0,0 +1,381 @@
+/***************************************************************************
+ *   fheroes2: https://github.com/ihhub/fheroes2                           *
+ *   Copyright (C) 2026                                                    *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
+ ***************************************************************************/
+
+#include "ai_battle_outcome.h"
+
+#include <algorithm>
+#include <cassert>
+#include <functional>
+#include <memory>
+#include <ostream>
+#include <utility>
+
+#include "ai_battle.h"
+#include "army.h"
+#include "army_troop.h"
+#include "artifact.h"
+#include "battle.h"
+#include "battle_arena.h"
+#include "battle_army.h"
+#include "battle_troop.h"
+#include "castle.h"
+#include "color.h"
+#include "heroes.h"
+#include "logging.h"
+#include "rand.h"
+#include "settings.h"
+#include "skill.h"
+#include "spell.h"
+#include "thread.h"
+#include "timing.h"
+#include "tools.h"
+
+namespace
+{
+    // The number of battles played for each estimate. Battles with the same seed have the same outcome, so every battle gets its own seed.
+    const size_t battlesPerEstimate{ 8 };
+
+    // Estimates are small, but each of them describes a unique matchup, so the cache grows during the game.
+    const size_t maxCacheSize{ 4096 };
+
+    // One side of the simulated battle. It owns a copy of the hero or a copy of the army without a commander.
+    class BattleSide
+    {
+    public:
+        explicit BattleSide( const Heroes & hero )
+            : _hero( hero.createBattleSimulationCopy() )
+        {}
+
+        BattleSide( const Army & army, const PlayerColor color )
+            : _army( std::make_unique<Army>() )
+        {
+            _army->Assign( army );
+            _army->SetColor( color );
+            _army->SetSpreadFormation( army.isSpreadFormation() );
+        }
+
+        const Heroes * getHero() const
+        {
+            return _hero.get();
+        }
+
+        Army & getArmy()
+        {
+            return _hero ? _hero->GetArmy() : *_army;
+        }
+
+    private:
+        std::unique_ptr<Heroes> _hero;
+        std::unique_ptr<Army> _army;
+    };
+
+    // Both sides of the battle, created from scratch for every simulated battle because the battle changes them.
+    using BattleSides = std::pair<BattleSide, BattleSide>;
+
+    struct BattleResult
+    {
+        bool isAttackerWin{ false };
+        double attackerLosses{ 0 };
+        double defenderLosses{ 0 };
+    };
+
+    void appendArmyToKey( const Army & army, std::vector<int32_t> & key )
+    {
+        key.push_back( army.isSpreadFormation() ? 1 : 0 );
+
+        for ( size_t idx = 0; idx < army.Size(); ++idx ) {
+            const Troop * troop = army.GetTroop( idx );
+            assert( troop != nullptr );
+
+            if ( troop->isValid() ) {
+                key.push_back( troop->GetID() );
+                key.push_back( static_cast<int32_t>( troop->GetCount() ) );
+            }
+            else {
+                key.push_back( Monster::UNKNOWN );
+                key.push_back( 0 );
+            }
+        }
+    }
+
+    void appendHeroToKey( const Heroes * hero, std::vector<int32_t> & key )
+    {
+        if ( hero == nullptr ) {
+            key.push_back( 0 );
+            return;
+        }
+
+        key.insert( key.end(), { 1, hero->GetAttack(), hero->GetDefense(), hero->GetPower(), hero->GetKnowledge(), static_cast<int32_t>( hero->GetSpellPoints() ),
+                                 hero->GetMorale(), hero->GetLuck() } );
+
+        for ( int32_t skill = Skill::Secondary::PATHFINDING; skill <= Skill::Secondary::ESTATES; ++skill ) {
+            key.push_back( hero->GetLevelSkill( skill ) );
+        }
+
+        // The order in which the hero got his artifacts and spells does not affect the battle.
+        std::vector<std::pair<int32_t, int32_t>> artifacts;
+
+        for ( const Artifact & artifact : hero->GetBagArtifacts() ) {
+            if ( artifact.isValid() ) {
+                artifacts.emplace_back( artifact.GetID(), artifact.getSpellId() );
+            }
+        }
+
+        std::sort( artifacts.begin(), artifacts.end() );
+
+        key.push_back( static_cast<int32_t>( artifacts.size() ) );
+
+        for ( const auto & [artifactId, spellId] : artifacts ) {
+            key.push_back( artifactId );
+            key.push_back( spellId );
+        }
+
+        std::vector<int32_t> spells;
+
+        for ( const Spell & spell : hero->getMagicBookSpells() ) {
+            spells.push_back( spell.GetID() );
+        }
+
+        std::sort( spells.begin(), spells.end() );
+
+        key.push_back( static_cast<int32_t>( spells.size() ) );
+        key.insert( key.end(), spells.begin(), spells.end() );
+    }
+
+    void appendCastleToKey( const Castle * castle, std::vector<int32_t> & key )
+    {
+        // Towns are not fortified, the battle takes place as in the open field.
+        if ( castle == nullptr || !castle->isCastle() ) {
+            key.push_back( 0 );
+            return;
+        }
+
+        key.insert( key.end(), { 1, castle->isBuild( BUILD_MOAT ) ? 1 : 0, castle->isBuild( BUILD_LEFTTURRET ) ? 1 : 0, castle->isBuild( BUILD_RIGHTTURRET ) ? 1 : 0,
+                                 castle->isFortificationBuilt() ? 1 : 0, static_cast<int32_t>( castle->CountBuildings() ), castle->GetLevelMageGuild() } );
+    }
+
+    std::vector<int32_t> getKey( BattleSides & sides, const Castle * castle )
+    {
+        std::vector<int32_t> key;
+        key.reserve( 128 );
+
+        appendHeroToKey( sides.first.getHero(), key );
+        appendArmyToKey( sides.first.getArmy(), key );
+        appendHeroToKey( sides.second.getHero(), key );
+        appendArmyToKey( sides.second.getArmy(), key );
+        appendCastleToKey( castle, key );
+
+        return key;
+    }
+
+    double getLosses( const Battle::Force & force )
+    {
+        double initialStrength = 0;
+        double lostStrength = 0;
+
+        for ( const Battle::Unit * unit : force ) {
+            assert( unit != nullptr );
+
+            // Summoned elementals and mirror images are not a part of the original army.
+            if ( unit->Modes( Battle::CAP_SUMMONELEM | Battle::CAP_MIRRORIMAGE ) ) {
+                continue;
+            }
+
+            const double strength = unit->GetMonsterStrength();
+
+            initialStrength += strength * unit->GetInitialCount();
+            lostStrength += strength * std::min( unit->GetDead(), unit->GetInitialCount() );
+        }
+
+        return initialStrength > 0 ? lostStrength / initialStrength : 0;
+    }
+
+    // Creates copies of both sides of the battle. If the castle is given, then its guest hero (if any) and its garrison are the defenders.
+    BattleSides createSides( const Heroes & attacker, const Heroes * defender, const Castle * castle )
+    {
+        if ( castle == nullptr ) {
+            assert( defender != nullptr );
+
+            return { BattleSide( attacker ), BattleSide( *defender ) };
+        }
+
+        const Heroes * guest = castle->GetHero();
+        if ( guest == nullptr ) {
+            // The castle captain is not copied, so the garrison fights without a commander.
+            return { BattleSide( attacker ), BattleSide( castle->GetArmy(), castle->GetColor() ) };
+        }
+
+        BattleSides sides{ BattleSide( attacker ), BattleSide( *guest ) };
+
+        // Some of the garrison troops join the guest hero's army before the siege, just like it happens in the real battle.
+        Army garrison;
+        garrison.Assign( castle->GetArmy() );
+
+        sides.second.getArmy().ArrangeForCastleDefense( garrison );
+
+        return sides;
+    }
+
+    // Plays one battle on the given tile. Only the world is shared between threads and it is not modified here.
+    BattleResult playBattle( BattleSides & sides, const int32_t tileIndex, const uint32_t seed )
+    {
+        // Whether AI decides to retreat or surrender depends on the state of the kingdom, and a surrender changes the funds of both
+        // kingdoms. The battle planner of the calling thread is also used for real battles, so its setting has to be restored.
+        AI::BattlePlanner & battlePlanner = AI::BattlePlanner::Get();
+
+        const bool isRetreatAndSurrenderAllowed = battlePlanner.isRetreatAndSurrenderAllowed();
+        battlePlanner.setRetreatAndSurrenderAllowed( false );
+
+        BattleResult result;
+
+        {
+            Rand::PCG32 randomGenerator( seed );
+            Battle::Arena arena( sides.first.getArmy(), sides.second.getArmy(), tileIndex, false, randomGenerator );
+
+            while ( arena.BattleValid() ) {
+                arena.Turns();
+            }
+
+            result.isAttackerWin = arena.GetResult().isAttackerWin();
+            result.attackerLosses = getLosses( arena.getAttackingForce() );
+            result.defenderLosses = getLosses( arena.getDefendingForce() );
+        }
+
+        battlePlanner.setRetreatAndSurrenderAllowed( isRetreatAndSurrenderAllowed );
+
+        return result;
+    }
+}
+
+size_t AI::BattleOutcomeEstimator::KeyHash::operator()( const std::vector<int32_t> & key ) const
+{
+    return fheroes2::calculateCRC32( reinterpret_cast<const uint8_t *>( key.data() ), key.size() * sizeof( int32_t ) );
+}
+
+void AI::BattleOutcomeEstimator::resetTimeBudget()
+{
+    _spentTimeMs = 0;
+}
+
+std::optional<AI::BattleOutcomeEstimate> AI::BattleOutcomeEstimator::estimate( const Heroes & attacker, const Heroes & defender )
+{
+    return _estimate( attacker, &defender, nullptr, defender.GetIndex() );
+}
+
+std::optional<AI::BattleOutcomeEstimate> AI::BattleOutcomeEstimator::estimate( const Heroes & attacker, const Castle & castle )
+{
+    return _estimate( attacker, nullptr, &castle, castle.GetIndex() );
+}
+
+std::optional<AI::BattleOutcomeEstimate> AI::BattleOutcomeEstimator::_estimate( const Heroes & attacker, const Heroes * defender, const Castle * castle,
+                                                                                   const int32_t tileIndex )
+{
+    const uint64_t timeLimitMs = static_cast<uint64_t>( Settings::Get().aiBattleSimulationTime() );
+    if ( timeLimitMs == 0 ) {
+        // Simulations are disabled, so there are no cached estimates either. Do not even make copies of both sides.
+        return {};
+    }
+
+    std::vector<BattleSides> battles;
+    battles.reserve( battlesPerEstimate );
+
+    battles.emplace_back( createSides( attacker, defender, castle ) );
+
+    std::vector<int32_t> key = getKey( battles.front(), castle );
+
+    if ( const auto iter = _cache.find( key ); iter != _cache.end() ) {
+        return iter->second;
+    }
+
+    if ( _spentTimeMs >= timeLimitMs ) {
+        return {};
+    }
+
+    if ( !battles.front().first.getArmy().isValid() || !battles.front().second.getArmy().isValid() ) {
+        return {};
+    }
+
+    const fheroes2::Time timer;
+
+    // The same matchup is always simulated with the same seeds, so the estimate does not depend on the state of random generators.
+    const uint32_t seed = static_cast<uint32_t>( KeyHash()( key ) );
+
+    // Battles are played in rounds of one battle per thread, and the time limit is checked between rounds. If the time is over,
+    // the estimate is based on the battles played so far.
+    const size_t battlesPerRound = std::max<size_t>( MultiThreading::getParallelThreadCount(), 1 );
+
+    std::vector<BattleResult> results;
+    results.reserve( battlesPerEstimate );
+
+    while ( results.size() < battlesPerEstimate ) {
+        const size_t firstBattleIdx = results.size();
+        const size_t roundSize = std::min( battlesPerRound, battlesPerEstimate - firstBattleIdx );
+
+        // Copies are made in the calling thread because the original heroes and castles must not be accessed while battles are in progress.
+        while ( battles.size() < roundSize ) {
+            battles.emplace_back( createSides( attacker, defender, castle ) );
+        }
+
+        results.resize( firstBattleIdx + roundSize );
+
+        MultiThreading::parallelFor( roundSize, [&battles, &results, tileIndex, seed, firstBattleIdx]( const size_t idx ) {
+            const size_t battleIdx = firstBattleIdx + idx;
+            results[battleIdx] = playBattle( battles[idx], tileIndex, seed + static_cast<uint32_t>( battleIdx ) );
+        } );
+
+        // Both sides have been changed by the battles.
+        battles.clear();
+
+        if ( _spentTimeMs + timer.getMs() >= timeLimitMs ) {
+            break;
+        }
+    }
+
+    BattleOutcomeEstimate estimate;
+
+    for ( const BattleResult & result : results ) {
+        if ( result.isAttackerWin ) {
+            estimate.attackerWinRate += 1;
+        }
+
+        estimate.attackerLosses += result.attackerLosses;
+        estimate.defenderLosses += result.defenderLosses;
+    }
+
+    estimate.attackerWinRate /= static_cast<double>( results.size() );
+    estimate.attackerLosses /= static_cast<double>( results.size() );
+    estimate.defenderLosses /= static_cast<double>( results.size() );
+
+    const uint64_t timeMs = timer.getMs();
+    _spentTimeMs += timeMs;
+
+    DEBUG_LOG( DBG_AI, DBG_INFO,
+               attacker.GetName() << " against " << ( castle ? castle->GetName() : defender->GetName() ) << ": win rate " << estimate.attackerWinRate
+                                  << ", losses " << estimate.attackerLosses << " / " << estimate.defenderLosses << ", " << results.size() << " battles simulated in "
+                                  << timeMs << " ms" )
+
+    if ( _cache.size() >= maxCacheSize ) {
+        _cache.clear();
+    }
+
+    _cache.try_emplace( std::move( key ), estimate );
+
+    return estimate;
+}
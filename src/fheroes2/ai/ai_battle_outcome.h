@@ -0,0 +1,86 @@
+/***************************************************************************
+ *   fheroes2: https://github.com/ihhub/fheroes2                           *
+ *   Copyright (C) 2026                                                    *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
+ ***************************************************************************/
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <unordered_map>
+#include <vector>
+
+class Castle;
+class Heroes;
+
+namespace AI
+{
+    struct BattleOutcomeEstimate
+    {
+        // Share of the simulated battles won by the attacker: 0 - none, 1 - all.
+        double attackerWinRate{ 0 };
+
+        // Expected share of the army strength lost during the battle: 0 - no losses, 1 - the whole army.
+        double attackerLosses{ 0 };
+        double defenderLosses{ 0 };
+    };
+
+    // Estimates battle outcomes by playing several battles between copies of the real armies on worker threads without any rendering.
+    // Estimates are memoized by the canonical description of both sides (troops, hero stats, skills, artifacts and spells, castle
+    // fortifications), so the same matchup is simulated only once. Simulations are expensive, so the time spent on them during one
+    // AI turn is limited by the "ai battle simulation time" setting. This limit is soft: it is checked between rounds of battles
+    // (one battle per thread), so it can be exceeded by the duration of one round. Cached estimates are available even after the time
+    // is over. Nothing is simulated or cached if this setting is 0.
+    class BattleOutcomeEstimator
+    {
+    public:
+        BattleOutcomeEstimator() = default;
+        BattleOutcomeEstimator( const BattleOutcomeEstimator & ) = delete;
+
+        ~BattleOutcomeEstimator() = default;
+
+        BattleOutcomeEstimator & operator=( const BattleOutcomeEstimator & ) = delete;
+
+        // Should be called at the beginning of each AI kingdom's turn.
+        void resetTimeBudget();
+
+        // Returns the estimated outcome of the attack of the given hero against the enemy hero in the open field, or an empty value if
+        // there is no cached estimate and there is no time left for simulations.
+        std::optional<BattleOutcomeEstimate> estimate( const Heroes & attacker, const Heroes & defender );
+
+        // Returns the estimated outcome of the siege of the given castle by the given hero, or an empty value if there is no cached
+        // estimate and there is no time left for simulations.
+        std::optional<BattleOutcomeEstimate> estimate( const Heroes & attacker, const Castle & castle );
+
+    private:
+        // The battle takes place on the given tile. If the castle is given, then it is a siege and the defender is ignored.
+        std::optional<BattleOutcomeEstimate> _estimate( const Heroes & attacker, const Heroes * defender, const Castle * castle, const int32_t tileIndex );
+
+        struct KeyHash
+        {
+            size_t operator()( const std::vector<int32_t> & key ) const;
+        };
+
+        // Estimates are valid as long as the description of the sides does not change, so they are kept between turns. The cache is
+        // cleared when it gets too large.
+        std::unordered_map<std::vector<int32_t>, BattleOutcomeEstimate, KeyHash> _cache;
+
+        uint64_t _spentTimeMs{ 0 };
+    };
+}
@@ -1902,6 +1902,8 @@ namespace
                 }
             }
 
+            bag.updateEffectTable();
+
             DEBUG_LOG( DBG_AI, DBG_INFO, hero.GetName() << " removed " << cursed << " artifacts" )
         }
     }
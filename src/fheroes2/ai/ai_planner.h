@@ -23,11 +23,13 @@
 #include <array>
 #include <cassert>
 #include <cstdint>
+#include <optional>
 #include <set>
 #include <unordered_map>
 #include <utility>
 #include <vector>
 
+#include "ai_battle_outcome.h"
 #include "resource.h"
 #include "world_pathfinding.h"
 
@@ -139,6 +141,15 @@ namespace AI
         uint32_t movePoints{ 0 };
     };
 
+    struct EnemyHeroDistances
+    {
+        // State of the enemy army for which the distances were calculated.
+        EnemyArmy enemyArmy;
+
+        // Distances from the enemy hero to every tile of the map.
+        std::vector<uint32_t> distances;
+    };
+
     struct PriorityTask
     {
         PriorityTask() = default;
@@ -192,6 +203,19 @@ namespace AI
         // Army::setFromTile(), so this method is not suitable for hero armies or castle garrisons.
         double getTileArmyStrength( const Maps::Tile & tile );
 
+        // Returns the estimated outcome of the attack of the given hero against the enemy hero or the castle. Battles are simulated,
+        // so these methods should be used only when the comparison of army strengths gives no clear answer. An empty value is returned
+        // if there is no time left for simulations during the current turn.
+        std::optional<BattleOutcomeEstimate> estimateBattleOutcome( const Heroes & hero, const Heroes & enemyHero )
+        {
+            return _battleOutcomeEstimator.estimate( hero, enemyHero );
+        }
+
+        std::optional<BattleOutcomeEstimate> estimateBattleOutcome( const Heroes & hero, const Castle & castle )
+        {
+            return _battleOutcomeEstimator.estimate( hero, castle );
+        }
+
         static void HeroesPreBattle( HeroBase & hero, bool isAttacking );
         static void CastlePreBattle( Castle & castle );
 
@@ -268,6 +292,11 @@ namespace AI
         std::unordered_map<int32_t, PriorityTask> _priorityTargets;
         std::unordered_map<int32_t, EnemyArmy> _enemyArmies;
 
+        // Calculation of distances for enemy heroes is a heavy operation and its result is the same for all heroes of the
+        // kingdom while the enemy hero remains in place, so it is cached during the same turn. The cache entry is used only
+        // if the state of the enemy army has not changed since the distances were calculated.
+        std::unordered_map<int32_t, EnemyHeroDistances> _enemyHeroDistances;
+
         // Strength of the armies guarding the tiles (neutral monsters, guardians of dwellings, and so on) is constant for AI
         // during the same turn, but its calculation is a heavy operation, so it needs to be cached to speed up estimations.
         // It is important to update this cache after performing an action on the corresponding tile.
@@ -278,5 +307,10 @@ namespace AI
         std::array<BudgetEntry, 7> _budget = { Resource::WOOD, Resource::MERCURY, Resource::ORE, Resource::SULFUR, Resource::CRYSTAL, Resource::GEMS, Resource::GOLD };
 
         AIWorldPathfinder _pathfinder;
+
+        // Evaluations of the map for non-hero armies, they are immutable and can be used by several threads at once
+        AIWorldPathfinderSnapshotCache _pathfinderSnapshots{ 32 };
+
+        BattleOutcomeEstimator _battleOutcomeEstimator;
     };
 }
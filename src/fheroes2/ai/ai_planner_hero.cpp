@@ -74,6 +74,8 @@
 #include "settings.h"
 #include "skill.h"
 #include "spell.h"
+#include "thread.h"
+#include "timing.h"
 #include "visit.h"
 #include "world.h"
 #include "world_pathfinding.h"
@@ -229,7 +231,25 @@ namespace
         return { regularMovementDist, false };
     }
 
-    bool AIShouldVisitCastle( const Heroes & hero, int castleIndex, const double heroArmyStrength )
+    // Army strengths are only a rough estimate of the battle outcome, so the decision to attack is made by simulating the battle
+    // if the strength ratio is close to the required advantage.
+    bool isCloseCall( const double armyStrength, const double enemyStrength, const double advantage )
+    {
+        const double margin = 1.25;
+
+        return armyStrength > enemyStrength * advantage / margin && armyStrength < enemyStrength * advantage * margin;
+    }
+
+    bool isAttackWorthwhile( const AI::BattleOutcomeEstimate & estimate, const bool isLosingGame )
+    {
+        if ( isLosingGame ) {
+            return estimate.attackerWinRate >= 0.5;
+        }
+
+        return estimate.attackerWinRate >= 0.8 && estimate.attackerLosses <= 0.5;
+    }
+
+    bool AIShouldVisitCastle( const Heroes & hero, int castleIndex, const double heroArmyStrength, AI::Planner & ai )
     {
         const Castle * castle = world.getCastleEntrance( Maps::GetPoint( castleIndex ) );
         if ( castle == nullptr ) {
@@ -253,9 +273,15 @@ namespace
         }
 
         const double advantage = hero.isLosingGame() ? AI::ARMY_ADVANTAGE_DESPERATE : AI::ARMY_ADVANTAGE_MEDIUM;
-        const double castleStrength = castle->GetGarrisonStrength( hero ) * advantage;
+        const double castleStrength = castle->GetGarrisonStrength( hero );
+
+        if ( isCloseCall( heroArmyStrength, castleStrength, advantage ) ) {
+            if ( const auto estimate = ai.estimateBattleOutcome( hero, *castle ); estimate ) {
+                return isAttackWorthwhile( *estimate, hero.isLosingGame() );
+            }
+        }
 
-        return heroArmyStrength > castleStrength;
+        return heroArmyStrength > castleStrength * advantage;
     }
 
     bool isHeroStrongerThan( const Maps::Tile & tile, AI::Planner & ai, const double heroArmyStrength, const double targetStrengthMultiplier )
@@ -716,14 +742,23 @@ namespace
             }
 
             if ( otherHeroInCastle ) {
-                return AIShouldVisitCastle( hero, index, heroArmyStrength );
+                return AIShouldVisitCastle( hero, index, heroArmyStrength, ai );
+            }
+
+            const Army & otherArmy = otherHero->GetArmy();
+            const double advantage = hero.isLosingGame() ? AI::ARMY_ADVANTAGE_DESPERATE : AI::ARMY_ADVANTAGE_SMALL;
+
+            if ( otherArmy.isValid() && isCloseCall( heroArmyStrength, otherArmy.GetStrength(), advantage ) ) {
+                if ( const auto estimate = ai.estimateBattleOutcome( hero, *otherHero ); estimate ) {
+                    return isAttackWorthwhile( *estimate, hero.isLosingGame() );
+                }
             }
 
-            return army.isStrongerThan( otherHero->GetArmy(), hero.isLosingGame() ? AI::ARMY_ADVANTAGE_DESPERATE : AI::ARMY_ADVANTAGE_SMALL );
+            return army.isStrongerThan( otherArmy, advantage );
         }
 
         case MP2::OBJ_CASTLE:
-            return AIShouldVisitCastle( hero, index, heroArmyStrength );
+            return AIShouldVisitCastle( hero, index, heroArmyStrength, ai );
 
         case MP2::OBJ_JAIL:
             return kingdom.GetHeroes().size() < Kingdom::GetMaxHeroes();
@@ -907,12 +942,45 @@ namespace
             return iter->second;
         }
 
+        // Defers the evaluation of the object until calculateRequestedValues() is called. As with value(), only the distance
+        // of the first request is taken into account, so the results are the same as if value() was called in the same order.
+        void requestValue( const IndexObject & objectInfo, const uint32_t distance )
+        {
+            if ( const auto [dummy, inserted] = _objectValue.try_emplace( objectInfo, 0.0 ); inserted ) {
+                _requestedValues.emplace_back( objectInfo, distance );
+            }
+        }
+
+        // Evaluates all requested objects in parallel. Future values are not evaluated this way since their evaluation
+        // temporarily modifies the map tiles.
+        void calculateRequestedValues()
+        {
+            if ( _requestedValues.empty() ) {
+                return;
+            }
+
+            std::vector<double> values( _requestedValues.size() );
+
+            MultiThreading::parallelFor( _requestedValues.size(), [this, &values]( const size_t idx ) {
+                const auto & [objectInfo, distance] = _requestedValues[idx];
+
+                values[idx] = _ai.getObjectValue( _hero, objectInfo.first, objectInfo.second, _ignoreValue, distance );
+            } );
+
+            for ( size_t idx = 0; idx < _requestedValues.size(); ++idx ) {
+                _objectValue[_requestedValues[idx].first] = values[idx];
+            }
+
+            _requestedValues.clear();
+        }
+
     private:
         const Heroes & _hero;
         const AI::Planner & _ai;
         const double _ignoreValue;
         std::map<IndexObject, double> _objectValue;
         std::map<IndexObject, double> _futureObjectValue;
+        std::vector<std::pair<IndexObject, uint32_t>> _requestedValues;
     };
 
     double getMonsterUpgradeValue( const Army & army, const int monsterId )
@@ -1119,6 +1187,11 @@ namespace
 
         return 30;
     }
+
+    bool isSameEnemyArmy( const AI::EnemyArmy & first, const AI::EnemyArmy & second )
+    {
+        return std::tie( first.index, first.hero, first.strength, first.movePoints ) == std::tie( second.index, second.hero, second.strength, second.movePoints );
+    }
 }
 
 // TODO: In the future we need to come up with dynamic object value estimation based not only on a hero's role but on an outcome from movement at certain position.
@@ -2398,13 +2471,14 @@ int AI::Planner::getPriorityTarget( Heroes & hero, double & maxPriority )
 
     // Pre-calculate penalties for tiles where there is a threat of enemy attack
     const std::vector<double> enemyThreatPenalties = [this, &hero = std::as_const( hero )]() {
-        std::vector<double> result( world.getSize(), 0.0 );
-
-        const AIWorldPathfinderStateRestorer pathfinderStateRestorer( _pathfinder );
+        struct EnemyThreat
+        {
+            const EnemyArmy & enemyArmy;
+            const uint32_t enemyArmyMovePointsThreshold;
+            const bool useRoughEstimate;
+        };
 
-        // Use the "optimistic" pathfinder settings for enemy heroes - minimal army advantage, minimal reserve of spell points
-        _pathfinder.setMinimalArmyStrengthAdvantage( ARMY_ADVANTAGE_DESPERATE );
-        _pathfinder.setSpellPointsReserveRatio( 0.0 );
+        std::vector<EnemyThreat> threats;
 
         const double heroStrength = hero.GetArmy().GetStrength();
 
@@ -2432,22 +2506,79 @@ int AI::Planner::getPriorityTarget( Heroes & hero, double & maxPriority )
             const bool useRoughEstimate = ( Maps::GetApproximateDistance( hero.GetIndex(), enemyArmy.index ) * Maps::Ground::fastestMovePenalty
                                             > hero.GetMovePoints() + enemyArmyMovePointsThreshold );
 
-            if ( !useRoughEstimate ) {
-                // Pre-cache the pathfinder database for the enemy hero
-                _pathfinder.reEvaluateIfNeeded( *enemyArmy.hero );
+            threats.push_back( { enemyArmy, enemyArmyMovePointsThreshold, useRoughEstimate } );
+        }
+
+        // Find out which enemy heroes still need to have their distances calculated
+        std::vector<const EnemyArmy *> enemyArmiesToEvaluate;
+
+        for ( const EnemyThreat & threat : threats ) {
+            if ( threat.useRoughEstimate ) {
+                continue;
+            }
+
+            const auto iter = _enemyHeroDistances.find( threat.enemyArmy.index );
+            if ( iter != _enemyHeroDistances.end() && isSameEnemyArmy( iter->second.enemyArmy, threat.enemyArmy ) ) {
+                continue;
+            }
+
+            enemyArmiesToEvaluate.push_back( &threat.enemyArmy );
+        }
+
+        // Enemy heroes are evaluated in parallel, every thread uses its own pathfinder instance. Instances are kept between calls so
+        // that their passability grids are only updated with the world changes instead of being built from scratch every time. The
+        // instance is reset anyway because the world might have changed since the last evaluation.
+        std::vector<std::vector<uint32_t>> evaluatedDistances( enemyArmiesToEvaluate.size() );
+
+        MultiThreading::parallelFor( enemyArmiesToEvaluate.size(), [&enemyArmiesToEvaluate, &evaluatedDistances]( const size_t idx ) {
+            thread_local AIWorldPathfinder pathfinder;
+            pathfinder.reset();
+
+            // Use the "optimistic" pathfinder settings for enemy heroes - minimal army advantage, minimal reserve of spell points
+            pathfinder.setMinimalArmyStrengthAdvantage( ARMY_ADVANTAGE_DESPERATE );
+            pathfinder.setSpellPointsReserveRatio( 0.0 );
+
+            pathfinder.reEvaluateIfNeeded( *enemyArmiesToEvaluate[idx]->hero );
+
+            std::vector<uint32_t> & distances = evaluatedDistances[idx];
+            distances.resize( world.getSize() );
+
+            for ( size_t i = 0; i < distances.size(); ++i ) {
+                distances[i] = pathfinder.getDistance( static_cast<int32_t>( i ) );
+            }
+        } );
+
+        for ( size_t idx = 0; idx < enemyArmiesToEvaluate.size(); ++idx ) {
+            const EnemyArmy & enemyArmy = *enemyArmiesToEvaluate[idx];
+
+            _enemyHeroDistances[enemyArmy.index] = { enemyArmy, std::move( evaluatedDistances[idx] ) };
+        }
+
+        std::vector<double> result( world.getSize(), 0.0 );
+
+        for ( const EnemyThreat & threat : threats ) {
+            const int32_t enemyArmyIdx = threat.enemyArmy.index;
+            const uint32_t enemyArmyMovePointsThreshold = threat.enemyArmyMovePointsThreshold;
+
+            const std::vector<uint32_t> * distances = nullptr;
+            if ( !threat.useRoughEstimate ) {
+                const auto iter = _enemyHeroDistances.find( enemyArmyIdx );
+                assert( iter != _enemyHeroDistances.end() && iter->second.distances.size() == result.size() );
+
+                distances = &iter->second.distances;
             }
 
             for ( size_t i = 0; i < result.size(); ++i ) {
                 const int32_t tileIdx = static_cast<int32_t>( i );
                 assert( Maps::isValidAbsIndex( tileIdx ) );
 
-                const auto [distToTile, isTileConsideredSafe] = [this, enemyArmyIdx = enemyArmy.index, enemyArmyMovePointsThreshold, useRoughEstimate, tileIdx]() {
+                const auto [distToTile, isTileConsideredSafe] = [distances, enemyArmyIdx, enemyArmyMovePointsThreshold, tileIdx]() {
                     // The tile on which the enemy hero is located is always considered unsafe
                     if ( tileIdx == enemyArmyIdx ) {
                         return std::make_pair( static_cast<uint32_t>( 0 ), false );
                     }
 
-                    if ( useRoughEstimate ) {
+                    if ( distances == nullptr ) {
                         const uint32_t dist = Maps::GetApproximateDistance( tileIdx, enemyArmyIdx ) * Maps::Ground::fastestMovePenalty;
 
                         // When using a rough estimate, a tile is considered safe if the enemy hero cannot reach it within one turn, even if the path from the enemy
@@ -2456,7 +2587,7 @@ int AI::Planner::getPriorityTarget( Heroes & hero, double & maxPriority )
                         return std::make_pair( dist, dist > enemyArmyMovePointsThreshold );
                     }
 
-                    const uint32_t dist = _pathfinder.getDistance( tileIdx );
+                    const uint32_t dist = ( *distances )[tileIdx];
 
                     // When using an accurate estimate, a tile is considered safe if the enemy hero does not have access to it (in particular, if it is hidden from
                     // him in the fog) or he cannot reach it within one turn. The potential ability of the enemy hero to use spells to move to this tile (for example,
@@ -2483,43 +2614,63 @@ int AI::Planner::getPriorityTarget( Heroes & hero, double & maxPriority )
     ObjectValidator objectValidator( hero, _pathfinder, *this );
     ObjectValueStorage valueStorage( hero, *this, lowestPossibleValue );
 
-    const auto getObjectValue = [this, &hero = std::as_const( hero ), &enemyThreatPenalties, &objectValidator,
-                                 &valueStorage]( const int destination, uint32_t & distance, double & value, const MP2::MapObjectType type, const bool isDimensionDoor ) {
+    // Objects on the way to a destination which can add value to it. The flag is set for currently valid objects and is not set for
+    // objects which are going to become valid by the time the hero reaches them.
+    using ObjectsOnTheWay = std::vector<std::pair<IndexObject, bool>>;
+
+    // Collects objects on the way to the destination and requests their values from the value storage. These values must be calculated
+    // by calling ObjectValueStorage::calculateRequestedValues() before the collected objects are passed to getObjectValue().
+    const auto getObjectsOnTheWay = [this, &hero = std::as_const( hero ), &objectValidator, &valueStorage]( const int destination, const bool isDimensionDoor ) {
+        ObjectsOnTheWay objects;
+
         // Dimension door path does not include any objects on the way.
-        if ( !isDimensionDoor ) {
-            for ( const IndexObject & pair : _pathfinder.getObjectsOnTheWay( destination ) ) {
-                const bool isValidObject = objectValidator.isCurrentlyValid( pair.first );
-                const int32_t dayToBecomeValid = objectValidator.whenGoingToBeValidInDays( pair.first );
+        if ( isDimensionDoor ) {
+            return objects;
+        }
 
-                if ( !isValidObject && dayToBecomeValid < 1 ) {
-                    // This is not a valid object and it is not going to be valid in the future.
-                    continue;
-                }
+        for ( const IndexObject & pair : _pathfinder.getObjectsOnTheWay( destination ) ) {
+            const bool isValidObject = objectValidator.isCurrentlyValid( pair.first );
+            const int32_t dayToBecomeValid = objectValidator.whenGoingToBeValidInDays( pair.first );
 
-                if ( const auto iter = _mapActionObjects.find( pair.first ); iter == _mapActionObjects.end() || iter->second != pair.second ) {
-                    continue;
-                }
+            if ( !isValidObject && dayToBecomeValid < 1 ) {
+                // This is not a valid object and it is not going to be valid in the future.
+                continue;
+            }
 
-                double extraValue = 0;
+            if ( const auto iter = _mapActionObjects.find( pair.first ); iter == _mapActionObjects.end() || iter->second != pair.second ) {
+                continue;
+            }
 
-                if ( isValidObject ) {
-                    extraValue = valueStorage.value( pair, 0 );
-                }
-                else {
-                    const auto path = _pathfinder.buildPath( pair.first, false );
-                    assert( !path.empty() );
-                    assert( path.back().GetIndex() == pair.first );
+            if ( isValidObject ) {
+                valueStorage.requestValue( pair, 0 );
+                objects.emplace_back( pair, true );
 
-                    const int32_t daysToReachObject = completedDaysToTarget( path, hero );
-                    if ( daysToReachObject < dayToBecomeValid ) {
-                        extraValue = valueStorage.futureValue( pair, 0 );
-                    }
-                }
+                continue;
+            }
 
-                if ( extraValue > 0 ) {
-                    // There is no need to reduce the quality of the object even if the path has others.
-                    value += extraValue;
-                }
+            const auto path = _pathfinder.buildPath( pair.first, false );
+            assert( !path.empty() );
+            assert( path.back().GetIndex() == pair.first );
+
+            const int32_t daysToReachObject = completedDaysToTarget( path, hero );
+            if ( daysToReachObject < dayToBecomeValid ) {
+                // Future values modify map tiles during their evaluation so they are calculated right away.
+                valueStorage.futureValue( pair, 0 );
+                objects.emplace_back( pair, false );
+            }
+        }
+
+        return objects;
+    };
+
+    const auto getObjectValue = [this, &hero = std::as_const( hero ), &enemyThreatPenalties, &valueStorage]( const int destination, uint32_t & distance, double & value,
+                                                                                                        const MP2::MapObjectType type, const ObjectsOnTheWay & objects ) {
+        for ( const auto & [pair, isValidObject] : objects ) {
+            const double extraValue = isValidObject ? valueStorage.value( pair, 0 ) : valueStorage.futureValue( pair, 0 );
+
+            if ( extraValue > 0 ) {
+                // There is no need to reduce the quality of the object even if the path has others.
+                value += extraValue;
             }
         }
 
@@ -2570,6 +2721,23 @@ int AI::Planner::getPriorityTarget( Heroes & hero, double & maxPriority )
         }
     }
 
+    // Objects which are worth evaluating are collected first. Since checks of object validity and paths to objects rely on the
+    // pathfinder and caches that are not thread-safe, this is done sequentially, while the evaluation of objects, which takes most
+    // of the time, is then done in parallel. The best target is chosen in the original order of objects to get exactly the same
+    // result as if all objects were evaluated sequentially.
+    struct Candidate
+    {
+        IndexObject object;
+        uint32_t distance{ 0 };
+        bool isCurrentlyValid{ false };
+        ObjectsOnTheWay objectsOnTheWay;
+    };
+
+    const fheroes2::Time evaluationTimer;
+
+    std::vector<Candidate> candidates;
+    candidates.reserve( _mapActionObjects.size() );
+
     for ( const auto & [idx, objType] : _mapActionObjects ) {
         const bool isCurrentlyValid = objectValidator.isCurrentlyValid( idx );
         const int32_t daysToBeAvailable = objectValidator.whenGoingToBeValidInDays( idx );
@@ -2601,17 +2769,27 @@ int AI::Planner::getPriorityTarget( Heroes & hero, double & maxPriority )
             }
         }
 
-        double value = 0;
         if ( isCurrentlyValid ) {
-            value = valueStorage.value( { idx, objType }, dist );
+            valueStorage.requestValue( { idx, objType }, dist );
         }
         else {
-            value = valueStorage.futureValue( { idx, objType }, dist );
+            valueStorage.futureValue( { idx, objType }, dist );
         }
 
-        getObjectValue( idx, dist, value, objType, useDimensionDoor );
+        candidates.push_back( { { idx, objType }, dist, isCurrentlyValid, getObjectsOnTheWay( idx, useDimensionDoor ) } );
+    }
+
+    valueStorage.calculateRequestedValues();
 
-        if ( dist > 0 && value > maxPriority ) {
+    for ( Candidate & candidate : candidates ) {
+        const auto [idx, objType] = candidate.object;
+
+        double value = candidate.isCurrentlyValid ? valueStorage.value( candidate.object, candidate.distance )
+                                                  : valueStorage.futureValue( candidate.object, candidate.distance );
+
+        getObjectValue( idx, candidate.distance, value, objType, candidate.objectsOnTheWay );
+
+        if ( candidate.distance > 0 && value > maxPriority ) {
             priorityTarget = idx;
             maxPriority = value;
 #ifdef WITH_DEBUG
@@ -2623,6 +2801,9 @@ int AI::Planner::getPriorityTarget( Heroes & hero, double & maxPriority )
         }
     }
 
+    DEBUG_LOG( DBG_AI, DBG_INFO,
+               hero.GetName() << ": " << candidates.size() << " of " << _mapActionObjects.size() << " objects were evaluated in " << evaluationTimer.getMs() << " ms" )
+
     if ( const UltimateArtifact & art = world.GetUltimateArtifact(); isUltimateArtifactAvailableToHero( art, hero ) ) {
         const int32_t idx = art.getPosition();
         assert( Maps::isValidAbsIndex( idx ) );
@@ -2632,8 +2813,11 @@ int AI::Planner::getPriorityTarget( Heroes & hero, double & maxPriority )
             auto [dist, useDimensionDoor] = getDistanceToTile( _pathfinder, idx );
 
             if ( dist > 0 ) {
+                const ObjectsOnTheWay objectsOnTheWay = getObjectsOnTheWay( idx, useDimensionDoor );
+                valueStorage.calculateRequestedValues();
+
                 double value = ( isFindUltimateArtifactVictoryCondition() ? 3000.0 : 1500.0 ) * art.getArtifactValue();
-                getObjectValue( idx, dist, value, MP2::OBJ_ARTIFACT, useDimensionDoor );
+                getObjectValue( idx, dist, value, MP2::OBJ_ARTIFACT, objectsOnTheWay );
 
                 if ( dist > 0 && ( priorityTarget == -1 || value > maxPriority ) ) {
                     priorityTarget = idx;
@@ -2678,7 +2862,10 @@ int AI::Planner::getPriorityTarget( Heroes & hero, double & maxPriority )
             }
         }
 
-        getObjectValue( idx, dist, value, MP2::OBJ_NONE, useDimensionDoor );
+        const ObjectsOnTheWay objectsOnTheWay = getObjectsOnTheWay( idx, useDimensionDoor );
+        valueStorage.calculateRequestedValues();
+
+        getObjectValue( idx, dist, value, MP2::OBJ_NONE, objectsOnTheWay );
 
         if ( dist > 0 && ( priorityTarget == -1 || value > maxPriority ) ) {
             priorityTarget = idx;
@@ -436,12 +436,6 @@ std::set<int> AI::Planner::findCastlesInDanger( const Kingdom & kingdom )
     // if no our heroes exist. So we are temporary removing them from the map.
     const TemporaryHeroEraser heroEraser( kingdom.GetHeroes() );
 
-    const AIWorldPathfinderStateRestorer pathfinderStateRestorer( _pathfinder );
-
-    // Use the "optimistic" pathfinder settings for enemy armies - minimal army advantage, minimal reserve of spell points
-    _pathfinder.setMinimalArmyStrengthAdvantage( ARMY_ADVANTAGE_DESPERATE );
-    _pathfinder.setSpellPointsReserveRatio( 0.0 );
-
     for ( const auto & [dummy, enemyArmy] : _enemyArmies ) {
         for ( const Castle * castle : kingdom.GetCastles() ) {
             if ( castle == nullptr ) {
@@ -465,12 +459,6 @@ void AI::Planner::updatePriorityForEnemyArmy( const Kingdom & kingdom, const Ene
     // if no our heroes exist. So we are temporary removing them from the map.
     const TemporaryHeroEraser heroEraser( kingdom.GetHeroes() );
 
-    const AIWorldPathfinderStateRestorer pathfinderStateRestorer( _pathfinder );
-
-    // Use the "optimistic" pathfinder settings for enemy armies - minimal army advantage, minimal reserve of spell points
-    _pathfinder.setMinimalArmyStrengthAdvantage( ARMY_ADVANTAGE_DESPERATE );
-    _pathfinder.setSpellPointsReserveRatio( 0.0 );
-
     for ( const Castle * castle : kingdom.GetCastles() ) {
         if ( castle == nullptr ) {
             // How is it even possible? Check the logic!
@@ -488,12 +476,6 @@ void AI::Planner::updatePriorityForCastle( const Castle & castle )
     // if no our heroes exist. So we are temporary removing them from the map.
     const TemporaryHeroEraser heroEraser( castle.GetKingdom().GetHeroes() );
 
-    const AIWorldPathfinderStateRestorer pathfinderStateRestorer( _pathfinder );
-
-    // Use the "optimistic" pathfinder settings for enemy armies - minimal army advantage, minimal reserve of spell points
-    _pathfinder.setMinimalArmyStrengthAdvantage( ARMY_ADVANTAGE_DESPERATE );
-    _pathfinder.setSpellPointsReserveRatio( 0.0 );
-
     for ( const auto & [dummy, enemyArmy] : _enemyArmies ) {
         updateIndividualPriorityForCastle( castle, enemyArmy );
     }
@@ -517,7 +499,10 @@ bool AI::Planner::updateIndividualPriorityForCastle( const Castle & castle, cons
     //
     // Of course, on the other hand, it may be the other way around - the enemy army may have access to some path that is not yet visible to the castle owner,
     // but since the castle owner doesn't know about this for sure, using this option smacks of cheating.
-    const uint32_t dist = _pathfinder.getDistance( enemyArmy.index, castleIndex, castle.GetColor(), enemyArmy.strength );
+    //
+    // The "optimistic" pathfinder settings are used for enemy armies - minimal army advantage.
+    const uint32_t dist
+        = _pathfinderSnapshots.get( enemyArmy.index, castle.GetColor(), enemyArmy.strength, Skill::Level::EXPERT, ARMY_ADVANTAGE_DESPERATE )->getDistance( castleIndex );
     if ( dist == 0 || dist >= threatDistanceLimit ) {
         return false;
     }
@@ -654,10 +639,13 @@ fheroes2::GameMode AI::Planner::KingdomTurn( Kingdom & kingdom )
     _mapActionObjects.clear();
     _priorityTargets.clear();
     _enemyArmies.clear();
+    _enemyHeroDistances.clear();
 
     // Clear the tile army strength cache because the strength of the respective armies might have changed since last time
     _tileArmyStrengthValues.clear();
 
+    _battleOutcomeEstimator.resetTimeBudget();
+
     _regions.clear();
     _regions.resize( world.getRegionCount() );
 
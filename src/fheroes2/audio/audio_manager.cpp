@@ -32,6 +32,7 @@
 #include <mutex>
 #include <optional>
 #include <ostream>
+#include <string_view>
 #include <utility>
 
 #include "agg_file.h"
@@ -218,13 +219,156 @@ namespace
         }
     }
 
+    // Conversion of XMI tracks to MIDI format takes a noticeable time on slow devices, so converted tracks are stored in the cache
+    // directory as separate files. Each file contains the checksum of the XMI data it was converted from, so the file is used only
+    // if the AGG file still contains the same XMI data for this track.
+    class MidiDiskCache
+    {
+    public:
+        MidiDiskCache() = default;
+        MidiDiskCache( const MidiDiskCache & ) = delete;
+
+        ~MidiDiskCache() = default;
+
+        MidiDiskCache & operator=( const MidiDiskCache & ) = delete;
+
+        // Returns true if there is an up-to-date converted track for the given XMI data in the cache.
+        bool contains( const int xmi, const uint32_t xmiChecksum )
+        {
+            const std::scoped_lock<std::mutex> lock( _mutex );
+
+            StreamFile fileStream;
+
+            return openForReading( fileStream, xmi, xmiChecksum );
+        }
+
+        bool load( const int xmi, const uint32_t xmiChecksum, std::vector<uint8_t> & mid )
+        {
+            const std::scoped_lock<std::mutex> lock( _mutex );
+
+            StreamFile fileStream;
+
+            if ( !openForReading( fileStream, xmi, xmiChecksum ) ) {
+                return false;
+            }
+
+            const uint32_t size = fileStream.get32();
+            if ( fileStream.fail() || size == 0 ) {
+                return false;
+            }
+
+            std::vector<uint8_t> data = fileStream.getRaw( size );
+            if ( data.size() != size ) {
+                DEBUG_LOG( DBG_GAME, DBG_WARN, "The cached MIDI track " << XMI::GetString( xmi ) << " is corrupted" )
+                return false;
+            }
+
+            mid = std::move( data );
+
+            return true;
+        }
+
+        void save( const int xmi, const uint32_t xmiChecksum, const std::vector<uint8_t> & mid )
+        {
+            assert( !mid.empty() );
+
+            const std::scoped_lock<std::mutex> lock( _mutex );
+
+            const std::string cacheDir = System::concatPath( System::GetConfigDirectory( "fheroes" ), cacheDirName );
+            if ( !System::IsDirectory( cacheDir ) && !System::MakeDirectory( cacheDir ) ) {
+                return;
+            }
+
+            const std::string filePath = getFilePath( xmi );
+            // The file is written under a temporary name first, so an incomplete file will never be used
+            const std::string tempFilePath = filePath + ".tmp";
+
+            {
+                StreamFile fileStream;
+                fileStream.setBigendian( true );
+
+                if ( !fileStream.open( tempFilePath, "wb" ) ) {
+                    DEBUG_LOG( DBG_GAME, DBG_WARN, "Error opening the file " << tempFilePath )
+                    return;
+                }
+
+                fileStream << cacheFileMagicNumber << cacheFormatVersion << xmiChecksum << static_cast<uint32_t>( mid.size() );
+                fileStream.putRaw( mid.data(), mid.size() );
+
+                if ( fileStream.fail() ) {
+                    DEBUG_LOG( DBG_GAME, DBG_WARN, "Error writing the file " << tempFilePath )
+
+                    fileStream.close();
+                    System::Unlink( tempFilePath );
+                    return;
+                }
+            }
+
+            if ( !System::Rename( tempFilePath, filePath ) ) {
+                DEBUG_LOG( DBG_GAME, DBG_WARN, "Error renaming the file " << tempFilePath << " to " << filePath )
+
+                System::Unlink( tempFilePath );
+            }
+        }
+
+    private:
+        static constexpr std::string_view cacheDirName{ "midi.cache" };
+        static constexpr uint16_t cacheFileMagicNumber{ 0xFC02 };
+        // This version should be increased every time the MIDI data produced by Music::Xmi2Mid() is changed
+        static constexpr uint16_t cacheFormatVersion{ 1 };
+
+        std::mutex _mutex;
+
+        static std::string getFilePath( const int xmi )
+        {
+            // Names of some XMI tracks from different AGG files are the same, so the track ID is used as a file name
+            return System::concatPath( System::concatPath( System::GetConfigDirectory( "fheroes" ), cacheDirName ), std::to_string( xmi ) + ".mid" );
+        }
+
+        // Opens the cache file of the given track and checks its header. The stream is positioned right after the header.
+        static bool openForReading( StreamFile & fileStream, const int xmi, const uint32_t xmiChecksum )
+        {
+            fileStream.setBigendian( true );
+
+            if ( !fileStream.open( getFilePath( xmi ), "rb" ) ) {
+                return false;
+            }
+
+            uint16_t magicNumber = 0;
+            uint16_t version = 0;
+            uint32_t checksum = 0;
+
+            fileStream >> magicNumber >> version >> checksum;
+
+            return !fileStream.fail() && magicNumber == cacheFileMagicNumber && version == cacheFormatVersion && checksum == xmiChecksum;
+        }
+    };
+
+    MidiDiskCache midiDiskCache;
+
+    uint32_t getXmiChecksum( const std::vector<uint8_t> & xmi )
+    {
+        return fheroes2::calculateCRC32( xmi.data(), xmi.size() );
+    }
+
     void LoadMID( int xmi, std::vector<uint8_t> & v )
     {
         DEBUG_LOG( DBG_GAME, DBG_TRACE, XMI::GetString( xmi ) )
         const std::vector<uint8_t> & body = getDataFromAggFile( XMI::GetString( xmi ), xmi >= XMI::MIDI_ORIGINAL_KNIGHT );
 
-        if ( !body.empty() ) {
-            v = Music::Xmi2Mid( body );
+        if ( body.empty() ) {
+            return;
+        }
+
+        const uint32_t xmiChecksum = getXmiChecksum( body );
+        if ( midiDiskCache.load( xmi, xmiChecksum, v ) ) {
+            return;
+        }
+
+        v = Music::Xmi2Mid( body );
+
+        if ( !v.empty() ) {
+            midiDiskCache.save( xmi, xmiChecksum, v );
         }
     }
 
@@ -295,6 +439,29 @@ namespace
             notifyWorker();
         }
 
+        // Converts all XMI tracks that are not in the MIDI disk cache yet, one track per task, and stores them in this cache. These tasks
+        // have the lowest priority, so they do not delay playback of music and sounds. This is done only once per AudioInitializer.
+        void pushMidiDiskCacheFilling()
+        {
+#if defined( __EMSCRIPTEN__ ) && !defined( __EMSCRIPTEN_PTHREADS__ )
+            // Tasks are executed synchronously on this platform, so filling the cache in advance would only slow things down.
+            return;
+#else
+            createWorker();
+
+            const std::scoped_lock<std::mutex> lock( _mutex );
+
+            if ( _isMidiDiskCacheFillingStarted ) {
+                return;
+            }
+
+            _isMidiDiskCacheFillingStarted = true;
+            _nextXmiToCache = XMI::UNKNOWN + 1;
+
+            notifyWorker();
+#endif
+        }
+
         void removeMusicTask()
         {
             const std::scoped_lock<std::mutex> lock( _mutex );
@@ -341,10 +508,18 @@ namespace
             _musicTask.reset();
             _soundTasks.clear();
             _loopSoundTask.reset();
+            _nextXmiToCache = XMI::UNKNOWN;
 
             _taskToExecute = TaskType::None;
         }
 
+        void resetMidiDiskCacheFilling()
+        {
+            const std::scoped_lock<std::mutex> lock( _mutex );
+
+            _isMidiDiskCacheFillingStarted = false;
+        }
+
         // This mutex protects operations with AudioManager's resources, such as AGG files, data caches, etc
         std::recursive_mutex & resourceMutex()
         {
@@ -357,7 +532,8 @@ namespace
             None,
             PlayMusic,
             PlaySound,
-            PlayLoopSound
+            PlayLoopSound,
+            FillMidiDiskCache
         };
 
         struct MusicTask
@@ -413,6 +589,11 @@ namespace
         SoundTask _currentSoundTask;
         LoopSoundTask _currentLoopSoundTask;
 
+        // The next XMI track to be stored in the MIDI disk cache, or XMI::UNKNOWN if there is nothing to do
+        int _nextXmiToCache{ XMI::UNKNOWN };
+        int _currentXmiToCache{ XMI::UNKNOWN };
+        bool _isMidiDiskCacheFillingStarted{ false };
+
         std::atomic<TaskType> _taskToExecute{ TaskType::None };
 
         std::recursive_mutex _resourceMutex;
@@ -447,6 +628,15 @@ namespace
                 return true;
             }
 
+            if ( _nextXmiToCache != XMI::UNKNOWN ) {
+                _currentXmiToCache = _nextXmiToCache;
+                _nextXmiToCache = _nextXmiToCache < XMI::MIDI_ORIGINAL_NECROMANCER ? _nextXmiToCache + 1 : XMI::UNKNOWN;
+
+                _taskToExecute = TaskType::FillMidiDiskCache;
+
+                return true;
+            }
+
             _taskToExecute = TaskType::None;
 
             return false;
@@ -455,6 +645,12 @@ namespace
         // This method is called by the worker thread, but is not protected by _mutex
         void executeTask() override
         {
+            // The conversion of an XMI track can take a while, so the _resourceMutex is only acquired while reading the AGG file
+            if ( _taskToExecute == TaskType::FillMidiDiskCache ) {
+                fillMidiDiskCache( _currentXmiToCache );
+                return;
+            }
+
             // Do not allow the main thread to acquire this mutex in the interval between the
             // _taskToExecute was checked and the task was started executing. Release it only
             // when the task is fully completed.
@@ -473,12 +669,44 @@ namespace
             case TaskType::PlayLoopSound:
                 playLoopSoundsImpl( std::move( _currentLoopSoundTask.soundEffects ), _currentLoopSoundTask.is3DAudioEnabled );
                 return;
+            case TaskType::FillMidiDiskCache:
+                // This task should have been already executed.
+                assert( 0 );
+                return;
             default:
                 // How is it even possible? Did you add a new task?
                 assert( 0 );
                 break;
             }
         }
+
+        // This method is called by the worker thread
+        void fillMidiDiskCache( const int xmi )
+        {
+            std::vector<uint8_t> body;
+
+            {
+                const std::scoped_lock<std::recursive_mutex> lock( _resourceMutex );
+
+                body = getDataFromAggFile( XMI::GetString( xmi ), xmi >= XMI::MIDI_ORIGINAL_KNIGHT );
+            }
+
+            if ( body.empty() ) {
+                return;
+            }
+
+            const uint32_t xmiChecksum = getXmiChecksum( body );
+            if ( midiDiskCache.contains( xmi, xmiChecksum ) ) {
+                return;
+            }
+
+            DEBUG_LOG( DBG_GAME, DBG_TRACE, "Store MIDI track " << XMI::GetString( xmi ) << " in the disk cache" )
+
+            const std::vector<uint8_t> mid = Music::Xmi2Mid( body );
+            if ( !mid.empty() ) {
+                midiDiskCache.save( xmi, xmiChecksum, mid );
+            }
+        }
     };
 
     std::map<M82::SoundType, std::vector<ChannelAudioLoopEffectInfo>> currentAudioLoopEffects;
@@ -518,7 +746,7 @@ namespace
             return -1;
         }
 
-        return Mixer::Play( v.data(), static_cast<uint32_t>( v.size() ), false );
+        return Mixer::Play( static_cast<uint64_t>( m82 ), v.data(), static_cast<uint32_t>( v.size() ), false );
     }
 
     uint64_t getMusicUID( const int trackId, const MusicSource musicType )
@@ -586,6 +814,9 @@ namespace
 
                 currentMusicTrackId = trackId;
             }
+
+            // Prepare the rest of MIDI tracks in advance so they will start without delays later, including the next launches of the game
+            g_asyncSoundManager.pushMidiDiskCacheFilling();
         }
 
         DEBUG_LOG( DBG_GAME, DBG_TRACE, "Play MIDI music track " << XMI::GetString( xmi ) )
@@ -761,8 +992,8 @@ namespace
 
                 assert( is3DAudioEnabled || effectInfo.angle == 0 );
 
-                const int channelId
-                    = Mixer::Play( audioData.data(), static_cast<uint32_t>( audioData.size() ), true, std::pair{ effectInfo.angle, effectInfo.distance } );
+                const int channelId = Mixer::Play( static_cast<uint64_t>( soundType ), audioData.data(), static_cast<uint32_t>( audioData.size() ), true,
+                                                   std::pair{ effectInfo.angle, effectInfo.distance } );
                 if ( channelId < 0 ) {
                     // Unable to play this sound.
                     continue;
@@ -809,6 +1040,7 @@ namespace AudioManager
     {
         g_asyncSoundManager.removeAllTasks();
         g_asyncSoundManager.stopWorker();
+        g_asyncSoundManager.resetMidiDiskCacheFilling();
 
         wavDataCache.clear();
         MIDDataCache.clear();
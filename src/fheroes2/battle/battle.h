@@ -67,6 +67,9 @@ namespace Battle
 
     Result Loader( Army & attackingArmy, Army & defendingArmy, const int32_t tileIndex );
 
+    // Returns the number of battles fought on the adventure map since the start of the application. Used for profiling purposes only.
+    uint32_t getBattleCount();
+
     struct TargetInfo
     {
         Unit * defender = nullptr;
@@ -70,7 +70,8 @@
 
 namespace
 {
-    Battle::Arena * arena = nullptr;
+    // Each thread has its own current arena, so battles can be played in parallel threads.
+    thread_local Battle::Arena * arena = nullptr;
 
     template <typename T>
     Battle::Unit * getLastResurrectableUnitFromGraveyardTmpl( const Battle::Graveyard & graveyard, const HeroBase * commander, const int32_t index, const T & spells )
@@ -61,6 +61,8 @@
 
 namespace
 {
+    uint32_t battleCount{ 0 };
+
     bool isArtifactSuitableForTransfer( const Artifact & art )
     {
         return art.isValid() && art.GetID() != Artifact::MAGIC_BOOK;
@@ -288,6 +290,11 @@ namespace
     }
 }
 
+uint32_t Battle::getBattleCount()
+{
+    return battleCount;
+}
+
 Battle::Result Battle::Loader( Army & attackingArmy, Army & defendingArmy, const int32_t tileIndex )
 {
     Result result;
@@ -306,6 +313,8 @@ Battle::Result Battle::Loader( Army & attackingArmy, Army & defendingArmy, const
         return result;
     }
 
+    ++battleCount;
+
     HeroBase * attackingArmyCommander = attackingArmy.GetCommander();
     if ( attackingArmyCommander ) {
         attackingArmyCommander->ActionPreBattle();
@@ -25,7 +25,6 @@
 #include <cstddef>
 #include <cstdint>
 #include <functional>
-#include <set>
 #include <tuple>
 #include <vector>
 
@@ -42,6 +41,70 @@ namespace
 
 namespace Battle
 {
+    size_t BattlePathfinder::getNodeSlot( const BattleNodeIndex & index )
+    {
+        const auto [headCellIdx, tailCellIdx] = index;
+        assert( Board::isValidIndex( headCellIdx ) );
+
+        const size_t slot = static_cast<size_t>( headCellIdx ) * nodesPerCell;
+
+        if ( tailCellIdx == -1 ) {
+            return slot;
+        }
+
+        assert( tailCellIdx == headCellIdx - 1 || tailCellIdx == headCellIdx + 1 );
+
+        return slot + ( tailCellIdx < headCellIdx ? 1 : 2 );
+    }
+
+    BattleNodeIndex BattlePathfinder::getNodeIndex( const size_t slot )
+    {
+        const int32_t headCellIdx = static_cast<int32_t>( slot / nodesPerCell );
+
+        switch ( slot % nodesPerCell ) {
+        case 0:
+            return { headCellIdx, -1 };
+        case 1:
+            return { headCellIdx, headCellIdx - 1 };
+        case 2:
+            return { headCellIdx, headCellIdx + 1 };
+        default:
+            assert( 0 );
+            break;
+        }
+
+        return { -1, -1 };
+    }
+
+    const BattleNode * BattlePathfinder::findNode( const BattleNodeIndex & index ) const
+    {
+        if ( !Board::isValidIndex( index.first ) ) {
+            return nullptr;
+        }
+
+        const size_t slot = getNodeSlot( index );
+        if ( _cacheEpochs[slot] != _currentEpoch ) {
+            return nullptr;
+        }
+
+        return &_cache[slot];
+    }
+
+    BattleNode & BattlePathfinder::getNode( const BattleNodeIndex & index )
+    {
+        const size_t slot = getNodeSlot( index );
+
+        BattleNode & node = _cache[slot];
+
+        if ( _cacheEpochs[slot] != _currentEpoch ) {
+            _cacheEpochs[slot] = _currentEpoch;
+
+            node = {};
+        }
+
+        return node;
+    }
+
     void BattlePathfinder::reEvaluateIfNeeded( const Unit & unit )
     {
         assert( unit.GetHeadIndex() != -1 && ( unit.isWide() ? unit.GetTailIndex() != -1 : unit.GetTailIndex() == -1 ) );
@@ -73,8 +136,13 @@ namespace Battle
         const Castle * castle = Arena::GetCastle();
         const bool isMoatBuilt = castle && castle->isBuild( BUILD_MOAT );
 
-        _cache.clear();
-        _cache.try_emplace( _pathStart );
+        // Invalidate all cached nodes at once. In the (very unlikely) case of an epoch overflow, the epochs of all nodes should be reset to avoid false matches.
+        if ( ++_currentEpoch == 0 ) {
+            _cacheEpochs.fill( 0 );
+            _currentEpoch = 1;
+        }
+
+        getNode( _pathStart );
 
         // Flying units can land wherever they can fit
         if ( _isFlying ) {
@@ -90,12 +158,13 @@ namespace Battle
                 const int32_t headCellIdx = pos.GetHead()->GetIndex();
                 const int32_t tailCellIdx = pos.GetTail() ? pos.GetTail()->GetIndex() : -1;
 
-                if ( const auto [iter, inserted] = _cache.try_emplace( { headCellIdx, tailCellIdx } ); inserted ) {
+                const BattleNodeIndex nodeIdx = { headCellIdx, tailCellIdx };
+                if ( findNode( nodeIdx ) == nullptr ) {
                     // Wide units can occupy overlapping positions, the distance between which is actually zero,
                     // but since the movement takes place, we will consider the distance equal to 1 in this case
                     const uint32_t distance = std::max<uint32_t>( Board::GetDistance( unit.GetPosition(), pos ), 1U );
 
-                    iter->second.update( _pathStart, 1, distance );
+                    getNode( nodeIdx ).update( _pathStart, 1, distance );
                 }
             }
 
@@ -132,7 +201,8 @@ namespace Battle
 
         for ( size_t nodesToExploreIdx = 0; nodesToExploreIdx < nodesToExplore.size(); ++nodesToExploreIdx ) {
             const BattleNodeIndex currentNodeIdx = nodesToExplore[nodesToExploreIdx];
-            const BattleNode & currentNode = _cache[currentNodeIdx];
+            // Nodes are never moved, so this reference remains valid while new nodes are being added
+            const BattleNode & currentNode = getNode( currentNodeIdx );
 
             if ( _isWide ) {
                 assert( currentNodeIdx.first != -1 && currentNodeIdx.second != -1 );
@@ -169,7 +239,7 @@ namespace Battle
                     const uint32_t cost = currentNode._cost + ( newNodeIdx == flippedCurrentNodeIdx ? 0 : movementPenalty );
                     const uint32_t distance = currentNode._distance + ( newNodeIdx == flippedCurrentNodeIdx ? 0 : 1 );
 
-                    BattleNode & newNode = _cache[newNodeIdx];
+                    BattleNode & newNode = getNode( newNodeIdx );
                     if ( newNode._from == BattleNodeIndex{ -1, -1 } || newNode._cost > cost ) {
                         newNode.update( currentNodeIdx, cost, distance );
 
@@ -206,7 +276,7 @@ namespace Battle
                     const uint32_t cost = currentNode._cost + movementPenalty;
                     const uint32_t distance = currentNode._distance + 1;
 
-                    BattleNode & newNode = _cache[newNodeIdx];
+                    BattleNode & newNode = getNode( newNodeIdx );
                     if ( newNode._from == BattleNodeIndex{ -1, -1 } || newNode._cost > cost ) {
                         newNode.update( currentNodeIdx, cost, distance );
 
@@ -228,14 +298,12 @@ namespace Battle
 
         const BattleNodeIndex nodeIdx = { position.GetHead()->GetIndex(), position.GetTail() ? position.GetTail()->GetIndex() : -1 };
 
-        const auto iter = _cache.find( nodeIdx );
-        if ( iter == _cache.end() ) {
+        const BattleNode * node = findNode( nodeIdx );
+        if ( node == nullptr ) {
             return false;
         }
 
-        const auto & [index, node] = *iter;
-
-        return ( index == _pathStart || node._from != BattleNodeIndex{ -1, -1 } ) && ( !isOnCurrentTurn || node._cost <= _speed );
+        return ( nodeIdx == _pathStart || node->_from != BattleNodeIndex{ -1, -1 } ) && ( !isOnCurrentTurn || node->_cost <= _speed );
     }
 
     uint32_t BattlePathfinder::getCost( const Unit & unit, const Position & position )
@@ -246,14 +314,12 @@ namespace Battle
 
         const BattleNodeIndex nodeIdx = { position.GetHead()->GetIndex(), position.GetTail() ? position.GetTail()->GetIndex() : -1 };
 
-        const auto iter = _cache.find( nodeIdx );
-        assert( iter != _cache.end() );
-
-        const auto & [index, node] = *iter;
+        const BattleNode * node = findNode( nodeIdx );
+        assert( node != nullptr );
         // MSVC 2017 fails to properly expand the assert() macro without additional parentheses
-        assert( ( index == _pathStart || node._from != BattleNodeIndex{ -1, -1 } ) );
+        assert( ( nodeIdx == _pathStart || node->_from != BattleNodeIndex{ -1, -1 } ) );
 
-        return node._cost;
+        return node->_cost;
     }
 
     uint32_t BattlePathfinder::getDistance( const Unit & unit, const Position & position )
@@ -264,37 +330,41 @@ namespace Battle
 
         const BattleNodeIndex nodeIdx = { position.GetHead()->GetIndex(), position.GetTail() ? position.GetTail()->GetIndex() : -1 };
 
-        const auto iter = _cache.find( nodeIdx );
-        assert( iter != _cache.end() );
-
-        const auto & [index, node] = *iter;
+        const BattleNode * node = findNode( nodeIdx );
+        assert( node != nullptr );
         // MSVC 2017 fails to properly expand the assert() macro without additional parentheses
-        assert( ( index == _pathStart || node._from != BattleNodeIndex{ -1, -1 } ) );
+        assert( ( nodeIdx == _pathStart || node->_from != BattleNodeIndex{ -1, -1 } ) );
 
-        return node._distance;
+        return node->_distance;
     }
 
     Indexes BattlePathfinder::getAllAvailableMoves( const Unit & unit )
     {
         reEvaluateIfNeeded( unit );
 
-        std::set<int32_t> boardIndexes;
+        Indexes result;
+        result.reserve( Board::sizeInCells );
+
+        // Nodes are ordered by the index of the head cell, so the resulting indexes are sorted as well
+        for ( size_t slot = 0; slot < _cache.size(); ++slot ) {
+            if ( _cacheEpochs[slot] != _currentEpoch ) {
+                continue;
+            }
+
+            const BattleNodeIndex index = getNodeIndex( slot );
+            const BattleNode & node = _cache[slot];
 
-        for ( const auto & [index, node] : _cache ) {
             if ( index == _pathStart || node._from == BattleNodeIndex{ -1, -1 } || node._cost > _speed ) {
                 continue;
             }
 
             assert( index.first != -1 );
 
-            boardIndexes.insert( index.first );
+            if ( result.empty() || result.back() != index.first ) {
+                result.push_back( index.first );
+            }
         }
 
-        Indexes result;
-
-        result.reserve( boardIndexes.size() );
-        result.assign( boardIndexes.begin(), boardIndexes.end() );
-
         return result;
     }
 
@@ -310,21 +380,21 @@ namespace Battle
         BattleNodeIndex lastReachableNodeIdx{ -1, -1 };
         BattleNodeIndex nodeIdx = { position.GetHead()->GetIndex(), position.GetTail() ? position.GetTail()->GetIndex() : -1 };
 
-        for ( auto iter = _cache.find( nodeIdx ); iter != _cache.end(); iter = _cache.find( nodeIdx ) ) {
-            const auto & [index, node] = *iter;
+        for ( const BattleNode * node = findNode( nodeIdx ); node != nullptr; node = findNode( nodeIdx ) ) {
+            const BattleNodeIndex index = nodeIdx;
 
             if ( index == _pathStart ) {
                 break;
             }
 
             // MSVC 2017 fails to properly expand the assert() macro without additional parentheses
-            assert( ( node._from != BattleNodeIndex{ -1, -1 } ) );
+            assert( ( node->_from != BattleNodeIndex{ -1, -1 } ) );
 
-            nodeIdx = node._from;
+            nodeIdx = node->_from;
 
             // A given position may be reachable in principle, but is not reachable on the current turn.
             // Skip the steps that are not reachable on this turn.
-            if ( node._cost > _speed ) {
+            if ( node->_cost > _speed ) {
                 continue;
             }
 
@@ -365,21 +435,21 @@ namespace Battle
 
         BattleNodeIndex nodeIdx = { position.GetHead()->GetIndex(), position.GetTail() ? position.GetTail()->GetIndex() : -1 };
 
-        for ( auto iter = _cache.find( nodeIdx ); iter != _cache.end(); iter = _cache.find( nodeIdx ) ) {
-            const auto & [index, node] = *iter;
+        for ( const BattleNode * node = findNode( nodeIdx ); node != nullptr; node = findNode( nodeIdx ) ) {
+            const BattleNodeIndex index = nodeIdx;
 
             if ( index == _pathStart ) {
                 break;
             }
 
             // MSVC 2017 fails to properly expand the assert() macro without additional parentheses
-            assert( ( node._from != BattleNodeIndex{ -1, -1 } ) );
+            assert( ( node->_from != BattleNodeIndex{ -1, -1 } ) );
 
-            nodeIdx = node._from;
+            nodeIdx = node->_from;
 
             // A given position may be reachable in principle, but is not reachable on the current turn.
             // Skip the steps that are not reachable on this turn.
-            if ( node._cost > _speed ) {
+            if ( node->_cost > _speed ) {
                 continue;
             }
 
@@ -23,7 +23,6 @@
 #include <array>
 #include <cstddef>
 #include <cstdint>
-#include <unordered_map>
 #include <utility>
 
 #include "battle_board.h"
@@ -36,19 +35,6 @@ namespace Battle
 
     using BattleNodeIndex = std::pair<int32_t, int32_t>;
 
-    struct BattleNodeIndexHash final
-    {
-        std::size_t operator()( const BattleNodeIndex & index ) const noexcept
-        {
-            const uint64_t f = index.first;
-            const uint64_t s = index.second;
-
-            std::hash<uint64_t> hasher;
-
-            return hasher( ( f << 32 ) + s );
-        }
-    };
-
     struct BattleNode final
     {
         BattleNodeIndex _from{ -1, -1 };
@@ -109,7 +95,25 @@ namespace Battle
         // Rebuilds the graph of available positions for the given unit if necessary (if it is not already cached)
         void reEvaluateIfNeeded( const Unit & unit );
 
-        std::unordered_map<BattleNodeIndex, BattleNode, BattleNodeIndexHash> _cache;
+        // The head of a unit can occupy any cell of the board, and the tail of a wide unit can only be located to the left or to the right of its head,
+        // so there are at most three different nodes for each cell.
+        static constexpr size_t nodesPerCell{ 3 };
+
+        static size_t getNodeSlot( const BattleNodeIndex & index );
+        static BattleNodeIndex getNodeIndex( const size_t slot );
+
+        // Returns the node with the given index if it was reached during the last evaluation, otherwise returns nullptr
+        const BattleNode * findNode( const BattleNodeIndex & index ) const;
+
+        // Returns the node with the given index, a new node is created if it was not reached during the current evaluation yet
+        BattleNode & getNode( const BattleNodeIndex & index );
+
+        std::array<BattleNode, Board::sizeInCells * nodesPerCell> _cache{};
+
+        // The node is considered to be present in the cache only if its epoch is equal to the current one, so the cache can
+        // be cleared just by incrementing the current epoch
+        std::array<uint32_t, Board::sizeInCells * nodesPerCell> _cacheEpochs{};
+        uint32_t _currentEpoch{ 0 };
 
         // Parameters of the unit for which the current cache is created
         BattleNodeIndex _pathStart{ -1, -1 };
@@ -824,6 +824,9 @@ void Castle::ChangeColor( const PlayerColor newColor )
 {
     SetColor( newColor );
     _army.SetColor( newColor );
+
+    // Entrances to allied castles are impassable, so the passability of the entrance tile depends on the castle color
+    world.markTileChanged( GetIndex() );
 }
 
 int Castle::GetLevelMageGuild() const
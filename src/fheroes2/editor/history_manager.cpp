@@ -21,95 +21,383 @@
 #include "history_manager.h"
 
 #include <cassert>
+#include <cstddef>
 #include <cstdint>
+#include <map>
+#include <memory>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
 
+#include "game_language.h"
 #include "map_format_helper.h"
 #include "map_format_info.h"
-#include "serialize.h"
 #include "world_object_uid.h"
 
 namespace
 {
-    // This class holds 2 copies of MapFormat objects in a compressed format:
-    // - one copy before the action
-    // - one copy after the action
-    class MapAction final : public fheroes2::Action
+    template <typename T>
+    bool isEqual( const T & left, const T & right )
+    {
+        return left == right;
+    }
+
+    // BaseMapFormat has no comparison operator on purpose: MapFormat is derived from it so such an operator could be called for MapFormat objects by mistake.
+    // If a new member is added to BaseMapFormat it must be added here as well.
+    bool isEqual( const Maps::Map_Format::BaseMapFormat & left, const Maps::Map_Format::BaseMapFormat & right )
+    {
+        return left.version == right.version && left.isCampaign == right.isCampaign && left.difficulty == right.difficulty
+               && left.availablePlayerColors == right.availablePlayerColors && left.humanPlayerColors == right.humanPlayerColors
+               && left.computerPlayerColors == right.computerPlayerColors && left.alliances == right.alliances && left.playerRace == right.playerRace
+               && left.victoryConditionType == right.victoryConditionType && left.isVictoryConditionApplicableForAI == right.isVictoryConditionApplicableForAI
+               && left.allowNormalVictory == right.allowNormalVictory && left.victoryConditionMetadata == right.victoryConditionMetadata
+               && left.lossConditionType == right.lossConditionType && left.lossConditionMetadata == right.lossConditionMetadata && left.width == right.width
+               && left.mainLanguage == right.mainLanguage && left.name == right.name && left.description == right.description && left.creatorNotes == right.creatorNotes
+               && left.translations == right.translations;
+    }
+
+    // The memory usage is estimated roughly: only the data which can be big is taken into account.
+    template <typename T>
+    size_t estimateMemoryUsage( const T & /* unused */ )
+    {
+        return sizeof( T );
+    }
+
+    size_t estimateMemoryUsage( const std::string & value )
+    {
+        return sizeof( std::string ) + value.size();
+    }
+
+    size_t estimateMemoryUsage( const Maps::Map_Format::TileInfo & tile )
+    {
+        return sizeof( Maps::Map_Format::TileInfo ) + tile.objects.size() * sizeof( Maps::Map_Format::TileObjectInfo );
+    }
+
+    template <typename T>
+    size_t estimateMemoryUsage( const std::vector<T> & values )
+    {
+        size_t usage = sizeof( std::vector<T> );
+
+        for ( const T & value : values ) {
+            usage += estimateMemoryUsage( value );
+        }
+
+        return usage;
+    }
+
+    // Holds the values before and after the change if they are different.
+    template <typename T>
+    class ValueDelta
     {
     public:
-        explicit MapAction( Maps::Map_Format::MapFormat & mapFormat )
-            : _mapFormat( mapFormat )
-            , _latestObjectUIDBefore( Maps::getLastObjectUID() )
+        void create( const T & before, const T & after )
         {
-            if ( !Maps::Map_Format::saveMap( _beforeMapFormat, _mapFormat ) ) {
-                assert( 0 );
+            if ( isEqual( before, after ) ) {
+                reset();
+                return;
             }
-        }
 
-        // Disable the copy and move (implicitly) constructors and assignment operators.
-        MapAction( const MapAction & ) = delete;
-        MapAction & operator=( const MapAction & ) = delete;
-        ~MapAction() override = default;
+            _before = before;
+            _after = after;
+        }
 
-        bool prepare()
+        void apply( T & value, const bool isRedo ) const
         {
-            if ( !Maps::Map_Format::saveMap( _afterMapFormat, _mapFormat ) ) {
-                assert( 0 );
-                return false;
+            if ( !_before ) {
+                return;
             }
 
-            _latestObjectUIDAfter = Maps::getLastObjectUID();
+            value = isRedo ? *_after : *_before;
+        }
 
-            return true;
+        void reset()
+        {
+            _before.reset();
+            _after.reset();
         }
 
-        bool redo() override
+        bool empty() const
+        {
+            return !_before;
+        }
+
+        size_t getMemoryUsage() const
         {
-            if ( !Maps::Map_Format::loadMap( _afterMapFormat, _mapFormat ) ) {
-                assert( 0 );
-                return false;
+            return _before ? estimateMemoryUsage( *_before ) + estimateMemoryUsage( *_after ) : 0;
+        }
+
+    private:
+        std::optional<T> _before;
+        std::optional<T> _after;
+    };
+
+    // Holds only added, removed and modified entries of the map.
+    template <typename Key, typename T>
+    class MetadataDelta
+    {
+    public:
+        void create( const std::map<Key, T> & before, const std::map<Key, T> & after )
+        {
+            _changes.clear();
+
+            auto beforeIter = before.begin();
+            auto afterIter = after.begin();
+
+            while ( beforeIter != before.end() || afterIter != after.end() ) {
+                if ( afterIter == after.end() || ( beforeIter != before.end() && beforeIter->first < afterIter->first ) ) {
+                    // The entry has been removed.
+                    _changes.push_back( { beforeIter->first, beforeIter->second, std::nullopt } );
+                    ++beforeIter;
+                }
+                else if ( beforeIter == before.end() || afterIter->first < beforeIter->first ) {
+                    // The entry has been added.
+                    _changes.push_back( { afterIter->first, std::nullopt, afterIter->second } );
+                    ++afterIter;
+                }
+                else {
+                    if ( !isEqual( beforeIter->second, afterIter->second ) ) {
+                        _changes.push_back( { beforeIter->first, beforeIter->second, afterIter->second } );
+                    }
+
+                    ++beforeIter;
+                    ++afterIter;
+                }
             }
+        }
+
+        void apply( std::map<Key, T> & metadata, const bool isRedo ) const
+        {
+            for ( const Change & change : _changes ) {
+                const std::optional<T> & value = isRedo ? change.after : change.before;
+                if ( value ) {
+                    metadata[change.key] = *value;
+                }
+                else {
+                    metadata.erase( change.key );
+                }
+            }
+        }
+
+        bool empty() const
+        {
+            return _changes.empty();
+        }
+
+        size_t getMemoryUsage() const
+        {
+            return _changes.size() * sizeof( Change );
+        }
+
+    private:
+        struct Change
+        {
+            Key key;
+            std::optional<T> before;
+            std::optional<T> after;
+        };
 
-            _afterMapFormat.seek( 0 );
+        std::vector<Change> _changes;
+    };
+
+    // Holds only the modified tiles. If the number of tiles has changed all tiles are kept.
+    class TileDelta
+    {
+    public:
+        void create( const std::vector<Maps::Map_Format::TileInfo> & before, const std::vector<Maps::Map_Format::TileInfo> & after )
+        {
+            _changes.clear();
 
-            if ( !Maps::readMapInEditor( _mapFormat ) ) {
-                // If this assertion blows up then something is really wrong with the Editor.
-                assert( 0 );
-                return false;
+            if ( before.size() != after.size() ) {
+                _allTiles.create( before, after );
+                return;
             }
 
-            Maps::setLastObjectUID( _latestObjectUIDAfter );
+            _allTiles.reset();
 
-            return true;
+            for ( size_t i = 0; i < before.size(); ++i ) {
+                if ( before[i] != after[i] ) {
+                    _changes.push_back( { i, before[i], after[i] } );
+                }
+            }
         }
 
-        bool undo() override
+        void apply( std::vector<Maps::Map_Format::TileInfo> & tiles, const bool isRedo ) const
         {
-            if ( !Maps::Map_Format::loadMap( _beforeMapFormat, _mapFormat ) ) {
-                assert( 0 );
-                return false;
+            _allTiles.apply( tiles, isRedo );
+
+            for ( const Change & change : _changes ) {
+                assert( change.index < tiles.size() );
+
+                tiles[change.index] = isRedo ? change.after : change.before;
             }
+        }
 
-            _beforeMapFormat.seek( 0 );
+        bool empty() const
+        {
+            return _changes.empty() && _allTiles.empty();
+        }
 
-            if ( !Maps::readMapInEditor( _mapFormat ) ) {
-                // If this assertion blows up then something is really wrong with the Editor.
-                assert( 0 );
-                return false;
+        size_t getMemoryUsage() const
+        {
+            size_t usage = _allTiles.getMemoryUsage();
+
+            for ( const Change & change : _changes ) {
+                usage += sizeof( change.index ) + estimateMemoryUsage( change.before ) + estimateMemoryUsage( change.after );
             }
 
-            Maps::setLastObjectUID( _latestObjectUIDBefore );
+            return usage;
+        }
+
+    private:
+        struct Change
+        {
+            size_t index{ 0 };
+            Maps::Map_Format::TileInfo before;
+            Maps::Map_Format::TileInfo after;
+        };
+
+        std::vector<Change> _changes;
+
+        ValueDelta<std::vector<Maps::Map_Format::TileInfo>> _allTiles;
+    };
+
+    // Holds the difference between two states of the map. If a new member is added to MapFormat it must be added here as well.
+    class MapDelta
+    {
+    public:
+        void create( const Maps::Map_Format::MapFormat & before, const Maps::Map_Format::MapFormat & after )
+        {
+            _baseMap.create( before, after );
+            _additionalInfo.create( before.additionalInfo, after.additionalInfo );
+            _tiles.create( before.tiles, after.tiles );
+            _dailyEvents.create( before.dailyEvents, after.dailyEvents );
+            _rumors.create( before.rumors, after.rumors );
+            _castleMetadata.create( before.castleMetadata, after.castleMetadata );
+            _heroMetadata.create( before.heroMetadata, after.heroMetadata );
+            _sphinxMetadata.create( before.sphinxMetadata, after.sphinxMetadata );
+            _signMetadata.create( before.signMetadata, after.signMetadata );
+            _adventureMapEventMetadata.create( before.adventureMapEventMetadata, after.adventureMapEventMetadata );
+            _selectionObjectMetadata.create( before.selectionObjectMetadata, after.selectionObjectMetadata );
+            _capturableObjectsMetadata.create( before.capturableObjectsMetadata, after.capturableObjectsMetadata );
+            _monsterMetadata.create( before.monsterMetadata, after.monsterMetadata );
+            _artifactMetadata.create( before.artifactMetadata, after.artifactMetadata );
+            _resourceMetadata.create( before.resourceMetadata, after.resourceMetadata );
+            _translationInfo.create( before.translationInfo, after.translationInfo );
+        }
+
+        void apply( Maps::Map_Format::MapFormat & map, const bool isRedo ) const
+        {
+            _baseMap.apply( map, isRedo );
+            _additionalInfo.apply( map.additionalInfo, isRedo );
+            _tiles.apply( map.tiles, isRedo );
+            _dailyEvents.apply( map.dailyEvents, isRedo );
+            _rumors.apply( map.rumors, isRedo );
+            _castleMetadata.apply( map.castleMetadata, isRedo );
+            _heroMetadata.apply( map.heroMetadata, isRedo );
+            _sphinxMetadata.apply( map.sphinxMetadata, isRedo );
+            _signMetadata.apply( map.signMetadata, isRedo );
+            _adventureMapEventMetadata.apply( map.adventureMapEventMetadata, isRedo );
+            _selectionObjectMetadata.apply( map.selectionObjectMetadata, isRedo );
+            _capturableObjectsMetadata.apply( map.capturableObjectsMetadata, isRedo );
+            _monsterMetadata.apply( map.monsterMetadata, isRedo );
+            _artifactMetadata.apply( map.artifactMetadata, isRedo );
+            _resourceMetadata.apply( map.resourceMetadata, isRedo );
+            _translationInfo.apply( map.translationInfo, isRedo );
+        }
+
+        bool empty() const
+        {
+            return _baseMap.empty() && _additionalInfo.empty() && _tiles.empty() && _dailyEvents.empty() && _rumors.empty() && _castleMetadata.empty()
+                   && _heroMetadata.empty() && _sphinxMetadata.empty() && _signMetadata.empty() && _adventureMapEventMetadata.empty()
+                   && _selectionObjectMetadata.empty() && _capturableObjectsMetadata.empty() && _monsterMetadata.empty() && _artifactMetadata.empty()
+                   && _resourceMetadata.empty() && _translationInfo.empty();
+        }
 
-            return true;
+        size_t getMemoryUsage() const
+        {
+            return _baseMap.getMemoryUsage() + _additionalInfo.getMemoryUsage() + _tiles.getMemoryUsage() + _dailyEvents.getMemoryUsage() + _rumors.getMemoryUsage()
+                   + _castleMetadata.getMemoryUsage() + _heroMetadata.getMemoryUsage() + _sphinxMetadata.getMemoryUsage() + _signMetadata.getMemoryUsage()
+                   + _adventureMapEventMetadata.getMemoryUsage() + _selectionObjectMetadata.getMemoryUsage() + _capturableObjectsMetadata.getMemoryUsage()
+                   + _monsterMetadata.getMemoryUsage() + _artifactMetadata.getMemoryUsage() + _resourceMetadata.getMemoryUsage() + _translationInfo.getMemoryUsage();
+        }
+
+    private:
+        ValueDelta<Maps::Map_Format::BaseMapFormat> _baseMap;
+        ValueDelta<std::vector<uint32_t>> _additionalInfo;
+        TileDelta _tiles;
+        ValueDelta<std::vector<Maps::Map_Format::DailyEvent>> _dailyEvents;
+        ValueDelta<std::vector<std::string>> _rumors;
+        MetadataDelta<uint32_t, Maps::Map_Format::CastleMetadata> _castleMetadata;
+        MetadataDelta<uint32_t, Maps::Map_Format::HeroMetadata> _heroMetadata;
+        MetadataDelta<uint32_t, Maps::Map_Format::SphinxMetadata> _sphinxMetadata;
+        MetadataDelta<uint32_t, Maps::Map_Format::SignMetadata> _signMetadata;
+        MetadataDelta<uint32_t, Maps::Map_Format::AdventureMapEventMetadata> _adventureMapEventMetadata;
+        MetadataDelta<uint32_t, Maps::Map_Format::SelectionObjectMetadata> _selectionObjectMetadata;
+        MetadataDelta<uint32_t, Maps::Map_Format::CapturableObjectMetadata> _capturableObjectsMetadata;
+        MetadataDelta<uint32_t, Maps::Map_Format::MonsterMetadata> _monsterMetadata;
+        MetadataDelta<uint32_t, Maps::Map_Format::ArtifactMetadata> _artifactMetadata;
+        MetadataDelta<uint32_t, Maps::Map_Format::ResourceMetadata> _resourceMetadata;
+        MetadataDelta<fheroes2::SupportedLanguage, Maps::Map_Format::TranslationFormat> _translationInfo;
+    };
+
+    bool updateWorld( const Maps::Map_Format::MapFormat & mapFormat, const uint32_t latestObjectUID )
+    {
+        if ( !Maps::readMapInEditor( mapFormat ) ) {
+            // If this assertion blows up then something is really wrong with the Editor.
+            assert( 0 );
+            return false;
+        }
+
+        Maps::setLastObjectUID( latestObjectUID );
+
+        return true;
+    }
+
+    // This class holds only the changed parts of MapFormat object: their state before and after the action.
+    class MapAction final : public fheroes2::Action
+    {
+    public:
+        MapAction( Maps::Map_Format::MapFormat & mapFormat, MapDelta && delta, const uint32_t latestObjectUIDBefore, const uint32_t latestObjectUIDAfter )
+            : _mapFormat( mapFormat )
+            , _delta( std::move( delta ) )
+            , _latestObjectUIDBefore( latestObjectUIDBefore )
+            , _latestObjectUIDAfter( latestObjectUIDAfter )
+        {
+            // Do nothing.
+        }
+
+        // Disable the copy and move (implicitly) constructors and assignment operators.
+        MapAction( const MapAction & ) = delete;
+        MapAction & operator=( const MapAction & ) = delete;
+        ~MapAction() override = default;
+
+        bool redo() override
+        {
+            _delta.apply( _mapFormat, true );
+
+            return updateWorld( _mapFormat, _latestObjectUIDAfter );
+        }
+
+        bool undo() override
+        {
+            _delta.apply( _mapFormat, false );
+
+            return updateWorld( _mapFormat, _latestObjectUIDBefore );
+        }
+
+        size_t getMemoryUsage() const override
+        {
+            return sizeof( MapAction ) + _delta.getMemoryUsage();
         }
 
     private:
         Maps::Map_Format::MapFormat & _mapFormat;
 
-        RWStreamBuf _beforeMapFormat;
-        RWStreamBuf _afterMapFormat;
+        const MapDelta _delta;
 
         const uint32_t _latestObjectUIDBefore{ 0 };
-        uint32_t _latestObjectUIDAfter{ 0 };
+        const uint32_t _latestObjectUIDAfter{ 0 };
     };
 }
 
@@ -117,21 +405,80 @@ namespace fheroes2
 {
     ActionCreator::ActionCreator( HistoryManager & manager, Maps::Map_Format::MapFormat & mapFormat )
         : _manager( manager )
+        , _mapFormat( mapFormat )
+        , _mapState( manager._synchronizeMapState( mapFormat ) )
+        , _latestObjectUIDBefore( Maps::getLastObjectUID() )
+    {
+        // Do nothing.
+    }
+
+    ActionCreator::~ActionCreator()
     {
-        _action = std::make_unique<MapAction>( mapFormat );
+        if ( _isCommitted ) {
+            return;
+        }
+
+        // The action wasn't committed. Undo all the changes.
+        MapDelta delta;
+        delta.create( _mapState, _mapFormat );
+        delta.apply( _mapFormat, false );
+
+        updateWorld( _mapFormat, _latestObjectUIDBefore );
     }
 
     void ActionCreator::commit()
     {
-        auto * action = dynamic_cast<MapAction *>( _action.get() );
-        if ( action == nullptr ) {
+        if ( _isCommitted ) {
             // How is it even possible? Did you call this method twice?
             assert( 0 );
             return;
         }
 
-        if ( action->prepare() ) {
-            _manager.add( std::move( _action ) );
+        _isCommitted = true;
+
+        MapDelta delta;
+        delta.create( _mapState, _mapFormat );
+
+        const uint32_t latestObjectUIDAfter = Maps::getLastObjectUID();
+        if ( delta.empty() && latestObjectUIDAfter == _latestObjectUIDBefore ) {
+            // Nothing has been changed.
+            return;
         }
+
+        delta.apply( _mapState, true );
+
+        _manager.add( std::make_unique<MapAction>( _mapFormat, std::move( delta ), _latestObjectUIDBefore, latestObjectUIDAfter ) );
+    }
+
+    HistoryManager::HistoryManager() = default;
+
+    HistoryManager::~HistoryManager() = default;
+
+    void HistoryManager::reset()
+    {
+        _actions.clear();
+        _lastActionId = 0;
+        _memoryUsage = 0;
+
+        _mapState.reset();
+
+        if ( _stateCallback ) {
+            _stateCallback( false, false );
+        }
+    }
+
+    Maps::Map_Format::MapFormat & HistoryManager::_synchronizeMapState( const Maps::Map_Format::MapFormat & mapFormat )
+    {
+        if ( !_mapState ) {
+            _mapState = std::make_unique<Maps::Map_Format::MapFormat>( mapFormat );
+            return *_mapState;
+        }
+
+        // The map could be changed by undo and redo operations or without the use of the history.
+        MapDelta delta;
+        delta.create( *_mapState, mapFormat );
+        delta.apply( *_mapState, true );
+
+        return *_mapState;
     }
 }
@@ -20,9 +20,9 @@
 
 #pragma once
 
-#include <algorithm>
 #include <cassert>
 #include <cstddef>
+#include <cstdint>
 #include <deque>
 #include <functional>
 #include <memory>
@@ -45,6 +45,9 @@ namespace fheroes2
         virtual bool redo() = 0;
 
         virtual bool undo() = 0;
+
+        // Returns an approximate amount of memory in bytes occupied by the action.
+        virtual size_t getMemoryUsage() const = 0;
     };
 
     // Remember the map state and create an action if the map has changed.
@@ -53,13 +56,7 @@ namespace fheroes2
     public:
         explicit ActionCreator( HistoryManager & manager, Maps::Map_Format::MapFormat & mapFormat );
 
-        ~ActionCreator()
-        {
-            if ( _action ) {
-                // The action wasn't committed. Undo all the changes.
-                _action->undo();
-            }
-        }
+        ~ActionCreator();
 
         ActionCreator( const ActionCreator & ) = delete;
 
@@ -70,45 +67,60 @@ namespace fheroes2
     private:
         HistoryManager & _manager;
 
-        std::unique_ptr<Action> _action;
+        Maps::Map_Format::MapFormat & _mapFormat;
+
+        // The state of the map before the action.
+        Maps::Map_Format::MapFormat & _mapState;
+
+        const uint32_t _latestObjectUIDBefore{ 0 };
+
+        bool _isCommitted{ false };
     };
 
     class HistoryManager
     {
     public:
+        HistoryManager();
+
+        HistoryManager( const HistoryManager & ) = delete;
+
+        ~HistoryManager();
+
+        HistoryManager & operator=( const HistoryManager & ) = delete;
+
         void setStateCallback( std::function<void( const bool, const bool )> stateCallback )
         {
             _stateCallback = std::move( stateCallback );
         }
 
-        void reset()
+        void reset();
+
+        void add( std::unique_ptr<Action> action )
         {
-            _actions.clear();
-            _lastActionId = 0;
+            assert( action );
 
-            if ( _stateCallback ) {
-                _stateCallback( false, false );
+            while ( _actions.size() > _lastActionId ) {
+                _memoryUsage -= _actions.back()->getMemoryUsage();
+                _actions.pop_back();
             }
-        }
 
-        void add( std::unique_ptr<Action> action )
-        {
-            _actions.resize( _lastActionId );
+            _memoryUsage += action->getMemoryUsage();
 
             _actions.push_back( std::move( action ) );
 
             ++_lastActionId;
 
-            if ( _actions.size() > maxActions ) {
-                --_lastActionId;
+            // Remove the oldest actions to fit into the memory limit. The latest action is always kept.
+            while ( _memoryUsage > maxMemoryUsage && _actions.size() > 1 ) {
+                _memoryUsage -= _actions.front()->getMemoryUsage();
                 _actions.pop_front();
+
+                --_lastActionId;
             }
 
             if ( _stateCallback ) {
                 _stateCallback( isUndoAvailable(), isRedoAvailable() );
             }
-
-            assert( _actions.size() <= maxActions );
         }
 
         bool isUndoAvailable() const
@@ -156,13 +168,24 @@ namespace fheroes2
         }
 
     private:
-        // We shouldn't store too many actions. It is extremely rare when there is a need to revert so many changes.
-        static const size_t maxActions{ 999 };
+        friend class ActionCreator;
+
+        // Returns the copy of the map which is kept identical to the given map. Only the changed parts of the map are copied.
+        Maps::Map_Format::MapFormat & _synchronizeMapState( const Maps::Map_Format::MapFormat & mapFormat );
+
+        // Actions store only the changed parts of the map so most of them are tiny while some (like a map generation) can be huge.
+        // That is why the history is limited by the memory it occupies rather than by the number of actions.
+        static const size_t maxMemoryUsage{ 64 * 1024 * 1024 };
 
         std::deque<std::unique_ptr<Action>> _actions;
 
         size_t _lastActionId{ 0 };
 
+        size_t _memoryUsage{ 0 };
+
+        // The copy of the map after the latest change registered by the manager.
+        std::unique_ptr<Maps::Map_Format::MapFormat> _mapState;
+
         std::function<void( const bool, const bool )> _stateCallback;
     };
 }
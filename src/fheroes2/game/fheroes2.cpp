@@ -21,6 +21,9 @@
  *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
  ***************************************************************************/
 
+#include <algorithm>
+#include <array>
+#include <charconv>
 #include <cstdint>
 #include <cstdlib>
 #include <exception>
@@ -31,6 +34,8 @@
 #include <memory>
 #include <set>
 #include <string>
+#include <string_view>
+#include <system_error>
 #include <vector>
 
 // Managing compiler warnings for SDL headers
@@ -65,6 +70,9 @@
 #include "embedded_image.h"
 #include "exception.h"
 #include "game.h"
+#include "game_ai_benchmark.h"
+#include "game_battle_simulator.h"
+#include "game_io.h"
 #include "game_logo.h"
 #include "game_video.h"
 #include "game_video_type.h"
@@ -264,6 +272,72 @@ namespace
         std::unique_ptr<fheroes2::h2d::H2DInitializer> _h2dInitializer;
     };
 
+    // A mode running the game code without the game window, requested by the following command line: fheroes <flag> <file> [count]
+    struct HeadlessMode
+    {
+        const char * flag;
+        const char * fileDescription;
+        const char * countDescription;
+        uint32_t defaultCount;
+        bool ( *run )( const std::string & filePath, const uint32_t count );
+    };
+
+    const std::array<HeadlessMode, 4> headlessModes{ { { "--ai-benchmark", "map file", "number of days", 28, Game::runAIBenchmark },
+                                                       { "--pathfinder-benchmark", "map file", "number of repetitions", 10, Game::runPathfinderBenchmark },
+                                                       { "--serialize-benchmark", "map file", "number of repetitions", 100, Game::runSerializationBenchmark },
+                                                       { "--battle-simulator", "battle description file", "number of battles", 1000, Game::runBattleSimulator } } };
+
+    const HeadlessMode * findHeadlessMode( const int argc, char ** argv )
+    {
+        if ( argc < 2 ) {
+            return nullptr;
+        }
+
+        const std::string flag( argv[1] );
+
+        const auto iter = std::find_if( headlessModes.begin(), headlessModes.end(), [&flag]( const HeadlessMode & mode ) { return flag == mode.flag; } );
+        return ( iter == headlessModes.end() ) ? nullptr : &( *iter );
+    }
+
+    // Initializes the game data required to load maps without creating the game window and without initializing the audio subsystem
+    // and runs the requested mode while the initializers are alive.
+    int runHeadlessMode( const HeadlessMode & mode, const int argc, char ** argv )
+    {
+        if ( argc < 3 || argc > 4 ) {
+            ERROR_LOG( "Usage: fheroes " << mode.flag << " <" << mode.fileDescription << "> [" << mode.countDescription << ", " << mode.defaultCount
+                                         << " by default]" )
+            return EXIT_FAILURE;
+        }
+
+        const std::string filePath( argv[2] );
+        uint32_t count = mode.defaultCount;
+
+        if ( argc == 4 ) {
+            const std::string_view countStr( argv[3] );
+
+            const auto [ptr, ec] = std::from_chars( countStr.data(), countStr.data() + countStr.size(), count );
+            if ( ptr != countStr.data() + countStr.size() || ec != std::errc() || count == 0 ) {
+                ERROR_LOG( "Invalid " << mode.countDescription << ": " << countStr )
+                return EXIT_FAILURE;
+            }
+        }
+
+        const fheroes2::CoreInitializer coreInitializer( {} );
+
+        // Unlike the regular game startup the missing resources window cannot be displayed here, so errors are only logged.
+        const AGG::AGGInitializer aggInitializer;
+        const fheroes2::h2d::H2DInitializer h2dInitializer;
+
+        fheroes2::setGamePalette( AGG::getDataFromAggFile( "KB.PAL", false ) );
+
+        Settings & conf = Settings::Get();
+        conf.setGameLanguage( conf.getGameLanguage() );
+
+        Game::Init();
+
+        return mode.run( filePath, count ) ? EXIT_SUCCESS : EXIT_FAILURE;
+    }
+
     // This function checks for a possible situation when a user uses a demo version
     // of the game. There is no 100% certain way to detect this, so assumptions are made.
     bool isProbablyDemoVersion()
@@ -285,8 +359,6 @@ int main( int argc, char ** argv )
     assert( argc == __argc );
 
     argv = __argv;
-#else
-    (void)argc;
 #endif
 
     try {
@@ -302,6 +374,10 @@ int main( int argc, char ** argv )
         InitDataDir();
         ReadConfigs();
 
+        if ( const HeadlessMode * headlessMode = findHeadlessMode( argc, argv ); headlessMode != nullptr ) {
+            return runHeadlessMode( *headlessMode, argc, argv );
+        }
+
         std::set<fheroes2::SystemInitializationComponent> coreComponents{ fheroes2::SystemInitializationComponent::Audio,
                                                                           fheroes2::SystemInitializationComponent::Video };
 
@@ -359,6 +435,12 @@ int main( int argc, char ** argv )
         // Initialize game data.
         Game::Init();
 
+        // Decode frequently used resources in the background while the intro is being shown.
+        const fheroes2::AGG::ResourcePreloader resourcePreloader( conf.getPreloadedResources() );
+
+        // Make sure that all autosave files are completely written before the exit.
+        const Game::BackgroundSaveFinalizer backgroundSaveFinalizer;
+
         if ( conf.isShowIntro() ) {
             fheroes2::showTeamInfo();
             for ( const char * logo : { "NWCLOGO.SMK", "CYLOGO.SMK", "H2XINTRO.SMK" } ) {
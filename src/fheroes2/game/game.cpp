@@ -67,6 +67,7 @@ namespace
 
     bool updateSoundsOnFocusUpdate = true;
     bool needFadeIn{ true };
+    bool isHeadless{ false };
 
     uint32_t maps_animation_frame = 0;
 }
@@ -190,6 +191,16 @@ bool Game::validateDisplayFadeIn()
     return false;
 }
 
+bool Game::isHeadlessMode()
+{
+    return isHeadless;
+}
+
+void Game::setHeadlessMode( const bool enable )
+{
+    isHeadless = enable;
+}
+
 void Game::Init()
 {
     // set global events
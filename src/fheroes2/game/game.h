@@ -91,6 +91,10 @@ namespace Game
     // If display fade-in state is set reset it to false and return true. Otherwise return false.
     bool validateDisplayFadeIn();
 
+    // Returns true if the game runs without any rendering, e.g. during AI benchmark runs.
+    bool isHeadlessMode();
+    void setHeadlessMode( const bool enable );
+
     PlayerColorsSet GetKingdomColors();
     PlayerColorsSet GetActualKingdomColors();
     void DialogPlayers( const PlayerColor color, std::string title, std::string message );
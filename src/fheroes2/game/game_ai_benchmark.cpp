@@ -0,0 +1,568 @@
+/***************************************************************************
+ *   fheroes2: https://github.com/ihhub/fheroes2                           *
+ *   Copyright (C) 2025                                                    *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
+ ***************************************************************************/
+
+#include "game_ai_benchmark.h"
+
+#include <cassert>
+#include <cstdint>
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "ai_planner.h"
+#include "battle.h"
+#include "castle.h"
+#include "color.h"
+#include "game.h"
+#include "game_io.h"
+#include "game_mode.h"
+#include "heroes.h"
+#include "kingdom.h"
+#include "logging.h"
+#include "maps.h"
+#include "maps_fileinfo.h"
+#include "maps_tiles.h"
+#include "mp2.h"
+#include "players.h"
+#include "save_format_version.h"
+#include "serialize.h"
+#include "settings.h"
+#include "system.h"
+#include "timing.h"
+#include "tools.h"
+#include "ui_language.h"
+#include "world.h"
+#include "world_pathfinding.h"
+
+namespace
+{
+    struct TurnStatistics
+    {
+        double timeMs{ 0 };
+        uint64_t pathfinderEvaluations{ 0 };
+        uint32_t battles{ 0 };
+        uint32_t turns{ 0 };
+
+        TurnStatistics & operator+=( const TurnStatistics & other )
+        {
+            timeMs += other.timeMs;
+            pathfinderEvaluations += other.pathfinderEvaluations;
+            battles += other.battles;
+            turns += other.turns;
+
+            return *this;
+        }
+    };
+
+    void logStatistics( const std::string & prefix, const TurnStatistics & stats )
+    {
+        COUT( prefix << " time_ms=" << stats.timeMs << " pathfinder_evaluations=" << stats.pathfinderEvaluations << " battles=" << stats.battles )
+    }
+
+    bool loadMap( const std::string & mapFilePath )
+    {
+        Settings & conf = Settings::Get();
+
+        const std::string extension = StringLower( mapFilePath.substr( mapFilePath.find_last_of( '.' ) + 1 ) );
+
+        Maps::FileInfo fi;
+        std::vector<uint8_t> homm1MapData;
+
+        if ( extension == "fh2m" ) {
+            if ( !fi.readResurrectionMap( mapFilePath, false, fheroes2::getCurrentLanguage() ) ) {
+                return false;
+            }
+        }
+        else if ( extension == "map" ) {
+            StreamFile fs;
+            if ( !fs.open( mapFilePath, "rb" ) ) {
+                return false;
+            }
+
+            homm1MapData = fs.getRaw( fs.size() );
+            if ( !fi.readHoMM1MapFromBytes( homm1MapData, mapFilePath ) ) {
+                return false;
+            }
+        }
+        else if ( !fi.readMP2Map( mapFilePath, false ) ) {
+            return false;
+        }
+
+        conf.SetGameType( Game::TYPE_STANDARD );
+        conf.setCurrentMapInfo( fi );
+
+        Players & players = conf.GetPlayers();
+        for ( Player * player : players ) {
+            assert( player != nullptr );
+
+            player->SetControl( CONTROL_AI );
+        }
+
+        players.SetStartGame();
+
+        switch ( fi.version ) {
+        case GameVersion::SUCCESSION_WARS:
+        case GameVersion::PRICE_OF_LOYALTY:
+            return world.LoadMapMP2( fi.filename, ( fi.version == GameVersion::SUCCESSION_WARS ) );
+        case GameVersion::HOMM1:
+            return world.loadHoMM1Map( homm1MapData );
+        case GameVersion::RESURRECTION:
+            return world.loadResurrectionMap( fi.filename );
+        default:
+            break;
+        }
+
+        return false;
+    }
+
+    struct PathfinderSource
+    {
+        int32_t index{ -1 };
+        PlayerColor color{ PlayerColor::NONE };
+        double armyStrength{ 0 };
+    };
+
+    struct PathfinderRunResult
+    {
+        double timeMs{ 0 };
+        uint64_t nodeExpansions{ 0 };
+        uint64_t evaluations{ 0 };
+        std::vector<uint32_t> distances;
+    };
+
+    // Runs the given queries the given number of times and collects the distances found during the last run
+    template <typename Query>
+    PathfinderRunResult runPathfinderQueries( const uint32_t repetitions, const Query & query )
+    {
+        PathfinderRunResult result;
+
+        const uint64_t nodeExpansionsBefore = WorldPathfinder::getNodeExpansionCount();
+        const uint64_t evaluationsBefore = WorldPathfinder::getEvaluationCount();
+        const fheroes2::Time time;
+
+        for ( uint32_t i = 0; i < repetitions; ++i ) {
+            result.distances.clear();
+
+            query( result.distances );
+        }
+
+        result.timeMs = time.getS() * 1000;
+        result.nodeExpansions = WorldPathfinder::getNodeExpansionCount() - nodeExpansionsBefore;
+        result.evaluations = WorldPathfinder::getEvaluationCount() - evaluationsBefore;
+
+        return result;
+    }
+
+    void logPathfinderRun( const std::string & algorithm, const std::string & queryType, const PathfinderRunResult & result )
+    {
+        COUT( "algorithm=" << algorithm << " query=" << queryType << " time_ms=" << result.timeMs << " evaluations=" << result.evaluations
+                           << " node_expansions=" << result.nodeExpansions )
+    }
+
+    size_t countMismatches( const std::vector<uint32_t> & first, const std::vector<uint32_t> & second )
+    {
+        assert( first.size() == second.size() );
+
+        size_t mismatches = 0;
+
+        for ( size_t i = 0; i < first.size(); ++i ) {
+            if ( first[i] != second[i] ) {
+                ++mismatches;
+            }
+        }
+
+        return mismatches;
+    }
+
+    struct SerializationRunResult
+    {
+        double saveTimeMs{ 0 };
+        double loadTimeMs{ 0 };
+        std::vector<uint8_t> savedData;
+        bool failed{ false };
+    };
+
+    // Saves the given data and loads it back the given number of times using big-endian streams like save files do.
+    // The saved bytes and the loaded data of the last run are kept for verification.
+    template <typename Data, typename Saver, typename Loader>
+    SerializationRunResult runSerialization( const uint32_t repetitions, const Data & data, Data & loadedData, const Saver & saver, const Loader & loader )
+    {
+        SerializationRunResult result;
+
+        for ( uint32_t i = 0; i < repetitions; ++i ) {
+            RWStreamBuf stream;
+            stream.setBigendian( true );
+
+            const fheroes2::Time saveTime;
+            saver( stream, data );
+            result.saveTimeMs += saveTime.getS() * 1000;
+
+            result.savedData.assign( stream.data(), stream.data() + stream.size() );
+
+            const fheroes2::Time loadTime;
+            loader( stream, loadedData );
+            result.loadTimeMs += loadTime.getS() * 1000;
+
+            if ( stream.fail() || stream.size() != 0 ) {
+                result.failed = true;
+            }
+        }
+
+        return result;
+    }
+
+    void logSerializationRun( const std::string & path, const std::string & dataType, const uint32_t repetitions, const SerializationRunResult & result )
+    {
+        COUT( "path=" << path << " data=" << dataType << " bytes=" << result.savedData.size() << " save_time_ms=" << result.saveTimeMs
+                      << " load_time_ms=" << result.loadTimeMs << " round_trip_time_ms_per_run=" << ( result.saveTimeMs + result.loadTimeMs ) / repetitions )
+    }
+
+    template <typename Data, typename Saver>
+    std::vector<uint8_t> saveData( const Data & data, const Saver & saver )
+    {
+        RWStreamBuf stream;
+        stream.setBigendian( true );
+
+        saver( stream, data );
+
+        return { stream.data(), stream.data() + stream.size() };
+    }
+}
+
+bool Game::runAIBenchmark( const std::string & mapFilePath, const uint32_t days )
+{
+    if ( !loadMap( mapFilePath ) ) {
+        ERROR_LOG( "Failed to load map " << mapFilePath )
+        return false;
+    }
+
+    Settings & conf = Settings::Get();
+
+    // Hide AI movements so that no animation is played even if the rendering is somehow requested.
+    const int aiMoveSpeed = conf.AIMoveSpeed();
+    conf.SetAIMoveSpeed( 0 );
+
+    Game::setHeadlessMode( true );
+
+    const std::vector<Player *> & players = conf.GetPlayers().getVector();
+
+    for ( const Player * player : players ) {
+        world.ClearFog( player->GetColor() );
+    }
+
+    COUT( "AI benchmark: map=" << System::GetFileName( mapFilePath ) << " size=" << world.w() << "x" << world.h() << " kingdoms=" << players.size()
+                               << " days=" << days )
+
+    std::map<PlayerColor, TurnStatistics> kingdomTotals;
+    TurnStatistics total;
+
+    const fheroes2::Time benchmarkTime;
+
+    fheroes2::GameMode res = fheroes2::GameMode::END_TURN;
+
+    for ( uint32_t day = 0; day < days && res == fheroes2::GameMode::END_TURN; ++day ) {
+        world.NewDay();
+
+        TurnStatistics dayTotal;
+        int activeKingdoms = 0;
+
+        for ( const Player * player : players ) {
+            const PlayerColor playerColor = player->GetColor();
+            Kingdom & kingdom = world.GetKingdom( playerColor );
+
+            if ( !kingdom.isPlay() ) {
+                continue;
+            }
+
+            conf.SetCurrentColor( playerColor );
+
+            const uint64_t pathfinderEvaluationsBefore = WorldPathfinder::getEvaluationCount();
+            const uint32_t battlesBefore = Battle::getBattleCount();
+            const fheroes2::Time turnTime;
+
+            kingdom.ActionNewDayResourceUpdate( nullptr );
+            kingdom.ActionBeforeTurn();
+
+            res = AI::Planner::Get().KingdomTurn( kingdom );
+            assert( res != fheroes2::GameMode::CANCEL );
+
+            TurnStatistics turnStats;
+            turnStats.timeMs = turnTime.getS() * 1000;
+            turnStats.pathfinderEvaluations = WorldPathfinder::getEvaluationCount() - pathfinderEvaluationsBefore;
+            turnStats.battles = Battle::getBattleCount() - battlesBefore;
+            turnStats.turns = 1;
+
+            logStatistics( "day=" + std::to_string( world.CountDay() ) + " kingdom=" + Color::String( playerColor ), turnStats );
+
+            dayTotal += turnStats;
+            kingdomTotals[playerColor] += turnStats;
+
+            if ( kingdom.isPlay() ) {
+                ++activeKingdoms;
+            }
+
+            if ( res != fheroes2::GameMode::END_TURN ) {
+                COUT( "AI benchmark: the game is over." )
+                break;
+            }
+        }
+
+        conf.SetCurrentColor( PlayerColor::NONE );
+
+        logStatistics( "day=" + std::to_string( world.CountDay() ) + " total", dayTotal );
+
+        total += dayTotal;
+
+        if ( activeKingdoms < 2 ) {
+            COUT( "AI benchmark: only " << activeKingdoms << " kingdom(s) left, stopping." )
+            break;
+        }
+    }
+
+    for ( const auto & [color, stats] : kingdomTotals ) {
+        logStatistics( "summary kingdom=" + Color::String( color ) + " turns=" + std::to_string( stats.turns ), stats );
+    }
+
+    logStatistics( "summary total days=" + std::to_string( world.CountDay() ) + " wall_time_ms=" + std::to_string( benchmarkTime.getMs() ), total );
+
+    Game::setHeadlessMode( false );
+    conf.SetAIMoveSpeed( aiMoveSpeed );
+
+    return true;
+}
+
+bool Game::runPathfinderBenchmark( const std::string & mapFilePath, const uint32_t repetitions )
+{
+    if ( !loadMap( mapFilePath ) ) {
+        ERROR_LOG( "Failed to load map " << mapFilePath )
+        return false;
+    }
+
+    const std::vector<Player *> & players = Settings::Get().GetPlayers().getVector();
+
+    std::vector<PathfinderSource> sources;
+    std::vector<const Heroes *> heroes;
+
+    for ( const Player * player : players ) {
+        const PlayerColor playerColor = player->GetColor();
+
+        world.ClearFog( playerColor );
+
+        const Kingdom & kingdom = world.GetKingdom( playerColor );
+
+        for ( const Castle * castle : kingdom.GetCastles() ) {
+            sources.push_back( { castle->GetIndex(), playerColor, castle->GetArmy().GetStrength() } );
+        }
+
+        for ( const Heroes * hero : kingdom.GetHeroes() ) {
+            sources.push_back( { hero->GetIndex(), playerColor, hero->GetArmy().GetStrength() } );
+            heroes.push_back( hero );
+        }
+    }
+
+    const MapsIndexes targets = Maps::GetObjectPositions( MP2::OBJ_CASTLE );
+
+    COUT( "Pathfinder benchmark: map=" << System::GetFileName( mapFilePath ) << " size=" << world.w() << "x" << world.h() << " sources=" << sources.size()
+                                       << " heroes=" << heroes.size() << " targets=" << targets.size() << " repetitions=" << repetitions )
+
+    // Every query starts from scratch to measure the cost of a single search
+    const auto fullMapQuery = [&sources]( std::vector<uint32_t> & distances ) {
+        AIWorldPathfinder pathfinder;
+
+        for ( const PathfinderSource & source : sources ) {
+            pathfinder.reset();
+            pathfinder.reEvaluateIfNeeded( source.index, source.color, source.armyStrength, Skill::Level::EXPERT );
+
+            for ( size_t i = 0; i < world.getSize(); ++i ) {
+                distances.push_back( pathfinder.getDistance( static_cast<int32_t>( i ) ) );
+            }
+        }
+    };
+
+    const auto heroQuery = [&heroes]( std::vector<uint32_t> & distances ) {
+        AIWorldPathfinder pathfinder;
+
+        for ( const Heroes * hero : heroes ) {
+            pathfinder.reset();
+            pathfinder.reEvaluateIfNeeded( *hero );
+
+            for ( size_t i = 0; i < world.getSize(); ++i ) {
+                distances.push_back( pathfinder.getDistance( static_cast<int32_t>( i ) ) );
+            }
+        }
+    };
+
+    const auto singleTargetQuery = [&sources, &targets]( std::vector<uint32_t> & distances ) {
+        AIWorldPathfinder pathfinder;
+
+        for ( const PathfinderSource & source : sources ) {
+            for ( const int32_t target : targets ) {
+                pathfinder.reset();
+                distances.push_back( pathfinder.getDistance( source.index, target, source.color, source.armyStrength ) );
+            }
+        }
+    };
+
+    const std::vector<std::pair<WorldPathfinder::ExplorationAlgorithm, std::string>> algorithms{ { WorldPathfinder::ExplorationAlgorithm::LABEL_CORRECTING,
+                                                                                                   "label_correcting" },
+                                                                                                 { WorldPathfinder::ExplorationAlgorithm::DIJKSTRA, "dijkstra" } };
+
+    std::vector<std::vector<PathfinderRunResult>> results;
+
+    for ( const auto & [algorithm, name] : algorithms ) {
+        WorldPathfinder::setExplorationAlgorithm( algorithm );
+
+        std::vector<PathfinderRunResult> & algorithmResults = results.emplace_back();
+
+        algorithmResults.push_back( runPathfinderQueries( repetitions, fullMapQuery ) );
+        logPathfinderRun( name, "full_map", algorithmResults.back() );
+
+        algorithmResults.push_back( runPathfinderQueries( repetitions, heroQuery ) );
+        logPathfinderRun( name, "hero_full_map", algorithmResults.back() );
+
+        algorithmResults.push_back( runPathfinderQueries( repetitions, singleTargetQuery ) );
+        logPathfinderRun( name, "single_target", algorithmResults.back() );
+    }
+
+    WorldPathfinder::setExplorationAlgorithm( WorldPathfinder::ExplorationAlgorithm::DIJKSTRA );
+
+    // Both algorithms should find paths of the same cost, although paths themselves may differ when there are several paths of the same cost
+    assert( results.size() == 2 );
+
+    const std::vector<std::string> queryTypes{ "full_map", "hero_full_map", "single_target" };
+
+    for ( size_t i = 0; i < queryTypes.size(); ++i ) {
+        COUT( "query=" << queryTypes[i] << " distances=" << results[0][i].distances.size()
+                       << " mismatches=" << countMismatches( results[0][i].distances, results[1][i].distances ) )
+    }
+
+    return true;
+}
+
+bool Game::runSerializationBenchmark( const std::string & mapFilePath, const uint32_t repetitions )
+{
+    if ( !loadMap( mapFilePath ) ) {
+        ERROR_LOG( "Failed to load map " << mapFilePath )
+        return false;
+    }
+
+    // Make some fog uncovered so that not all fog values are the same.
+    for ( const Player * player : Settings::Get().GetPlayers().getVector() ) {
+        const PlayerColor playerColor = player->GetColor();
+
+        for ( const Heroes * hero : world.GetKingdom( playerColor ).GetHeroes() ) {
+            hero->Scout( hero->GetIndex() );
+        }
+    }
+
+    std::vector<Maps::Tile> tiles;
+    std::vector<PlayerColorsSet> fog;
+
+    tiles.reserve( world.getSize() );
+    fog.reserve( world.getSize() );
+
+    for ( size_t i = 0; i < world.getSize(); ++i ) {
+        const Maps::Tile & tile = world.getTile( static_cast<int32_t>( i ) );
+
+        tiles.push_back( tile );
+        fog.push_back( tile.getFogColors() );
+    }
+
+    COUT( "Serialization benchmark: map=" << System::GetFileName( mapFilePath ) << " size=" << world.w() << "x" << world.h() << " repetitions=" << repetitions )
+
+    // The per-element tile loading depends on the version of the save file being loaded.
+    const uint16_t saveFileVersion = Game::GetVersionOfCurrentSaveFile();
+    Game::SetVersionOfCurrentSaveFile( CURRENT_FORMAT_VERSION );
+
+    const auto saveTilesPerElement = []( OStreamBase & stream, const std::vector<Maps::Tile> & data ) {
+        stream.put32( static_cast<uint32_t>( data.size() ) );
+
+        for ( const Maps::Tile & tile : data ) {
+            stream << tile;
+        }
+    };
+
+    const auto loadTilesPerElement = []( IStreamBase & stream, std::vector<Maps::Tile> & data ) {
+        data.clear();
+        data.resize( stream.get32() );
+
+        for ( Maps::Tile & tile : data ) {
+            stream >> tile;
+        }
+    };
+
+    const auto saveTilesBulk = []( OStreamBase & stream, const std::vector<Maps::Tile> & data ) { Maps::saveTiles( stream, data ); };
+    const auto loadTilesBulk = []( IStreamBase & stream, std::vector<Maps::Tile> & data ) { Maps::loadTiles( stream, data ); };
+
+    const auto saveFogPerElement = []( OStreamBase & stream, const std::vector<PlayerColorsSet> & data ) {
+        stream.put32( static_cast<uint32_t>( data.size() ) );
+
+        for ( const PlayerColorsSet value : data ) {
+            stream << value;
+        }
+    };
+
+    const auto loadFogPerElement = []( IStreamBase & stream, std::vector<PlayerColorsSet> & data ) {
+        data.resize( stream.get32() );
+
+        for ( PlayerColorsSet & value : data ) {
+            stream >> value;
+        }
+    };
+
+    // Vectors of integers are written and read using putArray() and getArray().
+    const auto saveFogBulk = []( OStreamBase & stream, const std::vector<PlayerColorsSet> & data ) { stream << data; };
+    const auto loadFogBulk = []( IStreamBase & stream, std::vector<PlayerColorsSet> & data ) { stream >> data; };
+
+    std::vector<Maps::Tile> perElementTiles;
+    std::vector<Maps::Tile> bulkTiles;
+    std::vector<PlayerColorsSet> perElementFog;
+    std::vector<PlayerColorsSet> bulkFog;
+
+    const SerializationRunResult perElementTilesResult = runSerialization( repetitions, tiles, perElementTiles, saveTilesPerElement, loadTilesPerElement );
+    logSerializationRun( "per_element", "tiles", repetitions, perElementTilesResult );
+
+    const SerializationRunResult bulkTilesResult = runSerialization( repetitions, tiles, bulkTiles, saveTilesBulk, loadTilesBulk );
+    logSerializationRun( "bulk", "tiles", repetitions, bulkTilesResult );
+
+    const SerializationRunResult perElementFogResult = runSerialization( repetitions, fog, perElementFog, saveFogPerElement, loadFogPerElement );
+    logSerializationRun( "per_element", "fog", repetitions, perElementFogResult );
+
+    const SerializationRunResult bulkFogResult = runSerialization( repetitions, fog, bulkFog, saveFogBulk, loadFogBulk );
+    logSerializationRun( "bulk", "fog", repetitions, bulkFogResult );
+
+    // Tiles loaded by either path must produce exactly the same bytes as the original tiles in both formats.
+    // The format of fog values is the same for both paths.
+    const bool isTileDataValid = !perElementTilesResult.failed && !bulkTilesResult.failed
+                                 && saveData( perElementTiles, saveTilesPerElement ) == perElementTilesResult.savedData
+                                 && saveData( bulkTiles, saveTilesPerElement ) == perElementTilesResult.savedData
+                                 && saveData( perElementTiles, saveTilesBulk ) == bulkTilesResult.savedData
+                                 && saveData( bulkTiles, saveTilesBulk ) == bulkTilesResult.savedData;
+
+    const bool isFogDataValid = !perElementFogResult.failed && !bulkFogResult.failed && perElementFogResult.savedData == bulkFogResult.savedData
+                                && perElementFog == fog && bulkFog == fog;
+
+    Game::SetVersionOfCurrentSaveFile( saveFileVersion );
+
+    COUT( "tiles=" << ( isTileDataValid ? "identical" : "MISMATCH" ) << " fog=" << ( isFogDataValid ? "identical" : "MISMATCH" ) )
+
+    return isTileDataValid && isFogDataValid;
+}
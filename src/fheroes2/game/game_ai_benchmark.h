@@ -0,0 +1,42 @@
+/***************************************************************************
+ *   fheroes2: https://github.com/ihhub/fheroes2                           *
+ *   Copyright (C) 2025                                                    *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
+ ***************************************************************************/
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+namespace Game
+{
+    // Loads the given map (.mp2, .mx2, .fh2m or .map file), gives control over all kingdoms to AI and runs the game for the
+    // given number of days (or until only one kingdom is left) without any rendering. The per-day and per-kingdom timing
+    // report is written to the log. Returns false if the map could not be loaded.
+    bool runAIBenchmark( const std::string & mapFilePath, const uint32_t days );
+
+    // Loads the given map and compares the current world pathfinder exploration algorithm with the original label-correcting one
+    // by the number of processed tiles and the time spent on full map evaluations and on single target distance queries from
+    // every castle and hero on the map. Returns false if the map could not be loaded.
+    bool runPathfinderBenchmark( const std::string & mapFilePath, const uint32_t repetitions );
+
+    // Loads the given map and saves and loads back its tiles and fog both value by value and through the bulk serialization
+    // path the given number of times. The time spent on every path is written to the log. Returns false if the map could not
+    // be loaded or if the data loaded by either path does not match the original data byte by byte.
+    bool runSerializationBenchmark( const std::string & mapFilePath, const uint32_t repetitions );
+}
@@ -0,0 +1,605 @@
+/***************************************************************************
+ *   fheroes2: https://github.com/ihhub/fheroes2                           *
+ *   Copyright (C) 2026                                                    *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
+ ***************************************************************************/
+
+#include "game_battle_simulator.h"
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cctype>
+#include <charconv>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <optional>
+#include <ostream>
+#include <string_view>
+#include <system_error>
+#include <utility>
+#include <vector>
+
+#include "ai_battle.h"
+#include "army.h"
+#include "army_troop.h"
+#include "artifact.h"
+#include "battle.h"
+#include "battle_arena.h"
+#include "battle_army.h"
+#include "battle_troop.h"
+#include "castle.h"
+#include "color.h"
+#include "ground.h"
+#include "heroes.h"
+#include "logging.h"
+#include "map_format_info.h"
+#include "maps.h"
+#include "maps_tiles.h"
+#include "monster.h"
+#include "mp2.h"
+#include "players.h"
+#include "race.h"
+#include "rand.h"
+#include "serialize.h"
+#include "settings.h"
+#include "skill.h"
+#include "spell.h"
+#include "thread.h"
+#include "timing.h"
+#include "tools.h"
+#include "world.h"
+
+namespace
+{
+    // The battle takes place on the same tile as in the Battle Only mode.
+    const int32_t battleTileIndex = 1;
+
+    const std::array<PlayerColor, 2> armyColors{ PlayerColor::BLUE, PlayerColor::RED };
+    const std::array<int, 2> armyHeroIds{ Heroes::LORDKILBURN, Heroes::SIRGALLANTH };
+
+    struct HeroSpec
+    {
+        int race{ Race::NONE };
+        int attack{ 0 };
+        int defense{ 0 };
+        int power{ 0 };
+        int knowledge{ 0 };
+        std::vector<Skill::Secondary> skills;
+        std::vector<int32_t> artifacts;
+        std::vector<int32_t> spells;
+    };
+
+    struct ArmySpec
+    {
+        std::optional<HeroSpec> hero;
+        std::vector<std::pair<int32_t, uint32_t>> troops;
+    };
+
+    struct BattleSpec
+    {
+        int32_t terrain{ Maps::Ground::GRASS };
+        bool isSiege{ false };
+        int castleRace{ Race::NONE };
+        bool hasMoat{ false };
+        bool hasTurrets{ false };
+        uint32_t seed{ 0 };
+        std::array<ArmySpec, 2> armies;
+    };
+
+    struct BattleOutcome
+    {
+        uint32_t attackerResult{ 0 };
+        uint32_t defenderResult{ 0 };
+        uint32_t turns{ 0 };
+        std::array<uint32_t, 2> survivors{ 0, 0 };
+    };
+
+    // Converts the name to the form used in battle descriptions: lowercase, with underscores instead of spaces.
+    std::string normalizeName( const std::string_view name )
+    {
+        std::string result( name );
+
+        std::transform( result.begin(), result.end(), result.begin(), []( const unsigned char c ) {
+            if ( std::isspace( c ) ) {
+                return '_';
+            }
+
+            return static_cast<char>( std::tolower( c ) );
+        } );
+
+        return result;
+    }
+
+    // Returns the first of the given IDs whose name matches the given name, or std::nullopt if there is no such ID.
+    template <typename Ids, typename NameGetter>
+    std::optional<int32_t> findIdByName( const std::string & name, const Ids & ids, const NameGetter & getName )
+    {
+        const std::string normalizedName = normalizeName( name );
+
+        for ( const int32_t id : ids ) {
+            if ( normalizeName( getName( id ) ) == normalizedName ) {
+                return id;
+            }
+        }
+
+        return {};
+    }
+
+    std::vector<int32_t> getIdRange( const int32_t first, const int32_t last )
+    {
+        std::vector<int32_t> ids;
+        ids.reserve( static_cast<size_t>( last - first ) );
+
+        for ( int32_t id = first; id < last; ++id ) {
+            ids.push_back( id );
+        }
+
+        return ids;
+    }
+
+    std::optional<int32_t> findRace( const std::string & name )
+    {
+        return findIdByName( name, std::array<int32_t, 4>{ Race::KNGT, Race::BARB, Race::SORC, Race::WRLK }, []( const int32_t race ) { return Race::String( race ); } );
+    }
+
+    std::optional<int32_t> findTerrain( const std::string & name )
+    {
+        return findIdByName( name,
+                             std::array<int32_t, 8>{ Maps::Ground::GRASS, Maps::Ground::SNOW, Maps::Ground::SWAMP, Maps::Ground::LAVA, Maps::Ground::DESERT,
+                                                     Maps::Ground::DIRT, Maps::Ground::WASTELAND, Maps::Ground::BEACH },
+                             []( const int32_t terrain ) { return Maps::Ground::String( terrain ); } );
+    }
+
+    std::optional<int32_t> findSecondarySkill( const std::string & name )
+    {
+        return findIdByName( name, getIdRange( Skill::Secondary::PATHFINDING, Skill::Secondary::ESTATES + 1 ),
+                             []( const int32_t skill ) { return Skill::Secondary::String( skill ); } );
+    }
+
+    std::optional<int32_t> findArtifact( const std::string & name )
+    {
+        std::vector<int32_t> ids = getIdRange( Artifact::UNKNOWN + 1, Artifact::ARTIFACT_COUNT );
+        ids.erase( std::remove_if( ids.begin(), ids.end(), []( const int32_t id ) { return !Artifact( id ).isValid(); } ), ids.end() );
+
+        return findIdByName( name, ids, []( const int32_t id ) { return Artifact( id ).GetName(); } );
+    }
+
+    std::optional<int32_t> findSpell( const std::string & name )
+    {
+        return findIdByName( name, Spell::getAllSpellIdsSuitableForSpellBook(), []( const int32_t id ) { return Spell( id ).GetName(); } );
+    }
+
+    std::optional<int32_t> findMonster( const std::string & name )
+    {
+        std::vector<int32_t> ids = getIdRange( Monster::UNKNOWN + 1, Monster::MONSTER_COUNT );
+        ids.erase( std::remove_if( ids.begin(), ids.end(), []( const int32_t id ) { return !Monster( id ).isValid(); } ), ids.end() );
+
+        return findIdByName( name, ids, []( const int32_t id ) { return Monster( id ).GetName(); } );
+    }
+
+    std::optional<int> parseNumber( const std::string & str, const int minValue, const int maxValue )
+    {
+        int value = 0;
+
+        const auto [ptr, ec] = std::from_chars( str.data(), str.data() + str.size(), value );
+        if ( ptr != str.data() + str.size() || ec != std::errc() || value < minValue || value > maxValue ) {
+            return {};
+        }
+
+        return value;
+    }
+
+    bool loadBattleSpec( const std::string & specFilePath, BattleSpec & spec )
+    {
+        StreamFile sf;
+        if ( !sf.open( specFilePath, "rb" ) ) {
+            ERROR_LOG( "Unable to open the battle description file " << specFilePath )
+            return false;
+        }
+
+        ArmySpec * currentArmy = nullptr;
+        size_t lineNumber = 0;
+
+        const auto reportError = [&specFilePath, &lineNumber]( const std::string & message ) {
+            ERROR_LOG( specFilePath << ", line " << lineNumber << ": " << message )
+            return false;
+        };
+
+        for ( const std::string & line : StringSplit( sf.getString(), '\n' ) ) {
+            ++lineNumber;
+
+            const std::string str = StringTrim( line );
+            if ( str.empty() || str[0] == '#' ) {
+                continue;
+            }
+
+            std::vector<std::string> tokens;
+            for ( std::string & token : StringSplit( str, ' ' ) ) {
+                token = StringTrim( std::move( token ) );
+                if ( !token.empty() ) {
+                    tokens.emplace_back( std::move( token ) );
+                }
+            }
+
+            const std::string command = StringLower( tokens.front() );
+            const size_t argCount = tokens.size() - 1;
+
+            if ( command == "attacker" || command == "defender" ) {
+                currentArmy = &spec.armies[command == "attacker" ? 0 : 1];
+                continue;
+            }
+
+            if ( command == "terrain" ) {
+                const std::optional<int32_t> terrain = ( argCount == 1 ) ? findTerrain( tokens[1] ) : std::nullopt;
+                if ( !terrain ) {
+                    return reportError( "invalid terrain" );
+                }
+
+                spec.terrain = *terrain;
+                continue;
+            }
+
+            if ( command == "siege" ) {
+                const std::optional<int32_t> race = ( argCount >= 1 ) ? findRace( tokens[1] ) : std::nullopt;
+                if ( !race ) {
+                    return reportError( "invalid castle race" );
+                }
+
+                spec.isSiege = true;
+                spec.castleRace = *race;
+
+                for ( size_t i = 2; i < tokens.size(); ++i ) {
+                    const std::string option = StringLower( tokens[i] );
+                    if ( option == "moat" ) {
+                        spec.hasMoat = true;
+                    }
+                    else if ( option == "turrets" ) {
+                        spec.hasTurrets = true;
+                    }
+                    else {
+                        return reportError( "unknown siege option " + tokens[i] );
+                    }
+                }
+
+                continue;
+            }
+
+            if ( command == "seed" ) {
+                const std::optional<int> seed = ( argCount == 1 ) ? parseNumber( tokens[1], 0, std::numeric_limits<int>::max() ) : std::nullopt;
+                if ( !seed ) {
+                    return reportError( "invalid seed" );
+                }
+
+                spec.seed = static_cast<uint32_t>( *seed );
+                continue;
+            }
+
+            if ( currentArmy == nullptr ) {
+                return reportError( "the '" + command + "' command must follow the 'attacker' or 'defender' command" );
+            }
+
+            if ( command == "troop" ) {
+                const std::optional<int32_t> monster = ( argCount == 2 ) ? findMonster( tokens[1] ) : std::nullopt;
+                const std::optional<int> count = ( argCount == 2 ) ? parseNumber( tokens[2], 1, 1000000 ) : std::nullopt;
+                if ( !monster || !count ) {
+                    return reportError( "invalid troop" );
+                }
+
+                if ( currentArmy->troops.size() >= Army::maximumTroopCount ) {
+                    return reportError( "too many troops" );
+                }
+
+                currentArmy->troops.emplace_back( *monster, static_cast<uint32_t>( *count ) );
+                continue;
+            }
+
+            if ( command == "hero" ) {
+                if ( argCount != 5 ) {
+                    return reportError( "invalid hero" );
+                }
+
+                const std::optional<int32_t> race = findRace( tokens[1] );
+                std::array<std::optional<int>, 4> primarySkills;
+
+                for ( size_t i = 0; i < primarySkills.size(); ++i ) {
+                    primarySkills[i] = parseNumber( tokens[i + 2], 0, 99 );
+                }
+
+                if ( !race || std::any_of( primarySkills.begin(), primarySkills.end(), []( const std::optional<int> & value ) { return !value; } ) ) {
+                    return reportError( "invalid hero" );
+                }
+
+                HeroSpec & hero = currentArmy->hero.emplace();
+                hero.race = *race;
+                hero.attack = *primarySkills[0];
+                hero.defense = *primarySkills[1];
+                hero.power = *primarySkills[2];
+                hero.knowledge = *primarySkills[3];
+
+                continue;
+            }
+
+            if ( !currentArmy->hero ) {
+                return reportError( "the '" + command + "' command must follow the 'hero' command" );
+            }
+
+            if ( command == "skill" ) {
+                const std::optional<int32_t> skill = ( argCount == 2 ) ? findSecondarySkill( tokens[1] ) : std::nullopt;
+                const std::optional<int> level = ( argCount == 2 ) ? parseNumber( tokens[2], Skill::Level::BASIC, Skill::Level::EXPERT ) : std::nullopt;
+                if ( !skill || !level ) {
+                    return reportError( "invalid secondary skill" );
+                }
+
+                currentArmy->hero->skills.emplace_back( *skill, *level );
+                continue;
+            }
+
+            if ( command == "artifact" ) {
+                const std::optional<int32_t> artifact = ( argCount == 1 ) ? findArtifact( tokens[1] ) : std::nullopt;
+                if ( !artifact ) {
+                    return reportError( "invalid artifact" );
+                }
+
+                currentArmy->hero->artifacts.push_back( *artifact );
+                continue;
+            }
+
+            if ( command == "spell" ) {
+                const std::optional<int32_t> spell = ( argCount == 1 ) ? findSpell( tokens[1] ) : std::nullopt;
+                if ( !spell ) {
+                    return reportError( "invalid spell" );
+                }
+
+                currentArmy->hero->spells.push_back( *spell );
+                continue;
+            }
+
+            return reportError( "unknown command " + tokens.front() );
+        }
+
+        for ( const ArmySpec & army : spec.armies ) {
+            if ( army.troops.empty() ) {
+                ERROR_LOG( specFilePath << ": both the attacking and the defending armies must have troops" )
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    int getArmyRace( const ArmySpec & army )
+    {
+        if ( army.hero ) {
+            return army.hero->race;
+        }
+
+        const int race = Monster( army.troops.front().first ).GetRace();
+
+        return ( race & Race::ALL ) ? race : Race::NONE;
+    }
+
+    // Prepares the world for battles: the battlefield, both players and the castle for sieges. Battles themselves do not modify
+    // the world, so it can then be shared by all threads.
+    void prepareWorld( const BattleSpec & spec )
+    {
+        world.generateBattleOnlyMap( spec.terrain );
+
+        Settings & conf = Settings::Get();
+        conf.GetPlayers().Init( armyColors[0] | armyColors[1] );
+
+        for ( size_t idx = 0; idx < armyColors.size(); ++idx ) {
+            Players::SetPlayerRace( armyColors[idx], getArmyRace( spec.armies[idx] ) );
+            Players::SetPlayerControl( armyColors[idx], CONTROL_AI );
+        }
+
+        world.InitKingdoms();
+
+        if ( !spec.isSiege ) {
+            return;
+        }
+
+        world.addCastle( battleTileIndex, static_cast<uint8_t>( spec.castleRace ), armyColors[1] );
+
+        Castle * castle = world.getCastle( Maps::GetPoint( battleTileIndex ) );
+        assert( castle != nullptr );
+
+        Maps::Map_Format::CastleMetadata metadata;
+        metadata.customBuildings = true;
+        metadata.builtBuildings = { BUILD_CASTLE,       DWELLING_MONSTER1, DWELLING_MONSTER2, DWELLING_MONSTER3,
+                                    DWELLING_MONSTER4, DWELLING_MONSTER5, DWELLING_MONSTER6 };
+
+        if ( spec.hasMoat ) {
+            metadata.builtBuildings.push_back( BUILD_MOAT );
+        }
+
+        if ( spec.hasTurrets ) {
+            metadata.builtBuildings.push_back( BUILD_LEFTTURRET );
+            metadata.builtBuildings.push_back( BUILD_RIGHTTURRET );
+        }
+
+        castle->loadFromResurrectionMap( metadata );
+
+        world.getTile( battleTileIndex ).setMainObjectType( MP2::OBJ_CASTLE );
+    }
+
+    std::unique_ptr<Heroes> createHero( const HeroSpec & spec, const int heroId, const PlayerColor color )
+    {
+        auto hero = std::make_unique<Heroes>( heroId, spec.race );
+
+        hero->SetColor( color );
+
+        hero->setAttackBaseValue( spec.attack );
+        hero->setDefenseBaseValue( spec.defense );
+        hero->setPowerBaseValue( spec.power );
+        hero->setKnowledgeBaseValue( spec.knowledge );
+
+        // Only the secondary skills from the description are taken into account.
+        hero->GetSecondarySkills().ToVector().clear();
+
+        for ( const Skill::Secondary & skill : spec.skills ) {
+            hero->LearnSkill( skill );
+        }
+
+        for ( const int32_t artifact : spec.artifacts ) {
+            hero->PickupArtifact( Artifact( artifact ) );
+        }
+
+        if ( !spec.spells.empty() ) {
+            hero->SpellBookActivate();
+
+            for ( const int32_t spell : spec.spells ) {
+                hero->AppendSpellToBook( Spell( spell ), true );
+            }
+        }
+
+        hero->SetSpellPoints( hero->GetMaxSpellPoints() );
+
+        return hero;
+    }
+
+    uint32_t countSurvivors( const Battle::Force & force )
+    {
+        uint32_t survivors = 0;
+
+        for ( const Battle::Unit * unit : force ) {
+            assert( unit != nullptr );
+
+            // Summoned elementals and mirror images are not a part of the original army.
+            if ( unit->Modes( Battle::CAP_SUMMONELEM | Battle::CAP_MIRRORIMAGE ) ) {
+                continue;
+            }
+
+            survivors += unit->GetCount();
+        }
+
+        return survivors;
+    }
+
+    // Plays one battle between armies built from scratch. Only the world is shared between threads and it is not modified here.
+    BattleOutcome simulateBattle( const BattleSpec & spec, const uint32_t seed )
+    {
+        // Whether AI decides to retreat or surrender depends on the state of the kingdom, and a surrender changes the funds of both
+        // kingdoms which are shared between threads.
+        AI::BattlePlanner::Get().setRetreatAndSurrenderAllowed( false );
+
+        std::array<std::unique_ptr<Heroes>, 2> heroes;
+        std::array<Army, 2> monsterArmies;
+        std::array<Army *, 2> armies{ nullptr, nullptr };
+
+        for ( size_t idx = 0; idx < armies.size(); ++idx ) {
+            const ArmySpec & armySpec = spec.armies[idx];
+
+            if ( armySpec.hero ) {
+                heroes[idx] = createHero( *armySpec.hero, armyHeroIds[idx], armyColors[idx] );
+                armies[idx] = &heroes[idx]->GetArmy();
+            }
+            else {
+                armies[idx] = &monsterArmies[idx];
+                armies[idx]->SetColor( armyColors[idx] );
+            }
+
+            armies[idx]->Clean();
+
+            for ( size_t troopIdx = 0; troopIdx < armySpec.troops.size(); ++troopIdx ) {
+                const auto & [monsterId, count] = armySpec.troops[troopIdx];
+
+                armies[idx]->GetTroop( troopIdx )->Set( Monster( monsterId ), count );
+            }
+        }
+
+        Rand::PCG32 randomGenerator( seed );
+        Battle::Arena arena( *armies[0], *armies[1], battleTileIndex, false, randomGenerator );
+
+        while ( arena.BattleValid() ) {
+            arena.Turns();
+        }
+
+        const Battle::Result & result = arena.GetResult();
+
+        BattleOutcome outcome;
+        outcome.attackerResult = result.attacker;
+        outcome.defenderResult = result.defender;
+        outcome.turns = arena.GetTurnNumber();
+        outcome.survivors = { countSurvivors( arena.getAttackingForce() ), countSurvivors( arena.getDefendingForce() ) };
+
+        return outcome;
+    }
+}
+
+bool Game::runBattleSimulator( const std::string & specFilePath, const uint32_t battles )
+{
+    BattleSpec spec;
+    if ( !loadBattleSpec( specFilePath, spec ) ) {
+        return false;
+    }
+
+    prepareWorld( spec );
+
+    std::vector<BattleOutcome> outcomes( battles );
+
+    const fheroes2::Time simulationTime;
+
+    MultiThreading::parallelFor( outcomes.size(), [&spec, &outcomes]( const size_t idx ) {
+        outcomes[idx] = simulateBattle( spec, spec.seed + static_cast<uint32_t>( idx ) );
+    } );
+
+    const double timeS = simulationTime.getS();
+
+    // The results are summed up in the order of battles, so they do not depend on the number of threads.
+    uint32_t attackerWins = 0;
+    uint32_t defenderWins = 0;
+    uint32_t retreats = 0;
+    uint64_t turns = 0;
+    std::array<uint64_t, 2> survivors{ 0, 0 };
+
+    for ( const BattleOutcome & outcome : outcomes ) {
+        if ( outcome.attackerResult & Battle::RESULT_WINS ) {
+            ++attackerWins;
+        }
+        else if ( outcome.defenderResult & Battle::RESULT_WINS ) {
+            ++defenderWins;
+        }
+
+        if ( ( outcome.attackerResult | outcome.defenderResult ) & Battle::RESULT_RETREAT ) {
+            ++retreats;
+        }
+
+        turns += outcome.turns;
+        survivors[0] += outcome.survivors[0];
+        survivors[1] += outcome.survivors[1];
+    }
+
+    const auto average = [battles]( const uint64_t value ) { return battles > 0 ? static_cast<double>( value ) / battles : 0.0; };
+
+    std::array<uint32_t, 2> initialCounts{ 0, 0 };
+    for ( size_t idx = 0; idx < initialCounts.size(); ++idx ) {
+        for ( const auto & [dummy, count] : spec.armies[idx].troops ) {
+            initialCounts[idx] += count;
+        }
+    }
+
+    COUT( "battles=" << battles << " threads=" << MultiThreading::getParallelThreadCount() << " time_ms=" << timeS * 1000
+                     << " battles_per_second=" << ( timeS > 0 ? battles / timeS : 0.0 ) )
+    COUT( "attacker win_rate=" << average( attackerWins ) << " average_survivors=" << average( survivors[0] ) << " initial_count=" << initialCounts[0] )
+    COUT( "defender win_rate=" << average( defenderWins ) << " average_survivors=" << average( survivors[1] ) << " initial_count=" << initialCounts[1] )
+    COUT( "draw_rate=" << average( battles - attackerWins - defenderWins ) << " retreat_rate=" << average( retreats ) << " average_turns=" << average( turns ) )
+
+    return true;
+}
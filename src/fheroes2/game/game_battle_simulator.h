@@ -0,0 +1,47 @@
+/***************************************************************************
+ *   fheroes2: https://github.com/ihhub/fheroes2                           *
+ *   Copyright (C) 2026                                                    *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
+ ***************************************************************************/
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+namespace Game
+{
+    // Loads the description of two armies from the given text file and plays the given number of battles between them without any
+    // rendering, with AI in control of both sides. Battles are distributed between all available threads. The win rates, the average
+    // number of survivors and the number of battles per second are written to the log. Returns false if the description could not
+    // be loaded.
+    //
+    // The description consists of lines with the following commands (names are case-insensitive, spaces in names are replaced by
+    // underscores, e.g. "green_dragon"), lines starting with '#' are ignored:
+    //
+    // terrain <terrain>                           - the terrain of the battlefield, grass by default
+    // siege <race> [moat] [turrets]               - the defender defends a castle of the given race with all six dwellings built
+    // seed <number>                               - the seed of the first battle, every next battle uses the next seed, 0 by default
+    // attacker                                    - the following commands describe the attacking army
+    // defender                                    - the following commands describe the defending army
+    // hero <race> <attack> <defense> <power> <knowledge> - the army is commanded by a hero with the given primary skills
+    // skill <skill> <level>                       - the hero has the given secondary skill of the given level (1 - 3)
+    // artifact <artifact>                         - the hero has the given artifact
+    // spell <spell>                               - the hero has the given spell in the spell book
+    // troop <monster> <count>                     - the army has a troop of the given monsters, up to 5 troops per army
+    bool runBattleSimulator( const std::string & specFilePath, const uint32_t battles );
+}
@@ -41,6 +41,7 @@
 #include "localevent.h"
 #include "maps.h"
 #include "math_base.h"
+#include "math_tools.h"
 #include "screen.h"
 #include "settings.h"
 #include "ui_button.h"
@@ -121,6 +122,11 @@ Interface::AdventureMap & Interface::AdventureMap::Get()
 
 void Interface::AdventureMap::redraw( const uint32_t force )
 {
+    if ( Game::isHeadlessMode() ) {
+        _redraw = 0;
+        return;
+    }
+
     if ( _lockRedraw ) {
         setRedraw( force );
         return;
@@ -138,6 +144,21 @@ void Interface::AdventureMap::redraw( const uint32_t force )
             _controlPanel._redraw();
         }
     }
+    else if ( combinedRedraw & REDRAW_GAMEAREA_ANIMATION ) {
+        const fheroes2::Rect animationRoi = _gameArea.redrawAnimatedObjects( fheroes2::Display::instance(), LEVEL_ALL );
+
+        if ( hideInterface && conf.ShowControlPanel() ) {
+            _controlPanel._redraw();
+        }
+
+        if ( combinedRedraw == REDRAW_GAMEAREA_ANIMATION ) {
+            _animationRoi = fheroes2::getBoundaryRect( _animationRoi, animationRoi );
+        }
+    }
+
+    if ( combinedRedraw != REDRAW_GAMEAREA_ANIMATION ) {
+        _isOnlyAnimationRedrawn = false;
+    }
 
     if ( ( hideInterface && conf.ShowRadar() ) || ( combinedRedraw & ( REDRAW_RADAR_CURSOR | REDRAW_RADAR ) ) ) {
         // Redraw radar map only if `REDRAW_RADAR` is set.
@@ -31,6 +31,7 @@
 #include "interface_cpanel.h"
 #include "interface_icons.h"
 #include "interface_status.h"
+#include "math_base.h"
 #include "players.h"
 
 class Castle;
@@ -174,7 +175,12 @@ namespace Interface
         ControlPanel _controlPanel;
         StatusPanel _statusPanel;
 
+        // The area of the screen changed by redraws since the last rendering in the main loop of the human turn. It is used only if nothing
+        // but animated objects of the game area has been redrawn, otherwise the whole screen is rendered.
+        fheroes2::Rect _animationRoi;
+
         bool _lockRedraw;
         bool _isCurrentInterfaceEvil;
+        bool _isOnlyAnimationRedrawn{ false };
     };
 }
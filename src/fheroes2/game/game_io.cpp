@@ -24,9 +24,15 @@
 #include "game_io.h"
 
 #include <algorithm>
+#include <atomic>
 #include <cctype>
+#include <condition_variable>
 #include <cstdint>
 #include <ctime>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <optional>
 #include <ostream>
 #include <utility>
 
@@ -42,6 +48,7 @@
 #include "serialize.h"
 #include "settings.h"
 #include "system.h"
+#include "thread.h"
 #include "translations.h"
 #include "ui_dialog.h"
 #include "ui_font.h"
@@ -101,6 +108,130 @@ namespace
     {
         return stream >> hdr.requirements >> hdr.info >> hdr.gameType;
     }
+
+    // The data is written to a temporary file which then replaces the target file, so the target file is never left partially written.
+    bool writeSaveFile( const std::string & filePath, const RWStreamBuf & header, const RWStreamBuf & data, const int compressionLevel )
+    {
+        const std::string tempFilePath = filePath + ".tmp";
+
+        {
+            StreamFile fileStream;
+            fileStream.setBigendian( true );
+
+            if ( !fileStream.open( tempFilePath, "wb" ) ) {
+                DEBUG_LOG( DBG_GAME, DBG_WARN, "Error opening the file " << tempFilePath )
+                return false;
+            }
+
+            fileStream.putRaw( header.data(), header.size() );
+
+            if ( fileStream.fail() || !Compression::zipStreamBufInChunks( data, fileStream, compressionLevel ) ) {
+                fileStream.close();
+                System::Unlink( tempFilePath );
+
+                return false;
+            }
+        }
+
+        if ( !System::Rename( tempFilePath, filePath ) ) {
+            ERROR_LOG( "Failed to replace the file " << filePath )
+            System::Unlink( tempFilePath );
+
+            return false;
+        }
+
+        return true;
+    }
+
+    struct SaveTask
+    {
+        std::string filePath;
+        std::unique_ptr<RWStreamBuf> header;
+        std::unique_ptr<RWStreamBuf> data;
+        int compressionLevel{ Compression::defaultCompressionLevel };
+    };
+
+    // Compresses and writes save files one by one in the order of their arrival.
+    class BackgroundSaveManager final : public MultiThreading::AsyncManager
+    {
+    public:
+        void push( SaveTask task )
+        {
+            createWorker();
+
+            const std::scoped_lock<std::mutex> lock( _mutex );
+
+            _tasks.emplace_back( std::move( task ) );
+
+            notifyWorker();
+        }
+
+        void wait()
+        {
+            std::unique_lock<std::mutex> lock( _mutex );
+
+            _completionNotification.wait( lock, [this] { return _tasks.empty() && !_currentTask; } );
+        }
+
+        void stop()
+        {
+            wait();
+            stopWorker();
+        }
+
+        bool isFailed()
+        {
+            return _isFailed.exchange( false );
+        }
+
+    private:
+        std::deque<SaveTask> _tasks;
+        std::optional<SaveTask> _currentTask;
+
+        std::condition_variable _completionNotification;
+
+        std::atomic<bool> _isFailed{ false };
+
+        // This method is called by the worker thread and is protected by _mutex
+        bool prepareTask() override
+        {
+            if ( _tasks.empty() ) {
+                _currentTask.reset();
+
+                return false;
+            }
+
+            _currentTask = std::move( _tasks.front() );
+            _tasks.pop_front();
+
+            return true;
+        }
+
+        // This method is called by the worker thread, but is not protected by _mutex
+        void executeTask() override
+        {
+            if ( !_currentTask ) {
+                return;
+            }
+
+            const SaveTask & task = *_currentTask;
+
+            if ( !writeSaveFile( task.filePath, *task.header, *task.data, task.compressionLevel ) ) {
+                ERROR_LOG( "Failed to save the game to " << task.filePath )
+                _isFailed = true;
+            }
+
+            {
+                const std::scoped_lock<std::mutex> lock( _mutex );
+
+                _currentTask.reset();
+            }
+
+            _completionNotification.notify_all();
+        }
+    };
+
+    BackgroundSaveManager backgroundSaveManager;
 }
 
 bool Game::AutoSave()
@@ -117,14 +248,6 @@ bool Game::Save( const std::string & filePath, const bool autoSave /* = false */
 {
     DEBUG_LOG( DBG_GAME, DBG_INFO, filePath )
 
-    StreamFile fileStream;
-    fileStream.setBigendian( true );
-
-    if ( !fileStream.open( filePath, "wb" ) ) {
-        DEBUG_LOG( DBG_GAME, DBG_WARN, "Error opening the file " << filePath )
-        return false;
-    }
-
     // Always use the latest version of the file save format
     SetVersionOfCurrentSaveFile( CURRENT_FORMAT_VERSION );
     const uint16_t saveFileVersion = CURRENT_FORMAT_VERSION;
@@ -132,43 +255,72 @@ bool Game::Save( const std::string & filePath, const bool autoSave /* = false */
     // Header
     const Settings & conf = Settings::Get();
 
-    fileStream << saveFileMagicNumber << std::to_string( saveFileVersion ) << saveFileVersion
-               << HeaderSAV( conf.getCurrentMapInfo(), conf.GameType(), world.GetDay(), world.GetWeek(), world.GetMonth() );
-    if ( fileStream.fail() ) {
+    auto header = std::make_unique<RWStreamBuf>();
+    header->setBigendian( true );
+
+    *header << saveFileMagicNumber << std::to_string( saveFileVersion ) << saveFileVersion
+            << HeaderSAV( conf.getCurrentMapInfo(), conf.GameType(), world.GetDay(), world.GetWeek(), world.GetMonth() );
+    if ( header->fail() ) {
         return false;
     }
 
-    RWStreamBuf dataStream;
-    dataStream.setBigendian( true );
+    auto dataStream = std::make_unique<RWStreamBuf>();
+    dataStream->setBigendian( true );
 
-    dataStream << World::Get() << conf << GameOver::Result::Get();
-    if ( dataStream.fail() ) {
+    *dataStream << World::Get() << conf << GameOver::Result::Get();
+    if ( dataStream->fail() ) {
         return false;
     }
 
     if ( conf.isCampaignGameType() ) {
-        dataStream << Campaign::CampaignSaveData::Get();
+        *dataStream << Campaign::CampaignSaveData::Get();
     }
 
     // End-of-data marker
-    dataStream << saveFileMagicNumber;
-    if ( dataStream.fail() || !Compression::zipStreamBuf( dataStream, fileStream ) ) {
+    *dataStream << saveFileMagicNumber;
+    if ( dataStream->fail() ) {
         return false;
     }
 
-    if ( !autoSave ) {
-        Game::SetLastSaveName( filePath );
+    if ( autoSave ) {
+        // Autosaves happen during the gameplay so the fastest compression is used for them and the file is written in the background
+        // to avoid noticeable freezes. The game state has already been captured so the game can continue.
+        backgroundSaveManager.push( { filePath, std::move( header ), std::move( dataStream ), Compression::fastestCompressionLevel } );
+
+        return true;
     }
 
+    // The same file could be written by a background save.
+    backgroundSaveManager.wait();
+
+    if ( !writeSaveFile( filePath, *header, *dataStream, Compression::defaultCompressionLevel ) ) {
+        return false;
+    }
+
+    Game::SetLastSaveName( filePath );
+
     return true;
 }
 
+bool Game::isBackgroundSaveFailed()
+{
+    return backgroundSaveManager.isFailed();
+}
+
+Game::BackgroundSaveFinalizer::~BackgroundSaveFinalizer()
+{
+    backgroundSaveManager.stop();
+}
+
 fheroes2::GameMode Game::Load( const std::string & filePath )
 {
     DEBUG_LOG( DBG_GAME, DBG_INFO, filePath )
 
     const auto showGenericErrorMessage = []() { fheroes2::showStandardTextMessage( _( "Error" ), _( "The save file is corrupted." ), Dialog::OK ); };
 
+    // The file could still be written by a background save.
+    backgroundSaveManager.wait();
+
     StreamFile fileStream;
     fileStream.setBigendian( true );
 
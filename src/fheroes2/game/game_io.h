@@ -46,11 +46,27 @@ namespace Game
     std::string GetSaveFileExtension();
     std::string GetSaveFileExtension( const int gameType );
 
+    // The autosave file is compressed and written in the background, the game state is captured at the time of the call.
     bool AutoSave();
     bool QuickSave();
 
+    // Manual saves wait for the completion of all background saves to keep the order of writing.
     bool Save( const std::string & filePath, const bool autoSave = false );
 
+    // Returns true if any of the background saves has failed since the last call of this function.
+    bool isBackgroundSaveFailed();
+
+    // Waits for the completion of all background saves and stops the background save thread when the object is destroyed.
+    class BackgroundSaveFinalizer
+    {
+    public:
+        BackgroundSaveFinalizer() = default;
+        BackgroundSaveFinalizer( const BackgroundSaveFinalizer & ) = delete;
+        BackgroundSaveFinalizer & operator=( const BackgroundSaveFinalizer & ) = delete;
+
+        ~BackgroundSaveFinalizer();
+    };
+
     // Returns GameMode::CANCEL in case of failure.
     fheroes2::GameMode Load( const std::string & filePath );
 
@@ -255,6 +255,11 @@ void Game::DialogPlayers( const PlayerColor color, std::string title, std::strin
     const Player * player = Players::Get( color );
     StringReplace( message, "%{color}", ( player ? player->GetName() : Color::String( color ) ) );
 
+    if ( Game::isHeadlessMode() ) {
+        COUT( title << ": " << message )
+        return;
+    }
+
     const fheroes2::Sprite & border = fheroes2::AGG::GetICN( ICN::BRCREST, 6 );
     fheroes2::Sprite sign = border;
 
@@ -1067,6 +1072,9 @@ fheroes2::GameMode Interface::AdventureMap::HumanTurn( const bool isLoadedFromSa
         resetCursor();
     };
 
+    // The screen could have been changed outside of this loop.
+    _isOnlyAnimationRedrawn = false;
+
     while ( res == fheroes2::GameMode::CANCEL ) {
         if ( !le.HandleEvents( Game::isDelayNeeded( delayTypes ), true ) ) {
             if ( EventExit() == fheroes2::GameMode::QUIT_GAME ) {
@@ -1093,6 +1101,10 @@ fheroes2::GameMode Interface::AdventureMap::HumanTurn( const bool isLoadedFromSa
         // Pending timer events
         _statusPanel.TimerEventProcessing();
 
+        if ( !isHeroMoving && Game::isBackgroundSaveFailed() ) {
+            fheroes2::showStandardTextMessage( "", _( "There was an issue during autosaving." ), Dialog::OK );
+        }
+
         if ( isHeroMoving ) {
             // Hero is moving, set the appropriate cursor
             cursor.SetThemes( Cursor::WAIT );
@@ -1534,7 +1546,7 @@ fheroes2::GameMode Interface::AdventureMap::HumanTurn( const bool isLoadedFromSa
         if ( Game::validateAnimationDelay( Game::MAPS_DELAY ) ) {
             Game::updateAdventureMapAnimationIndex();
 
-            _gameArea.SetRedraw();
+            setRedraw( REDRAW_GAMEAREA_ANIMATION );
         }
 
         if ( needRedraw() ) {
@@ -1543,7 +1555,18 @@ fheroes2::GameMode Interface::AdventureMap::HumanTurn( const bool isLoadedFromSa
             // If this assertion blows up it means that we are holding a RedrawLocker lock for rendering which should not happen.
             assert( getRedrawMask() == 0 );
 
-            validateFadeInAndRender();
+            if ( _isOnlyAnimationRedrawn && !Game::isFadeInNeeded() ) {
+                // Nothing but animated objects has changed since the last rendering so only their area of the screen is rendered.
+                if ( _animationRoi.width > 0 && _animationRoi.height > 0 ) {
+                    fheroes2::Display::instance().render( _animationRoi );
+                }
+            }
+            else {
+                validateFadeInAndRender();
+            }
+
+            _animationRoi = {};
+            _isOnlyAnimationRedrawn = true;
         }
     }
 
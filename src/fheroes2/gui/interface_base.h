@@ -56,7 +56,11 @@ namespace Interface
         REDRAW_ALL = 0x1FF,
 
         // This option is only for the Editor.
-        REDRAW_PASSABILITIES = 0x200
+        REDRAW_PASSABILITIES = 0x200,
+
+        // This option is only for the game (Adventure Map) interface. It redraws only animated objects of the game area
+        // and it is ignored if REDRAW_GAMEAREA is set.
+        REDRAW_GAMEAREA_ANIMATION = 0x400
     };
 
     class BaseInterface
@@ -31,6 +31,8 @@
 #include <map>
 #include <ostream>
 #include <type_traits>
+#include <utility>
+#include <vector>
 
 #include "agg_image.h"
 #include "castle.h"
@@ -46,10 +48,12 @@
 #include "interface_cpanel.h"
 #include "localevent.h"
 #include "logging.h"
+#include "map_object_info.h"
 #include "maps.h"
 #include "maps_tiles.h"
 #include "maps_tiles_helper.h"
 #include "maps_tiles_render.h"
+#include "math_tools.h"
 #include "pal.h"
 #include "players.h"
 #include "route.h"
@@ -343,6 +347,8 @@ void Interface::GameArea::generate( const fheroes2::Size & screenSize, const boo
 void Interface::GameArea::SetAreaPosition( int32_t x, int32_t y, int32_t w, int32_t h )
 {
     _windowROI = { x, y, w, h };
+    _redrawROI = _windowROI;
+
     const fheroes2::Size worldSize( world.w() * fheroes2::tileWidthPx, world.h() * fheroes2::tileWidthPx );
 
     if ( worldSize.width > w ) {
@@ -375,7 +381,7 @@ void Interface::GameArea::BlitOnTile( fheroes2::Image & dst, const fheroes2::Ima
     const fheroes2::Point tileOffset = GetRelativeTilePosition( mp );
 
     const fheroes2::Rect imageRoi{ tileOffset.x + ox, tileOffset.y + oy, src.width(), src.height() };
-    const fheroes2::Rect overlappedRoi = _windowROI ^ imageRoi;
+    const fheroes2::Rect overlappedRoi = _redrawROI ^ imageRoi;
 
     fheroes2::AlphaBlit( src, overlappedRoi.x - imageRoi.x, overlappedRoi.y - imageRoi.y, dst, overlappedRoi.x, overlappedRoi.y, overlappedRoi.width,
                          overlappedRoi.height, alpha, flip );
@@ -387,7 +393,7 @@ void Interface::GameArea::BlitOnTile( fheroes2::Image & dst, const fheroes2::Ima
     const fheroes2::Point tileOffset = GetRelativeTilePosition( mp );
 
     const fheroes2::Rect imageRoi{ tileOffset.x + ox, tileOffset.y + oy, srcRoi.width, srcRoi.height };
-    const fheroes2::Rect overlappedRoi = _windowROI ^ imageRoi;
+    const fheroes2::Rect overlappedRoi = _redrawROI ^ imageRoi;
 
     fheroes2::AlphaBlit( src, srcRoi.x + overlappedRoi.x - imageRoi.x, srcRoi.y + overlappedRoi.y - imageRoi.y, dst, overlappedRoi.x, overlappedRoi.y,
                          overlappedRoi.width, overlappedRoi.height, alpha, flip );
@@ -398,15 +404,184 @@ void Interface::GameArea::DrawTile( fheroes2::Image & dst, const fheroes2::Image
     const fheroes2::Point tileOffset = GetRelativeTilePosition( mp );
 
     const fheroes2::Rect imageRoi{ tileOffset.x, tileOffset.y, src.width(), src.height() };
-    const fheroes2::Rect overlappedRoi = _windowROI ^ imageRoi;
+    const fheroes2::Rect overlappedRoi = _redrawROI ^ imageRoi;
 
     fheroes2::Copy( src, overlappedRoi.x - imageRoi.x, overlappedRoi.y - imageRoi.y, dst, overlappedRoi.x, overlappedRoi.y, overlappedRoi.width, overlappedRoi.height );
 }
 
 void Interface::GameArea::Redraw( fheroes2::Image & dst, int flag, bool isPuzzleDraw ) const
 {
-    const fheroes2::Rect & tileROI = GetVisibleTileROI();
+    _redrawROI = _windowROI;
+
+    _redraw( dst, flag, isPuzzleDraw, GetVisibleTileROI() );
+
+    updateObjectAnimationInfo();
+}
+
+fheroes2::Rect Interface::GameArea::redrawAnimatedObjects( fheroes2::Image & dst, int flag ) const
+{
+    if ( !_animationInfo.empty() ) {
+        // Fading objects change every frame and they are rare so there is no point to track them separately.
+        Redraw( dst, flag );
+        return _windowROI;
+    }
 
+    const int32_t worldWidth = world.w();
+    const int32_t worldHeight = world.h();
+
+    // Only the tiles of the world can contain animated objects.
+    const fheroes2::Rect visibleTileROI = GetVisibleTileROI();
+    const int32_t minX = std::max<int32_t>( visibleTileROI.x, 0 );
+    const int32_t minY = std::max<int32_t>( visibleTileROI.y, 0 );
+    const int32_t maxX = std::min( visibleTileROI.x + visibleTileROI.width, worldWidth );
+    const int32_t maxY = std::min( visibleTileROI.y + visibleTileROI.height, worldHeight );
+
+    if ( minX >= maxX || minY >= maxY ) {
+        return {};
+    }
+
+    const int32_t areaWidth = maxX - minX;
+    const int32_t areaHeight = maxY - minY;
+
+    std::vector<uint8_t> isTileChanged( static_cast<size_t>( areaWidth ) * areaHeight, 0 );
+    int32_t changedTileCount = 0;
+
+    const auto markChangedTiles = [&]( const int32_t x, const int32_t y, const int32_t margin ) {
+        for ( int32_t posY = std::max( y - margin, minY ); posY <= std::min( y + margin, maxY - 1 ); ++posY ) {
+            for ( int32_t posX = std::max( x - margin, minX ); posX <= std::min( x + margin, maxX - 1 ); ++posX ) {
+                uint8_t & isChanged = isTileChanged[static_cast<size_t>( posY - minY ) * areaWidth + posX - minX];
+                if ( isChanged == 0 ) {
+                    isChanged = 1;
+                    ++changedTileCount;
+                }
+            }
+        }
+    };
+
+    const auto isAnimatedPart = []( const Maps::ObjectPart & part ) {
+        if ( part.icnType == MP2::OBJ_ICN_TYPE_UNKNOWN ) {
+            return false;
+        }
+
+        const auto * objectInfo = Maps::getObjectPartByIcn( part.icnType, part.icnIndex );
+        return objectInfo != nullptr && objectInfo->animationFrames > 0;
+    };
+
+#ifdef WITH_DEBUG
+    const bool renderFog = ( ( flag & LEVEL_FOG ) == LEVEL_FOG ) && !IS_DEVEL();
+#else
+    const bool renderFog = ( flag & LEVEL_FOG ) == LEVEL_FOG;
+#endif
+    const bool drawHeroes = ( flag & LEVEL_HEROES ) == LEVEL_HEROES;
+
+    // Sprites of heroes, monsters and mine ghosts are bigger than a tile. The same 2 extra tiles are used while rendering the whole game area.
+    const int32_t bigObjectMargin = 2;
+
+    for ( int32_t y = std::max( minY - bigObjectMargin, 0 ); y < std::min( maxY + bigObjectMargin, worldHeight ); ++y ) {
+        for ( int32_t x = std::max( minX - bigObjectMargin, 0 ); x < std::min( maxX + bigObjectMargin, worldWidth ); ++x ) {
+            const Maps::Tile & tile = world.getTile( x, y );
+
+            const MP2::MapObjectType objectType = tile.getMainObjectType();
+            const MP2::MapObjectType objectTypeUnderHero = ( objectType == MP2::OBJ_HERO ) ? tile.getMainObjectType( false ) : objectType;
+
+            if ( ( drawHeroes && objectType == MP2::OBJ_HERO ) || objectType == MP2::OBJ_MONSTER || objectTypeUnderHero == MP2::OBJ_MINE
+                 || objectTypeUnderHero == MP2::OBJ_ABANDONED_MINE ) {
+                markChangedTiles( x, y, bigObjectMargin );
+                continue;
+            }
+
+            if ( x < minX || x >= maxX || y < minY || y >= maxY ) {
+                // Animated object parts always fit into their tiles.
+                continue;
+            }
+
+            if ( renderFog && tile.getFogDirection() == DIRECTION_ALL ) {
+                continue;
+            }
+
+            const auto & groundParts = tile.getGroundObjectParts();
+            const auto & topParts = tile.getTopObjectParts();
+
+            if ( isAnimatedPart( tile.getMainObjectPart() ) || std::any_of( groundParts.begin(), groundParts.end(), isAnimatedPart )
+                 || std::any_of( topParts.begin(), topParts.end(), isAnimatedPart ) ) {
+                markChangedTiles( x, y, 0 );
+            }
+        }
+    }
+
+    if ( changedTileCount == 0 ) {
+        return {};
+    }
+
+    if ( changedTileCount * 2 > areaWidth * areaHeight ) {
+        // Redrawing many small areas is slower than redrawing the whole game area at once.
+        Redraw( dst, flag );
+        return _windowROI;
+    }
+
+    // Merge changed tiles into rectangles: each row is split into runs of changed tiles and a run is merged with the rectangle
+    // ending at the previous row if they have the same horizontal position and width.
+    std::vector<fheroes2::Rect> changedTileROIs;
+    std::vector<size_t> previousRowROIs;
+    std::vector<size_t> currentRowROIs;
+
+    for ( int32_t y = minY; y < maxY; ++y ) {
+        currentRowROIs.clear();
+
+        const uint8_t * row = isTileChanged.data() + static_cast<size_t>( y - minY ) * areaWidth;
+
+        for ( int32_t x = 0; x < areaWidth; ) {
+            if ( row[x] == 0 ) {
+                ++x;
+                continue;
+            }
+
+            const int32_t runStartX = x;
+            while ( x < areaWidth && row[x] != 0 ) {
+                ++x;
+            }
+
+            const fheroes2::Rect run{ minX + runStartX, y, x - runStartX, 1 };
+
+            auto iter = std::find_if( previousRowROIs.begin(), previousRowROIs.end(), [&changedTileROIs, &run]( const size_t id ) {
+                return changedTileROIs[id].x == run.x && changedTileROIs[id].width == run.width;
+            } );
+
+            if ( iter != previousRowROIs.end() ) {
+                ++changedTileROIs[*iter].height;
+                currentRowROIs.push_back( *iter );
+            }
+            else {
+                currentRowROIs.push_back( changedTileROIs.size() );
+                changedTileROIs.push_back( run );
+            }
+        }
+
+        std::swap( previousRowROIs, currentRowROIs );
+    }
+
+    fheroes2::Rect changedAreaROI;
+
+    for ( const fheroes2::Rect & tileROI : changedTileROIs ) {
+        const fheroes2::Point position = GetRelativeTilePosition( tileROI.getPosition() );
+
+        _redrawROI = _windowROI ^ fheroes2::Rect{ position.x, position.y, tileROI.width * fheroes2::tileWidthPx, tileROI.height * fheroes2::tileWidthPx };
+        if ( _redrawROI.width <= 0 || _redrawROI.height <= 0 ) {
+            continue;
+        }
+
+        _redraw( dst, flag, false, tileROI );
+
+        changedAreaROI = fheroes2::getBoundaryRect( changedAreaROI, _redrawROI );
+    }
+
+    _redrawROI = _windowROI;
+
+    return changedAreaROI;
+}
+
+void Interface::GameArea::_redraw( fheroes2::Image & dst, const int flag, const bool isPuzzleDraw, const fheroes2::Rect & tileROI ) const
+{
     int32_t maxX = tileROI.x + tileROI.width;
     int32_t maxY = tileROI.y + tileROI.height;
     const int32_t worldWidth = world.w();
@@ -791,8 +966,6 @@ void Interface::GameArea::Redraw( fheroes2::Image & dst, int flag, bool isPuzzle
             }
         }
     }
-
-    updateObjectAnimationInfo();
 }
 
 void Interface::GameArea::renderTileAreaSelect( fheroes2::Image & dst, const int32_t startTile, const int32_t endTile, const bool isActionObject ) const
@@ -198,6 +198,11 @@ namespace Interface
         // Interface::BaseInterface::Redraw() instead to avoid issues in the "no interface" mode
         void Redraw( fheroes2::Image & dst, int flag, bool isPuzzleDraw = false ) const;
 
+        // Redraws only the parts of the game area which contain animated objects: heroes, monsters, mines and animated object parts.
+        // Returns the area of the screen which has been redrawn. It is empty if there is nothing to redraw and it is the whole game area
+        // if too many objects are animated or if an object fading animation is in progress.
+        fheroes2::Rect redrawAnimatedObjects( fheroes2::Image & dst, int flag ) const;
+
         void renderTileAreaSelect( fheroes2::Image & dst, const int32_t startTile, const int32_t endTile, const bool isActionObject ) const;
 
         void BlitOnTile( fheroes2::Image & dst, const fheroes2::Image & src, int32_t ox, int32_t oy, const fheroes2::Point & mp, bool flip, uint8_t alpha ) const;
@@ -270,6 +275,10 @@ namespace Interface
         BaseInterface & _interface;
 
         fheroes2::Rect _windowROI; // visible to draw area of World Map in pixels
+
+        // Area of the screen which is allowed to be drawn on. It is the same as the window ROI unless only some parts of the game area are being redrawn.
+        // This member needs to be mutable because it is modified during rendering.
+        mutable fheroes2::Rect _redrawROI;
         fheroes2::Point _topLeftTileOffset; // offset of tiles to be drawn (from here we can find any tile ID)
 
         // boundaries for World Map
@@ -307,6 +316,9 @@ namespace Interface
 
         void _setCenterToTile( const fheroes2::Point & tile ); // set center to the middle of tile (input is tile ID)
 
+        // Redraws the given tile area clipped by the redraw ROI.
+        void _redraw( fheroes2::Image & dst, const int flag, const bool isPuzzleDraw, const fheroes2::Rect & tileROI ) const;
+
         void updateObjectAnimationInfo() const;
     };
 }
@@ -494,6 +494,10 @@ void Interface::StatusPanel::drawAITurnProgress( const uint32_t progressValue )
     // another music chunk on some platforms (e.g. WebAssembly), etc.
     LocalEvent::Get().HandleEvents( false );
 
+    if ( Game::isHeadlessMode() ) {
+        return;
+    }
+
     const bool updateProgress = ( progressValue != _aiTurnProgress );
     const bool isMapAnimation = Game::validateAnimationDelay( Game::MAPS_DELAY );
 
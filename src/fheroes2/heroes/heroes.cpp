@@ -28,6 +28,7 @@
 #include <cmath>
 #include <iterator>
 #include <map>
+#include <memory>
 #include <set>
 #include <sstream>
 #include <utility>
@@ -267,6 +268,30 @@ Heroes::Heroes( const int heroId, const int race )
     _movePoints = GetMaxMovePoints();
 }
 
+std::unique_ptr<Heroes> Heroes::createBattleSimulationCopy() const
+{
+    auto hero = std::make_unique<Heroes>( _id, _race );
+
+    hero->SetColor( GetColor() );
+
+    hero->attack = attack;
+    hero->defense = defense;
+    hero->power = power;
+    hero->knowledge = knowledge;
+
+    hero->_experience = _experience;
+    hero->_secondarySkills = _secondarySkills;
+    hero->_bagArtifacts = _bagArtifacts;
+    hero->_spellBook = _spellBook;
+    hero->_spellPoints = _spellPoints;
+    hero->_visitedObjects = _visitedObjects;
+
+    hero->_army.Assign( _army );
+    hero->_army.SetSpreadFormation( _army.isSpreadFormation() );
+
+    return hero;
+}
+
 void Heroes::LoadFromMP2( const int32_t mapIndex, const PlayerColor colorType, const int raceType, const bool isInJail, const std::vector<uint8_t> & data )
 {
     assert( data.size() == MP2::MP2_HEROES_STRUCTURE_SIZE );
@@ -301,6 +301,11 @@ public:
     double getRecruitValue() const;
     int getStatsValue() const;
 
+    // Returns a copy of this hero which has the same properties affecting battles (primary and secondary skills, army, artifacts, spells,
+    // spell points and visited objects), but which is not placed on the adventure map and is not a part of any kingdom. It is used to
+    // simulate battles without changing the state of the original hero.
+    std::unique_ptr<Heroes> createBattleSimulationCopy() const;
+
     void setAttackBaseValue( const int baseValue )
     {
         attack = baseValue;
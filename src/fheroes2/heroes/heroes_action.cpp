@@ -3285,6 +3285,8 @@ namespace
                         }
                     }
 
+                    bag.updateEffectTable();
+
                     msg = _n(
                         "After you consent to pay the requested amount of gold, the alchemist grabs the cursed artifact and throws it into his magical cauldron.",
                         "After you consent to pay the requested amount of gold, the alchemist grabs all cursed artifacts and throws them into his magical cauldron.",
@@ -594,6 +594,10 @@ OStreamBase & operator<<( OStreamBase & stream, const HeroBase & hero )
 
 IStreamBase & operator>>( IStreamBase & stream, HeroBase & hero )
 {
-    return stream >> static_cast<Skill::Primary &>( hero ) >> static_cast<MapPosition &>( hero ) >> hero.modes >> hero._spellPoints >> hero._movePoints >> hero._spellBook
-           >> hero._bagArtifacts;
+    stream >> static_cast<Skill::Primary &>( hero ) >> static_cast<MapPosition &>( hero ) >> hero.modes >> hero._spellPoints >> hero._movePoints >> hero._spellBook
+        >> hero._bagArtifacts;
+
+    hero._bagArtifacts.updateEffectTable();
+
+    return stream;
 }
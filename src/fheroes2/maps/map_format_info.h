@@ -46,6 +46,16 @@ namespace Maps::Map_Format
         ObjectGroup group{ ObjectGroup::NONE };
 
         uint32_t index{ 0 };
+
+        bool operator==( const TileObjectInfo & anotherObject ) const
+        {
+            return id == anotherObject.id && group == anotherObject.group && index == anotherObject.index;
+        }
+
+        bool operator!=( const TileObjectInfo & anotherObject ) const
+        {
+            return !( *this == anotherObject );
+        }
     };
 
     struct TileInfo
@@ -54,6 +64,16 @@ namespace Maps::Map_Format
         uint8_t terrainFlags{ 0 };
 
         std::vector<TileObjectInfo> objects;
+
+        bool operator==( const TileInfo & anotherTile ) const
+        {
+            return terrainIndex == anotherTile.terrainIndex && terrainFlags == anotherTile.terrainFlags && objects == anotherTile.objects;
+        }
+
+        bool operator!=( const TileInfo & anotherTile ) const
+        {
+            return !( *this == anotherTile );
+        }
     };
 
     constexpr size_t messageCharLimit{ 999 };
@@ -202,6 +222,16 @@ namespace Maps::Map_Format
     struct SignMetadata
     {
         std::string message;
+
+        bool operator==( const SignMetadata & anotherMetadata ) const
+        {
+            return message == anotherMetadata.message;
+        }
+
+        bool operator!=( const SignMetadata & anotherMetadata ) const
+        {
+            return !( *this == anotherMetadata );
+        }
     };
 
     struct AdventureMapEventMetadata
@@ -256,11 +286,31 @@ namespace Maps::Map_Format
     struct SelectionObjectMetadata
     {
         std::vector<int32_t> selectedItems;
+
+        bool operator==( const SelectionObjectMetadata & anotherMetadata ) const
+        {
+            return selectedItems == anotherMetadata.selectedItems;
+        }
+
+        bool operator!=( const SelectionObjectMetadata & anotherMetadata ) const
+        {
+            return !( *this == anotherMetadata );
+        }
     };
 
     struct CapturableObjectMetadata
     {
         PlayerColor ownerColor{ 0 };
+
+        bool operator==( const CapturableObjectMetadata & anotherMetadata ) const
+        {
+            return ownerColor == anotherMetadata.ownerColor;
+        }
+
+        bool operator!=( const CapturableObjectMetadata & anotherMetadata ) const
+        {
+            return !( *this == anotherMetadata );
+        }
     };
 
     struct MonsterMetadata
@@ -275,6 +325,17 @@ namespace Maps::Map_Format
 
         // Only for random monsters.
         std::vector<int32_t> selected;
+
+        bool operator==( const MonsterMetadata & anotherMetadata ) const
+        {
+            return count == anotherMetadata.count && joinCondition == anotherMetadata.joinCondition && isWeeklyGrowthDisabled == anotherMetadata.isWeeklyGrowthDisabled
+                   && selected == anotherMetadata.selected;
+        }
+
+        bool operator!=( const MonsterMetadata & anotherMetadata ) const
+        {
+            return !( *this == anotherMetadata );
+        }
     };
 
     struct ArtifactMetadata
@@ -287,11 +348,31 @@ namespace Maps::Map_Format
 
         // Only for random artifacts and Scroll Spell.
         std::vector<int32_t> selected;
+
+        bool operator==( const ArtifactMetadata & anotherMetadata ) const
+        {
+            return radius == anotherMetadata.radius && captureCondition == anotherMetadata.captureCondition && selected == anotherMetadata.selected;
+        }
+
+        bool operator!=( const ArtifactMetadata & anotherMetadata ) const
+        {
+            return !( *this == anotherMetadata );
+        }
     };
 
     struct ResourceMetadata
     {
         int32_t count{ 0 };
+
+        bool operator==( const ResourceMetadata & anotherMetadata ) const
+        {
+            return count == anotherMetadata.count;
+        }
+
+        bool operator!=( const ResourceMetadata & anotherMetadata ) const
+        {
+            return !( *this == anotherMetadata );
+        }
     };
 
     struct DailyEvent
@@ -309,6 +390,18 @@ namespace Maps::Map_Format
 
         // Resources to be given as a reward.
         Funds resources;
+
+        bool operator==( const DailyEvent & anotherMetadata ) const
+        {
+            return message == anotherMetadata.message && humanPlayerColors == anotherMetadata.humanPlayerColors
+                   && computerPlayerColors == anotherMetadata.computerPlayerColors && firstOccurrenceDay == anotherMetadata.firstOccurrenceDay
+                   && repeatPeriodInDays == anotherMetadata.repeatPeriodInDays && resources == anotherMetadata.resources;
+        }
+
+        bool operator!=( const DailyEvent & anotherMetadata ) const
+        {
+            return !( *this == anotherMetadata );
+        }
     };
 
     struct TranslationSphinxMetadata final
@@ -316,6 +409,16 @@ namespace Maps::Map_Format
         std::string riddle;
 
         std::vector<std::string> answers;
+
+        bool operator==( const TranslationSphinxMetadata & anotherMetadata ) const
+        {
+            return riddle == anotherMetadata.riddle && answers == anotherMetadata.answers;
+        }
+
+        bool operator!=( const TranslationSphinxMetadata & anotherMetadata ) const
+        {
+            return !( *this == anotherMetadata );
+        }
     };
 
     struct TranslationBaseMapMetadata final
@@ -323,6 +426,16 @@ namespace Maps::Map_Format
         std::string name;
         std::string description;
         std::string creatorNotes;
+
+        bool operator==( const TranslationBaseMapMetadata & anotherMetadata ) const
+        {
+            return name == anotherMetadata.name && description == anotherMetadata.description && creatorNotes == anotherMetadata.creatorNotes;
+        }
+
+        bool operator!=( const TranslationBaseMapMetadata & anotherMetadata ) const
+        {
+            return !( *this == anotherMetadata );
+        }
     };
 
     struct TranslationFormat final
@@ -340,6 +453,18 @@ namespace Maps::Map_Format
         std::map<uint32_t, std::string> signMetadata;
 
         std::map<uint32_t, std::string> adventureMapEventMetadata;
+
+        bool operator==( const TranslationFormat & anotherMetadata ) const
+        {
+            return dailyEvents == anotherMetadata.dailyEvents && rumors == anotherMetadata.rumors && castleMetadata == anotherMetadata.castleMetadata
+                   && heroMetadata == anotherMetadata.heroMetadata && sphinxMetadata == anotherMetadata.sphinxMetadata && signMetadata == anotherMetadata.signMetadata
+                   && adventureMapEventMetadata == anotherMetadata.adventureMapEventMetadata;
+        }
+
+        bool operator!=( const TranslationFormat & anotherMetadata ) const
+        {
+            return !( *this == anotherMetadata );
+        }
     };
 
     struct BaseMapFormat
@@ -633,8 +633,9 @@ bool Maps::isTileUnderProtection( const int32_t tileIndex )
 
 bool Maps::isTileProtectionStrongerThan( const int32_t tileIndex, const double armyStrength )
 {
-    // Creating an Army instance is a relatively heavy operation, so cache it to speed up calculations
-    static Army tileArmy;
+    // Creating an Army instance is a relatively heavy operation, so cache it to speed up calculations. Pathfinders can be run
+    // in parallel, so every thread has its own instance.
+    thread_local Army tileArmy;
     bool isStronger = false;
 
     forEachMonsterProtectingTile( tileIndex, [&armyStrength, &isStronger]( const int32_t monsterIndex ) {
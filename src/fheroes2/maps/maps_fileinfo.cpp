@@ -31,7 +31,10 @@
 #include <initializer_list>
 #include <list>
 #include <map>
+#include <optional>
 #include <sstream>
+#include <string_view>
+#include <tuple>
 #include <type_traits>
 #include <utility>
 
@@ -53,6 +56,7 @@
 #include "serialize.h"
 #include "settings.h"
 #include "system.h"
+#include "thread.h"
 #include "tools.h"
 #include "ui_font.h"
 #include "ui_language.h"
@@ -62,6 +66,236 @@ namespace
     const size_t mapNameLength = 16;
     const size_t mapDescriptionLength = 200;
 
+    // Reading and parsing of all map files is a relatively slow operation, especially if there are many maps. Therefore, the parsed map
+    // headers are stored in a cache file and map files are parsed only if they are new or have been changed since the last time.
+    class MapHeaderCache
+    {
+    public:
+        MapHeaderCache()
+        {
+            load();
+        }
+
+        MapHeaderCache( const MapHeaderCache & ) = delete;
+
+        ~MapHeaderCache() = default;
+
+        MapHeaderCache & operator=( const MapHeaderCache & ) = delete;
+
+        // Returns true if there is an up-to-date entry for the given file. In this case the result of the parsing of this file is written
+        // to fileInfo (empty if the file is not a valid map).
+        bool get( const std::string & filePath, const bool isForEditor, const fheroes2::SupportedLanguage language, std::optional<Maps::FileInfo> & fileInfo )
+        {
+            uint64_t fileSize = 0;
+            int64_t modificationTime = 0;
+
+            if ( !System::getFileStatus( filePath, fileSize, modificationTime ) ) {
+                return false;
+            }
+
+            const auto iter = _entries.find( { filePath, isForEditor, language } );
+            if ( iter == _entries.end() ) {
+                return false;
+            }
+
+            Entry & entry = iter->second;
+            if ( entry.fileSize != fileSize || entry.modificationTime != modificationTime ) {
+                return false;
+            }
+
+            entry.isUsed = true;
+            fileInfo = entry.fileInfo;
+
+            return true;
+        }
+
+        void set( const std::string & filePath, const bool isForEditor, const fheroes2::SupportedLanguage language, const std::optional<Maps::FileInfo> & fileInfo )
+        {
+            Entry entry;
+
+            if ( !System::getFileStatus( filePath, entry.fileSize, entry.modificationTime ) ) {
+                return;
+            }
+
+            entry.fileInfo = fileInfo;
+            entry.isUsed = true;
+
+            _entries[{ filePath, isForEditor, language }] = std::move( entry );
+
+            _isModified = true;
+        }
+
+        // Writes the cache file if any changes have been made. Entries for files that no longer exist are removed.
+        void save()
+        {
+            for ( auto iter = _entries.begin(); iter != _entries.end(); ) {
+                if ( iter->second.isUsed || System::IsFile( std::get<0>( iter->first ) ) ) {
+                    ++iter;
+                    continue;
+                }
+
+                iter = _entries.erase( iter );
+                _isModified = true;
+            }
+
+            if ( !_isModified ) {
+                return;
+            }
+
+            const std::string cacheDir = System::GetConfigDirectory( "fheroes" );
+            if ( !System::IsDirectory( cacheDir ) && !System::MakeDirectory( cacheDir ) ) {
+                return;
+            }
+
+            const std::string cacheFilePath = System::concatPath( cacheDir, cacheFileName );
+            // The cache is written to a temporary file which then replaces the cache file, so the cache file is never left partially written.
+            const std::string tempFilePath = cacheFilePath + ".tmp";
+
+            {
+                StreamFile fileStream;
+                fileStream.setBigendian( true );
+
+                if ( !fileStream.open( tempFilePath, "wb" ) ) {
+                    DEBUG_LOG( DBG_GAME, DBG_WARN, "Error opening the file " << tempFilePath )
+                    return;
+                }
+
+                const VersionRestorer versionRestorer;
+
+                fileStream << cacheFileMagicNumber << static_cast<uint16_t>( CURRENT_FORMAT_VERSION ) << static_cast<uint32_t>( _entries.size() );
+
+                for ( const auto & [key, entry] : _entries ) {
+                    const auto & [filePath, isForEditor, language] = key;
+
+                    fileStream << filePath << isForEditor << language << static_cast<uint32_t>( entry.fileSize >> 32 ) << static_cast<uint32_t>( entry.fileSize )
+                               << static_cast<uint32_t>( static_cast<uint64_t>( entry.modificationTime ) >> 32 )
+                               << static_cast<uint32_t>( static_cast<uint64_t>( entry.modificationTime ) ) << entry.fileInfo.has_value();
+
+                    // Translations are not serialized as a part of Maps::FileInfo, so they should be saved separately
+                    if ( entry.fileInfo ) {
+                        fileStream << *entry.fileInfo << entry.fileInfo->translations;
+                    }
+                }
+
+                if ( fileStream.fail() ) {
+                    DEBUG_LOG( DBG_GAME, DBG_WARN, "Error writing the file " << tempFilePath )
+
+                    fileStream.close();
+                    System::Unlink( tempFilePath );
+                    return;
+                }
+            }
+
+            if ( !System::Rename( tempFilePath, cacheFilePath ) ) {
+                DEBUG_LOG( DBG_GAME, DBG_WARN, "Error renaming the file " << tempFilePath << " to " << cacheFilePath )
+
+                System::Unlink( tempFilePath );
+                return;
+            }
+
+            _isModified = false;
+        }
+
+    private:
+        struct Entry
+        {
+            uint64_t fileSize{ 0 };
+            int64_t modificationTime{ 0 };
+            std::optional<Maps::FileInfo> fileInfo;
+            bool isUsed{ false };
+        };
+
+        // Serialization of Maps::FileInfo depends on the version of the save file currently being processed, so the current
+        // format version should be used while reading and writing the cache file. The cache file of any other version is discarded.
+        class VersionRestorer
+        {
+        public:
+            VersionRestorer()
+                : _version( Game::GetVersionOfCurrentSaveFile() )
+            {
+                Game::SetVersionOfCurrentSaveFile( CURRENT_FORMAT_VERSION );
+            }
+
+            VersionRestorer( const VersionRestorer & ) = delete;
+
+            ~VersionRestorer()
+            {
+                Game::SetVersionOfCurrentSaveFile( _version );
+            }
+
+            VersionRestorer & operator=( const VersionRestorer & ) = delete;
+
+        private:
+            const uint16_t _version;
+        };
+
+        static constexpr std::string_view cacheFileName{ "maps.cache" };
+        static constexpr uint16_t cacheFileMagicNumber{ 0xFC01 };
+
+        // The key is the file path, whether the map was read for the Editor and the language used to read the map.
+        std::map<std::tuple<std::string, bool, fheroes2::SupportedLanguage>, Entry> _entries;
+
+        bool _isModified{ false };
+
+        void load()
+        {
+            StreamFile fileStream;
+            fileStream.setBigendian( true );
+
+            if ( !fileStream.open( System::concatPath( System::GetConfigDirectory( "fheroes" ), cacheFileName ), "rb" ) ) {
+                return;
+            }
+
+            uint16_t magicNumber = 0;
+            uint16_t version = 0;
+            uint32_t entryCount = 0;
+
+            fileStream >> magicNumber >> version >> entryCount;
+            if ( fileStream.fail() || magicNumber != cacheFileMagicNumber || version != CURRENT_FORMAT_VERSION ) {
+                return;
+            }
+
+            const VersionRestorer versionRestorer;
+
+            for ( uint32_t i = 0; i < entryCount; ++i ) {
+                std::string filePath;
+                bool isForEditor = false;
+                fheroes2::SupportedLanguage language = fheroes2::SupportedLanguage::English;
+                uint32_t fileSizeHigh = 0;
+                uint32_t fileSizeLow = 0;
+                uint32_t modificationTimeHigh = 0;
+                uint32_t modificationTimeLow = 0;
+
+                bool isValidMap = false;
+
+                Entry entry;
+
+                fileStream >> filePath >> isForEditor >> language >> fileSizeHigh >> fileSizeLow >> modificationTimeHigh >> modificationTimeLow >> isValidMap;
+
+                if ( isValidMap ) {
+                    Maps::FileInfo & fileInfo = entry.fileInfo.emplace();
+
+                    fileStream >> fileInfo >> fileInfo.translations;
+
+                    // Only the name of the map file is serialized as a part of Maps::FileInfo
+                    fileInfo.filename = filePath;
+                }
+
+                if ( fileStream.fail() ) {
+                    DEBUG_LOG( DBG_GAME, DBG_WARN, "The map header cache file is corrupted" )
+
+                    _entries.clear();
+                    return;
+                }
+
+                entry.fileSize = ( static_cast<uint64_t>( fileSizeHigh ) << 32 ) | fileSizeLow;
+                entry.modificationTime = static_cast<int64_t>( ( static_cast<uint64_t>( modificationTimeHigh ) << 32 ) | modificationTimeLow );
+
+                _entries.try_emplace( { std::move( filePath ), isForEditor, language }, std::move( entry ) );
+            }
+        }
+    };
+
     // This function returns an unsorted array. It is a caller responsibility to take care of sorting if needed.
     MapsFileInfoList getValidMaps( const ListFiles & mapFiles, const uint8_t humanPlayerCount, const bool isForEditor, const bool isOriginalMapFormat )
     {
@@ -70,6 +304,9 @@ namespace
 
         const auto currentLanguage = fheroes2::getCurrentLanguage();
 
+        // The language is only used while reading maps of the Resurrection format.
+        const auto mapLanguage = isOriginalMapFormat ? fheroes2::SupportedLanguage::English : currentLanguage;
+
         // Maps made by the original French version Editor or hacked maps could contain
         // special ASCII characters that are not supposed to be there.
         // While reading the original maps we attempt to fix these characters
@@ -78,20 +315,65 @@ namespace
             = isOriginalMapFormat
               && ( fheroes2::getCurrentLanguage() == fheroes2::SupportedLanguage::French && fheroes2::getResourceLanguage() == fheroes2::SupportedLanguage::French );
 
-        for ( const std::string & mapFile : mapFiles ) {
+        const std::vector<const std::string *> mapFilePaths = [&mapFiles]() {
+            std::vector<const std::string *> result;
+            result.reserve( mapFiles.size() );
+
+            for ( const std::string & mapFile : mapFiles ) {
+                result.push_back( &mapFile );
+            }
+
+            return result;
+        }();
+
+        MapHeaderCache cache;
+
+        // Every file has its own slot for the result.
+        std::vector<std::optional<Maps::FileInfo>> mapInfos( mapFilePaths.size() );
+        std::vector<size_t> mapsToParse;
+
+        for ( size_t idx = 0; idx < mapFilePaths.size(); ++idx ) {
+            if ( !cache.get( *mapFilePaths[idx], isForEditor, mapLanguage, mapInfos[idx] ) ) {
+                mapsToParse.push_back( idx );
+            }
+        }
+
+        // Map files that are missing in the cache are read and parsed in parallel.
+        MultiThreading::parallelFor( mapsToParse.size(), [&mapFilePaths, &mapInfos, &mapsToParse, isForEditor, isOriginalMapFormat, mapLanguage]( const size_t i ) {
+            const size_t idx = mapsToParse[i];
+            const std::string & mapFile = *mapFilePaths[idx];
+
             Maps::FileInfo fi;
 
             if ( isOriginalMapFormat ) {
                 if ( !fi.readMP2Map( mapFile, isForEditor ) ) {
-                    continue;
+                    return;
                 }
             }
             else {
-                if ( !fi.readResurrectionMap( mapFile, isForEditor, currentLanguage ) ) {
-                    continue;
+                if ( !fi.readResurrectionMap( mapFile, isForEditor, mapLanguage ) ) {
+                    return;
                 }
             }
 
+            mapInfos[idx] = std::move( fi );
+        } );
+
+        for ( const size_t idx : mapsToParse ) {
+            cache.set( *mapFilePaths[idx], isForEditor, mapLanguage, mapInfos[idx] );
+        }
+
+        cache.save();
+
+        // Merge the results in the original order of files, so the first found file with a given name always wins regardless of the order in which
+        // the files were processed.
+        for ( size_t idx = 0; idx < mapInfos.size(); ++idx ) {
+            if ( !mapInfos[idx] ) {
+                continue;
+            }
+
+            Maps::FileInfo & fi = *mapInfos[idx];
+
             if ( !isForEditor ) {
                 assert( humanPlayerCount >= 1 );
 
@@ -119,7 +401,7 @@ namespace
                 }
             }
 
-            uniqueMaps.try_emplace( System::GetFileName( mapFile ), std::move( fi ) );
+            uniqueMaps.try_emplace( System::GetFileName( *mapFilePaths[idx] ), std::move( fi ) );
         }
 
         MapsFileInfoList result;
@@ -850,17 +1132,29 @@ MapsFileInfoList Maps::getAllMapFileInfos( const bool isForEditor, const uint8_t
 
     // Load HoMM1 .MAP files from the MAPS/ filesystem directory
     {
-        const ListFiles homm1Files = Settings::FindFiles( "maps", ".map", false );
-        for ( const std::string & filePath : homm1Files ) {
+        const ListFiles homm1FileList = Settings::FindFiles( "maps", ".map", false );
+        const std::vector<std::string> homm1Files( homm1FileList.begin(), homm1FileList.end() );
+
+        std::vector<std::optional<Maps::FileInfo>> homm1MapInfos( homm1Files.size() );
+
+        MultiThreading::parallelFor( homm1Files.size(), [&homm1Files, &homm1MapInfos]( const size_t idx ) {
+            const std::string & filePath = homm1Files[idx];
+
             StreamFile fs;
             if ( !fs.open( filePath, "rb" ) ) {
-                continue;
+                return;
             }
             const size_t fileSize = fs.size();
             std::vector<uint8_t> data = fs.getRaw( fileSize );
             Maps::FileInfo fi;
             if ( fi.readHoMM1MapFromBytes( std::move( data ), filePath ) ) {
-                validMaps.emplace_back( std::move( fi ) );
+                homm1MapInfos[idx] = std::move( fi );
+            }
+        } );
+
+        for ( std::optional<Maps::FileInfo> & fi : homm1MapInfos ) {
+            if ( fi ) {
+                validMaps.emplace_back( std::move( *fi ) );
             }
         }
     }
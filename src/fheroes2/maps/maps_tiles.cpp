@@ -30,10 +30,13 @@
 #include <cstdint>
 #include <cstdlib>
 #include <limits>
+#include <list>
 #include <set>
 #include <sstream>
+#include <tuple>
 #include <type_traits>
 #include <utility>
+#include <vector>
 
 #include "army_troop.h"
 #include "castle.h"
@@ -387,6 +390,85 @@ namespace
         getObjectPartInfo( part, os, isGroundLayer );
         return os.str();
     }
+
+    template <typename Type, typename Item, typename Getter>
+    void saveMember( OStreamBase & stream, const std::vector<Item> & items, const Getter & getter )
+    {
+        std::vector<Type> values;
+        values.reserve( items.size() );
+
+        for ( const Item & item : items ) {
+            values.emplace_back( getter( item ) );
+        }
+
+        stream.putArray( values.data(), values.size() );
+    }
+
+    template <typename Type, typename Item, typename Setter>
+    void loadMember( IStreamBase & stream, std::vector<Item> & items, const Setter & setter )
+    {
+        std::vector<Type> values( items.size() );
+
+        stream.getArray( values.data(), values.size() );
+
+        for ( size_t i = 0; i < items.size(); ++i ) {
+            setter( items[i], values[i] );
+        }
+    }
+
+    void saveObjectParts( OStreamBase & stream, const std::vector<const Maps::ObjectPart *> & parts )
+    {
+        // The order of members is the same as in the serialization of a single object part.
+        saveMember<Maps::ObjectLayerType>( stream, parts, []( const Maps::ObjectPart * part ) { return part->layerType; } );
+        saveMember<uint32_t>( stream, parts, []( const Maps::ObjectPart * part ) { return part->_uid; } );
+        saveMember<MP2::ObjectIcnType>( stream, parts, []( const Maps::ObjectPart * part ) { return part->icnType; } );
+        saveMember<uint8_t>( stream, parts, []( const Maps::ObjectPart * part ) { return part->icnIndex; } );
+    }
+
+    void loadObjectParts( IStreamBase & stream, std::vector<Maps::ObjectPart *> & parts )
+    {
+        loadMember<Maps::ObjectLayerType>( stream, parts, []( Maps::ObjectPart * part, const Maps::ObjectLayerType value ) { part->layerType = value; } );
+        loadMember<uint32_t>( stream, parts, []( Maps::ObjectPart * part, const uint32_t value ) { part->_uid = value; } );
+        loadMember<MP2::ObjectIcnType>( stream, parts, []( Maps::ObjectPart * part, const MP2::ObjectIcnType value ) { part->icnType = value; } );
+        loadMember<uint8_t>( stream, parts, []( Maps::ObjectPart * part, const uint8_t value ) { part->icnIndex = value; } );
+    }
+
+    void saveObjectPartLists( OStreamBase & stream, const std::vector<const Maps::ObjectPartList *> & lists )
+    {
+        saveMember<uint32_t>( stream, lists, []( const Maps::ObjectPartList * list ) { return static_cast<uint32_t>( list->size() ); } );
+
+        std::vector<const Maps::ObjectPart *> parts;
+
+        for ( const Maps::ObjectPartList * list : lists ) {
+            for ( const Maps::ObjectPart & part : *list ) {
+                parts.emplace_back( &part );
+            }
+        }
+
+        saveObjectParts( stream, parts );
+    }
+
+    void loadObjectPartLists( IStreamBase & stream, std::vector<Maps::ObjectPartList *> & lists )
+    {
+        std::vector<uint32_t> listSizes( lists.size() );
+
+        stream.getArray( listSizes.data(), listSizes.size() );
+        if ( stream.fail() ) {
+            return;
+        }
+
+        std::vector<Maps::ObjectPart *> parts;
+
+        for ( size_t i = 0; i < lists.size(); ++i ) {
+            lists[i]->resize( listSizes[i] );
+
+            for ( Maps::ObjectPart & part : *lists[i] ) {
+                parts.emplace_back( &part );
+            }
+        }
+
+        loadObjectParts( stream, parts );
+    }
 }
 
 void Maps::Tile::Init( const MP2::MP2TileInfo & mp2 )
@@ -395,11 +477,12 @@ void Maps::Tile::Init( const MP2::MP2TileInfo & mp2 )
 
     setMainObjectType( static_cast<MP2::MapObjectType>( mp2.mapObjectType ) );
 
-    if ( !MP2::doesObjectContainMetadata( _mainObjectType ) && ( _metadata[0] != 0 ) ) {
+    if ( !MP2::doesObjectContainMetadata( _hot().mainObjectType ) && ( _metadata[0] != 0 ) ) {
         // No metadata should exist for non-action objects.
         // Some maps have invalid format. Even if this metadata is set here, it will later be reset during world map loading.
         DEBUG_LOG( DBG_GAME, DBG_WARN,
-                   "Metadata present for non action object " << MP2::StringObject( _mainObjectType ) << " at tile " << _index << ". Metadata value " << _metadata[0] )
+                   "Metadata present for non action object " << MP2::StringObject( _hot().mainObjectType ) << " at tile " << _index << ". Metadata value "
+                                                             << _metadata[0] )
     }
 
     // In the original Editor the road bit is set even if no road exist.
@@ -428,7 +511,7 @@ void Maps::Tile::Init( const MP2::MP2TileInfo & mp2 )
 
 Heroes * Maps::Tile::getHero() const
 {
-    return ( MP2::OBJ_HERO == _mainObjectType ) && Heroes::isValidId( _occupantHeroId ) ? world.GetHeroes( _occupantHeroId ) : nullptr;
+    return ( MP2::OBJ_HERO == _hot().mainObjectType ) && Heroes::isValidId( _occupantHeroId ) ? world.GetHeroes( _occupantHeroId ) : nullptr;
 }
 
 void Maps::Tile::setHero( Heroes * hero )
@@ -437,7 +520,7 @@ void Maps::Tile::setHero( Heroes * hero )
         using OccupantHeroIdType = decltype( _occupantHeroId );
         static_assert( std::is_same_v<OccupantHeroIdType, uint8_t> );
 
-        hero->setObjectTypeUnderHero( _mainObjectType );
+        hero->setObjectTypeUnderHero( _hot().mainObjectType );
 
         assert( hero->GetID() >= std::numeric_limits<OccupantHeroIdType>::min() && hero->GetID() < std::numeric_limits<OccupantHeroIdType>::max() );
         _occupantHeroId = static_cast<OccupantHeroIdType>( hero->GetID() );
@@ -466,8 +549,8 @@ fheroes2::Point Maps::Tile::GetCenter() const
 
 MP2::MapObjectType Maps::Tile::_getMainObjectTypeUnderHero() const
 {
-    if ( _mainObjectType != MP2::OBJ_HERO ) {
-        return _mainObjectType;
+    if ( _hot().mainObjectType != MP2::OBJ_HERO ) {
+        return _hot().mainObjectType;
     }
 
     const Heroes * hero = getHero();
@@ -476,8 +559,9 @@ MP2::MapObjectType Maps::Tile::_getMainObjectTypeUnderHero() const
 
 void Maps::Tile::setMainObjectType( const MP2::MapObjectType objectType )
 {
-    _mainObjectType = objectType;
+    _hot().mainObjectType = objectType;
 
+    world.markTileChanged( _index );
     world.resetPathfinder();
 }
 
@@ -645,41 +729,41 @@ int Maps::Tile::getTileIndependentPassability() const
 
 void Maps::Tile::setInitialPassability()
 {
-    using TilePassabilityDirectionsType = decltype( _tilePassabilityDirections );
+    using TilePassabilityDirectionsType = decltype( TileHotData::passabilityDirections );
     static_assert( std::is_same_v<TilePassabilityDirectionsType, uint16_t> );
 
     const int passability = getTileIndependentPassability();
     assert( passability >= std::numeric_limits<TilePassabilityDirectionsType>::min() && passability <= std::numeric_limits<TilePassabilityDirectionsType>::max() );
 
-    _tilePassabilityDirections = static_cast<TilePassabilityDirectionsType>( passability );
+    _hot().passabilityDirections = static_cast<TilePassabilityDirectionsType>( passability );
 }
 
 void Maps::Tile::updatePassability()
 {
     // If the passability is already 0 nothing we need to do.
-    if ( _tilePassabilityDirections == 0 ) {
+    if ( _hot().passabilityDirections == 0 ) {
         // This tile is impassable.
         return;
     }
 
     // If this assertion blows up then you are calling this method more than once!
-    assert( _tilePassabilityDirections == getTileIndependentPassability() );
+    assert( _hot().passabilityDirections == getTileIndependentPassability() );
 
     // Verify the neighboring tiles.
     // If a tile contains a tall object then it affects the passability of diagonal moves to the top from the current tile.
-    if ( ( _tilePassabilityDirections & Direction::TOP_LEFT ) && isValidDirection( _index, Direction::LEFT ) ) {
+    if ( ( _hot().passabilityDirections & Direction::TOP_LEFT ) && isValidDirection( _index, Direction::LEFT ) ) {
         const Tile & leftTile = world.getTile( GetDirectionIndex( _index, Direction::LEFT ) );
 
         if ( leftTile.isAnyTallObjectOnTile() && ( leftTile.getTileIndependentPassability() & Direction::TOP ) == 0 ) {
-            _tilePassabilityDirections &= ~Direction::TOP_LEFT;
+            _hot().passabilityDirections &= ~Direction::TOP_LEFT;
         }
     }
 
-    if ( ( _tilePassabilityDirections & Direction::TOP_RIGHT ) && isValidDirection( _index, Direction::RIGHT ) ) {
+    if ( ( _hot().passabilityDirections & Direction::TOP_RIGHT ) && isValidDirection( _index, Direction::RIGHT ) ) {
         const Tile & rightTile = world.getTile( GetDirectionIndex( _index, Direction::RIGHT ) );
 
         if ( rightTile.isAnyTallObjectOnTile() && ( rightTile.getTileIndependentPassability() & Direction::TOP ) == 0 ) {
-            _tilePassabilityDirections &= ~Direction::TOP_RIGHT;
+            _hot().passabilityDirections &= ~Direction::TOP_RIGHT;
         }
     }
 
@@ -709,7 +793,7 @@ void Maps::Tile::updatePassability()
     // Check the tile located below the object, which may affect the passability.
     if ( !isValidDirection( _index, Direction::BOTTOM ) ) {
         // This object "touches" the bottom part of the map. Mark is as inaccessible.
-        _tilePassabilityDirections = 0;
+        _hot().passabilityDirections = 0;
         return;
     }
 
@@ -717,7 +801,7 @@ void Maps::Tile::updatePassability()
     // If an object is located on land and the tile below it is a water tile, then mark the current tile as impassable.
     // It's done for cases when a hero won't be able to disembark on the tile.
     if ( !isWater() && bottomTile.isWater() ) {
-        _tilePassabilityDirections = 0;
+        _hot().passabilityDirections = 0;
         return;
     }
 
@@ -738,7 +822,7 @@ void Maps::Tile::updatePassability()
 
     for ( const uint32_t objectId : tileUIDs ) {
         if ( bottomTile.doesObjectExist( objectId ) ) {
-            _tilePassabilityDirections = 0;
+            _hot().passabilityDirections = 0;
             return;
         }
     }
@@ -769,7 +853,7 @@ void Maps::Tile::updatePassability()
         if ( MP2::isOffGameActionObject( bottomTileObjectType ) || MP2::isOffGameActionObject( correctedObjectType ) ) {
             if ( !isShortObject( bottomTileObjectType ) && !isShortObject( correctedObjectType ) ) {
                 // Since the object on the tile below is considered as tall we must mark this tile as impassable.
-                _tilePassabilityDirections = 0;
+                _hot().passabilityDirections = 0;
             }
 
             return;
@@ -783,7 +867,7 @@ void Maps::Tile::updatePassability()
             // Most likely these maps are hacked but since we are reading from the old map format we cannot assume things and assert them.
         }
         else {
-            _tilePassabilityDirections = 0;
+            _hot().passabilityDirections = 0;
         }
     }
 }
@@ -892,10 +976,10 @@ std::string Maps::Tile::String() const
        << "index           : " << _index << ", "
        << "point: (" << GetCenter().x << ", " << GetCenter().y << ")" << std::endl
        << "MP2 object type : " << static_cast<int>( objectType ) << " (" << MP2::StringObject( objectType ) << ")" << std::endl
-       << "region Id       : " << _region << std::endl
+       << "region Id       : " << GetRegion() << std::endl
        << "ground type     : " << Ground::String( GetGround() ) << " (isRoad: " << _isTileMarkedAsRoad << ")" << std::endl
-       << "ground img index: " << _terrainImageIndex << ", image flags: " << static_cast<int>( _terrainFlags ) << std::endl
-       << "passable from   : " << ( _tilePassabilityDirections ? Direction::String( _tilePassabilityDirections ) : "nowhere" ) << std::endl
+       << "ground img index: " << _hot().terrainImageIndex << ", image flags: " << static_cast<int>( _terrainFlags ) << std::endl
+       << "passable from   : " << ( _hot().passabilityDirections ? Direction::String( _hot().passabilityDirections ) : "nowhere" ) << std::endl
        << "metadata value 1: " << _metadata[0] << std::endl
        << "metadata value 2: " << _metadata[1] << std::endl
        << "metadata value 3: " << _metadata[2] << std::endl;
@@ -1028,18 +1112,18 @@ bool Maps::Tile::isSuitableForUltimateArtifact() const
 bool Maps::Tile::isSuitableForDisembarkation() const
 {
     // Tiles with OBJ_COAST are always suitable for disembarkation
-    if ( _mainObjectType == MP2::OBJ_COAST ) {
+    if ( _hot().mainObjectType == MP2::OBJ_COAST ) {
         return true;
     }
 
     // Tiles with heroes are a special case because heroes are moving objects and, strictly speaking, are not part of the map itself, so the checks below do not work with
     // them
-    if ( _mainObjectType == MP2::OBJ_HERO ) {
+    if ( _hot().mainObjectType == MP2::OBJ_HERO ) {
         return false;
     }
 
     // Tiles with events are not suitable for disembarkation (at least for now)
-    if ( _mainObjectType == MP2::OBJ_EVENT ) {
+    if ( _hot().mainObjectType == MP2::OBJ_EVENT ) {
         return false;
     }
 
@@ -1065,12 +1149,12 @@ bool Maps::Tile::isSuitableForSummoningBoat() const
 {
     // Tiles with heroes are a special case because heroes are moving objects and, strictly speaking, are not part of the map itself, so the checks below do not work with
     // them
-    if ( _mainObjectType == MP2::OBJ_HERO ) {
+    if ( _hot().mainObjectType == MP2::OBJ_HERO ) {
         return false;
     }
 
     // Tiles with events are not suitable for summoning a boat (at least for now)
-    if ( _mainObjectType == MP2::OBJ_EVENT ) {
+    if ( _hot().mainObjectType == MP2::OBJ_EVENT ) {
         return false;
     }
 
@@ -1110,7 +1194,7 @@ bool Maps::Tile::isPassableFrom( const int direction, const bool fromWater, cons
     // From the water we can get either to a water tile (provided that there is no boat on that tile) or to a shore tile suitable for disembarkation.
     if ( fromWater ) {
         if ( tileIsWater ) {
-            if ( _mainObjectType == MP2::OBJ_BOAT ) {
+            if ( _hot().mainObjectType == MP2::OBJ_BOAT ) {
                 return false;
             }
         }
@@ -1119,12 +1203,12 @@ bool Maps::Tile::isPassableFrom( const int direction, const bool fromWater, cons
         }
     }
     // HoMM1 has no naval travel. From the ground we cannot enter any water tile (boats are not usable).
-    else if ( tileIsWater && _mainObjectType != MP2::OBJ_SHIPWRECK && _mainObjectType != MP2::OBJ_HERO ) {
+    else if ( tileIsWater && _hot().mainObjectType != MP2::OBJ_SHIPWRECK && _hot().mainObjectType != MP2::OBJ_HERO ) {
         return false;
     }
 
     // Tiles on which allied heroes are located are inaccessible
-    if ( _mainObjectType == MP2::OBJ_HERO ) {
+    if ( _hot().mainObjectType == MP2::OBJ_HERO ) {
         const Heroes * hero = getHero();
         assert( hero != nullptr );
 
@@ -1134,7 +1218,7 @@ bool Maps::Tile::isPassableFrom( const int direction, const bool fromWater, cons
     }
 
     // Tiles on which the entrances to the allied castles are located are inaccessible
-    if ( _mainObjectType == MP2::OBJ_CASTLE ) {
+    if ( _hot().mainObjectType == MP2::OBJ_CASTLE ) {
         const Castle * castle = world.getCastleEntrance( GetCenter() );
         assert( castle != nullptr );
 
@@ -1143,7 +1227,7 @@ bool Maps::Tile::isPassableFrom( const int direction, const bool fromWater, cons
         }
     }
 
-    return ( direction & _tilePassabilityDirections ) != 0;
+    return ( direction & _hot().passabilityDirections ) != 0;
 }
 
 bool Maps::Tile::isStream() const
@@ -1487,10 +1571,15 @@ bool Maps::Tile::removeObjectPartsByUID( const uint32_t objectUID )
             world.getTile( tileIndex ).updatePassability();
         }
 
+        world.markTileChanged( _index );
+        for ( const int32_t tileIndex : tilesAround ) {
+            world.markTileChanged( tileIndex );
+        }
+
         if ( Heroes::isValidId( _occupantHeroId ) ) {
             Heroes * hero = world.GetHeroes( _occupantHeroId );
             if ( hero != nullptr ) {
-                hero->setObjectTypeUnderHero( _mainObjectType );
+                hero->setObjectTypeUnderHero( _hot().mainObjectType );
 
                 setMainObjectType( MP2::OBJ_HERO );
             }
@@ -1572,12 +1661,34 @@ void Maps::Tile::ClearFog( const PlayerColorsSet colors )
 {
     _fogColors &= ~colors;
 
+    world.markTileChanged( _index );
+
     // The fog might be cleared even without the hero's movement - for example, the hero can gain a new level of Scouting
     // skill by picking up a Treasure Chest from a nearby tile or buying a map in a Magellan's Maps object using the space
     // bar button. Reset the pathfinder(s) to make the newly discovered tiles immediately available for this hero.
     world.resetPathfinder();
 }
 
+uint16_t Maps::Tile::getFogDirection() const
+{
+    return world.getTileFogDirection( _index );
+}
+
+void Maps::Tile::setFogDirection( const uint16_t fogDirection )
+{
+    world.setTileFogDirection( _index, fogDirection );
+}
+
+uint32_t Maps::Tile::GetRegion() const
+{
+    return world.getTileRegion( _index );
+}
+
+void Maps::Tile::UpdateRegion( const uint32_t newRegionID )
+{
+    world.setTileRegion( _index, ( _hot().passabilityDirections != Direction::UNKNOWN ) ? newRegionID : static_cast<uint32_t>( REGION_NODE_BLOCKED ) );
+}
+
 void Maps::Tile::updateTileObjectIcnIndex( Maps::Tile & tile, const uint32_t uid, const uint8_t newIndex )
 {
     ObjectPart * part = tile.getGroundObjectPart( uid );
@@ -1593,7 +1704,7 @@ void Maps::Tile::updateTileObjectIcnIndex( Maps::Tile & tile, const uint32_t uid
 
 void Maps::Tile::updateObjectType()
 {
-    if ( _mainObjectType == MP2::OBJ_EVENT ) {
+    if ( _hot().mainObjectType == MP2::OBJ_EVENT ) {
         if ( world.GetMapEvent( Maps::GetPoint( _index ) ) == nullptr ) {
             // No data found for this event type. This may happen in the case of hacked maps.
             DEBUG_LOG( DBG_AI, DBG_INFO, "Adventure Map event at index " << _index << " is missing!" )
@@ -1904,14 +2015,14 @@ IStreamBase & Maps::operator>>( IStreamBase & stream, ObjectPart & ta )
 
 OStreamBase & Maps::operator<<( OStreamBase & stream, const Tile & tile )
 {
-    return stream << tile._index << tile._terrainImageIndex << tile._terrainFlags << tile._tilePassabilityDirections << tile._mainObjectPart << tile._mainObjectType
-                  << tile._fogColors << tile._metadata << tile._occupantHeroId << tile._isTileMarkedAsRoad << tile._groundObjectPart << tile._topObjectPart
-                  << tile._boatOwnerColor;
+    return stream << tile._index << tile._hot().terrainImageIndex << tile._terrainFlags << tile._hot().passabilityDirections << tile._mainObjectPart
+                  << tile._hot().mainObjectType << tile._fogColors << tile._metadata << tile._occupantHeroId << tile._isTileMarkedAsRoad << tile._groundObjectPart
+                  << tile._topObjectPart << tile._boatOwnerColor;
 }
 
 IStreamBase & Maps::operator>>( IStreamBase & stream, Tile & tile )
 {
-    stream >> tile._index >> tile._terrainImageIndex >> tile._terrainFlags >> tile._tilePassabilityDirections;
+    stream >> tile._index >> tile._hot().terrainImageIndex >> tile._terrainFlags >> tile._hot().passabilityDirections;
 
     static_assert( LAST_SUPPORTED_FORMAT_VERSION < FORMAT_VERSION_1104_RELEASE, "Remove the logic below." );
     if ( Game::GetVersionOfCurrentSaveFile() < FORMAT_VERSION_1104_RELEASE ) {
@@ -1936,10 +2047,10 @@ IStreamBase & Maps::operator>>( IStreamBase & stream, Tile & tile )
         uint8_t mainObjectType = static_cast<uint8_t>( MP2::OBJ_NONE );
         stream >> mainObjectType;
 
-        tile._mainObjectType = static_cast<MP2::MapObjectType>( mainObjectType );
+        tile._hot().mainObjectType = static_cast<MP2::MapObjectType>( mainObjectType );
     }
     else {
-        stream >> tile._mainObjectType;
+        stream >> tile._hot().mainObjectType;
     }
 
     stream >> tile._fogColors >> tile._metadata >> tile._occupantHeroId >> tile._isTileMarkedAsRoad >> tile._groundObjectPart >> tile._topObjectPart;
@@ -1949,7 +2060,7 @@ IStreamBase & Maps::operator>>( IStreamBase & stream, Tile & tile )
     }
 
     static_assert( LAST_SUPPORTED_FORMAT_VERSION < FORMAT_VERSION_1108_RELEASE, "Remove the logic below." );
-    if ( Game::GetVersionOfCurrentSaveFile() < FORMAT_VERSION_1108_RELEASE && tile._mainObjectType == MP2::OBJ_MINE
+    if ( Game::GetVersionOfCurrentSaveFile() < FORMAT_VERSION_1108_RELEASE && tile._hot().mainObjectType == MP2::OBJ_MINE
          && tile.getMainObjectPart().icnType != MP2::OBJ_ICN_TYPE_EXTRAOVR ) {
         // Some maps have "hacked" mines with no resources. We need to try to fix these tiles.
         updateObjectInfoTile( tile, true );
@@ -1957,3 +2068,84 @@ IStreamBase & Maps::operator>>( IStreamBase & stream, Tile & tile )
 
     return stream >> tile._boatOwnerColor;
 }
+
+void Maps::saveTiles( OStreamBase & stream, const std::vector<Tile> & tiles )
+{
+    stream.put32( static_cast<uint32_t>( tiles.size() ) );
+
+    saveMember<int32_t>( stream, tiles, []( const Tile & tile ) { return tile._index; } );
+    saveMember<uint16_t>( stream, tiles, []( const Tile & tile ) { return tile._hot().terrainImageIndex; } );
+    saveMember<uint8_t>( stream, tiles, []( const Tile & tile ) { return tile._terrainFlags; } );
+    saveMember<uint16_t>( stream, tiles, []( const Tile & tile ) { return tile._hot().passabilityDirections; } );
+    saveMember<MP2::MapObjectType>( stream, tiles, []( const Tile & tile ) { return tile._hot().mainObjectType; } );
+    saveMember<PlayerColorsSet>( stream, tiles, []( const Tile & tile ) { return tile._fogColors; } );
+
+    for ( size_t i = 0; i < std::tuple_size_v<decltype( Tile::_metadata )>; ++i ) {
+        saveMember<uint32_t>( stream, tiles, [i]( const Tile & tile ) { return tile._metadata[i]; } );
+    }
+
+    saveMember<uint8_t>( stream, tiles, []( const Tile & tile ) { return tile._occupantHeroId; } );
+    saveMember<uint8_t>( stream, tiles, []( const Tile & tile ) { return static_cast<uint8_t>( tile._isTileMarkedAsRoad ? 1 : 0 ); } );
+    saveMember<PlayerColor>( stream, tiles, []( const Tile & tile ) { return tile._boatOwnerColor; } );
+
+    std::vector<const ObjectPart *> mainObjectParts;
+    std::vector<const ObjectPartList *> groundObjectParts;
+    std::vector<const ObjectPartList *> topObjectParts;
+
+    mainObjectParts.reserve( tiles.size() );
+    groundObjectParts.reserve( tiles.size() );
+    topObjectParts.reserve( tiles.size() );
+
+    for ( const Tile & tile : tiles ) {
+        mainObjectParts.emplace_back( &tile._mainObjectPart );
+        groundObjectParts.emplace_back( &tile._groundObjectPart );
+        topObjectParts.emplace_back( &tile._topObjectPart );
+    }
+
+    saveObjectParts( stream, mainObjectParts );
+    saveObjectPartLists( stream, groundObjectParts );
+    saveObjectPartLists( stream, topObjectParts );
+}
+
+void Maps::loadTiles( IStreamBase & stream, std::vector<Tile> & tiles )
+{
+    tiles.clear();
+    tiles.resize( stream.get32() );
+
+    loadMember<int32_t>( stream, tiles, []( Tile & tile, const int32_t value ) { tile._index = value; } );
+    loadMember<uint16_t>( stream, tiles, []( Tile & tile, const uint16_t value ) { tile._hot().terrainImageIndex = value; } );
+    loadMember<uint8_t>( stream, tiles, []( Tile & tile, const uint8_t value ) { tile._terrainFlags = value; } );
+    loadMember<uint16_t>( stream, tiles, []( Tile & tile, const uint16_t value ) { tile._hot().passabilityDirections = value; } );
+    loadMember<MP2::MapObjectType>( stream, tiles, []( Tile & tile, const MP2::MapObjectType value ) { tile._hot().mainObjectType = value; } );
+    loadMember<PlayerColorsSet>( stream, tiles, []( Tile & tile, const PlayerColorsSet value ) { tile._fogColors = value; } );
+
+    for ( size_t i = 0; i < std::tuple_size_v<decltype( Tile::_metadata )>; ++i ) {
+        loadMember<uint32_t>( stream, tiles, [i]( Tile & tile, const uint32_t value ) { tile._metadata[i] = value; } );
+    }
+
+    loadMember<uint8_t>( stream, tiles, []( Tile & tile, const uint8_t value ) { tile._occupantHeroId = value; } );
+    loadMember<uint8_t>( stream, tiles, []( Tile & tile, const uint8_t value ) { tile._isTileMarkedAsRoad = ( value != 0 ); } );
+    loadMember<PlayerColor>( stream, tiles, []( Tile & tile, const PlayerColor value ) { tile._boatOwnerColor = value; } );
+
+    if ( stream.fail() ) {
+        return;
+    }
+
+    std::vector<ObjectPart *> mainObjectParts;
+    std::vector<ObjectPartList *> groundObjectParts;
+    std::vector<ObjectPartList *> topObjectParts;
+
+    mainObjectParts.reserve( tiles.size() );
+    groundObjectParts.reserve( tiles.size() );
+    topObjectParts.reserve( tiles.size() );
+
+    for ( Tile & tile : tiles ) {
+        mainObjectParts.emplace_back( &tile._mainObjectPart );
+        groundObjectParts.emplace_back( &tile._groundObjectPart );
+        topObjectParts.emplace_back( &tile._topObjectPart );
+    }
+
+    loadObjectParts( stream, mainObjectParts );
+    loadObjectPartLists( stream, groundObjectParts );
+    loadObjectPartLists( stream, topObjectParts );
+}
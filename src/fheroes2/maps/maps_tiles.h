@@ -34,6 +34,7 @@
 #include "ground.h"
 #include "heroes.h"
 #include "math_base.h"
+#include "memory_arena.h"
 #include "mp2.h"
 #include "world_regions.h"
 
@@ -96,6 +97,86 @@ namespace Maps
         uint8_t icnIndex{ 255 };
     };
 
+    // Object parts of all tiles are allocated from a shared arena instead of being separate heap allocations.
+    using ObjectPartList = std::list<ObjectPart, fheroes2::ArenaAllocator<ObjectPart>>;
+
+    // Tile data which is read most often: by the pathfinder, the radar, the AI and the rendering.
+    struct TileHotData
+    {
+        uint16_t passabilityDirections{ DIRECTION_ALL };
+
+        uint16_t terrainImageIndex{ 0 };
+
+        // Each tile has a main object type which is served as an indicator
+        // whether the tile has any action type object and also as information
+        // for users to read about this tile.
+        MP2::MapObjectType mainObjectType{ MP2::OBJ_NONE };
+
+        bool isWater() const
+        {
+            // Even though it seems like a dangerous way of detecting the water terrain,
+            // terrain images are fixed in resources and never going to be changed.
+            return terrainImageIndex < Ground::GRASS_START_IMAGE_INDEX;
+        }
+
+        bool operator==( const TileHotData & other ) const
+        {
+            return passabilityDirections == other.passabilityDirections && terrainImageIndex == other.terrainImageIndex && mainObjectType == other.mainObjectType;
+        }
+    };
+
+    // Holder of the hot data of a tile. Tiles of the world keep this data in a dense array of the world (see World::_resetTileData()),
+    // so loops over many tiles do not have to pull whole tiles into the cache. Any other tile (a copy of a world tile, a tile used
+    // to read a map file) keeps the data inline. A copy always keeps its data inline, while an assignment writes the data wherever
+    // the target tile keeps it, so tiles remain regular values.
+    class TileHotDataHolder
+    {
+    public:
+        TileHotDataHolder() = default;
+
+        TileHotDataHolder( const TileHotDataHolder & other )
+            : _inlineData( *other._data )
+        {
+            // Do nothing.
+        }
+
+        ~TileHotDataHolder() = default;
+
+        TileHotDataHolder & operator=( const TileHotDataHolder & other )
+        {
+            *_data = *other._data;
+            return *this;
+        }
+
+        const TileHotData & get() const
+        {
+            return *_data;
+        }
+
+        TileHotData & get()
+        {
+            return *_data;
+        }
+
+        // Moves the data to the given external storage. The storage must outlive the holder or the holder must be detached before.
+        void attach( TileHotData & storage )
+        {
+            storage = *_data;
+            _data = &storage;
+        }
+
+        // Moves the data back inside the holder.
+        void detach()
+        {
+            _inlineData = *_data;
+            _data = &_inlineData;
+        }
+
+    private:
+        TileHotData _inlineData;
+        TileHotData * _data{ &_inlineData };
+    };
+
     class Tile
     {
     public:
@@ -104,9 +185,8 @@ namespace Maps
         bool operator==( const Tile & tile ) const
         {
             return ( _groundObjectPart == tile._groundObjectPart ) && ( _topObjectPart == tile._topObjectPart ) && ( _index == tile._index )
-                   && ( _terrainImageIndex == tile._terrainImageIndex ) && ( _terrainFlags == tile._terrainFlags ) && ( _mainObjectPart == tile._mainObjectPart )
-                   && ( _mainObjectType == tile._mainObjectType ) && ( _metadata == tile._metadata ) && ( _tilePassabilityDirections == tile._tilePassabilityDirections )
-                   && ( _isTileMarkedAsRoad == tile._isTileMarkedAsRoad ) && ( _occupantHeroId == tile._occupantHeroId );
+                   && ( _hot() == tile._hot() ) && ( _terrainFlags == tile._terrainFlags ) && ( _mainObjectPart == tile._mainObjectPart )
+                   && ( _metadata == tile._metadata ) && ( _isTileMarkedAsRoad == tile._isTileMarkedAsRoad ) && ( _occupantHeroId == tile._occupantHeroId );
         }
 
         bool operator!=( const Tile & tile ) const
@@ -130,12 +210,12 @@ namespace Maps
 
         MP2::MapObjectType getMainObjectType() const
         {
-            return _mainObjectType;
+            return _hot().mainObjectType;
         }
 
-        constexpr MP2::MapObjectType getMainObjectType( const bool ignoreObjectUnderHero ) const
+        MP2::MapObjectType getMainObjectType( const bool ignoreObjectUnderHero ) const
         {
-            return ignoreObjectUnderHero ? _mainObjectType : _getMainObjectTypeUnderHero();
+            return ignoreObjectUnderHero ? _hot().mainObjectType : _getMainObjectTypeUnderHero();
         }
 
         const ObjectPart & getMainObjectPart() const
@@ -150,19 +230,17 @@ namespace Maps
 
         uint16_t GetPassable() const
         {
-            return _tilePassabilityDirections;
+            return _hot().passabilityDirections;
         }
 
         int GetGround() const
         {
-            return Ground::getGroundByImageIndex( _terrainImageIndex );
+            return Ground::getGroundByImageIndex( _hot().terrainImageIndex );
         }
 
         bool isWater() const
         {
-            // Even though it seems like a dangerous way of detecting the water terrain,
-            // terrain images are fixed in resources and never going to be changed.
-            return _terrainImageIndex < Ground::GRASS_START_IMAGE_INDEX;
+            return _hot().isWater();
         }
 
         // Returns true if tile's main and ground layer object parts do not contain any objects: layer type is SHADOW or TERRAIN.
@@ -171,7 +249,7 @@ namespace Maps
         // Checks whether it is possible to move into this tile from the specified direction
         bool isPassableFrom( const int direction ) const
         {
-            return ( direction & _tilePassabilityDirections ) != 0;
+            return ( direction & _hot().passabilityDirections ) != 0;
         }
 
         // Checks whether it is possible to move into this tile from the specified direction under the specified conditions
@@ -180,7 +258,7 @@ namespace Maps
         // Checks whether it is possible to exit this tile in the specified direction
         bool isPassableTo( const int direction ) const
         {
-            return ( direction & _tilePassabilityDirections ) != 0;
+            return ( direction & _hot().passabilityDirections ) != 0;
         }
 
         void updateRoadFlag();
@@ -230,15 +308,9 @@ namespace Maps
             _mainObjectPart = {};
         }
 
-        uint32_t GetRegion() const
-        {
-            return _region;
-        }
-
-        void UpdateRegion( const uint32_t newRegionID )
-        {
-            _region = ( _tilePassabilityDirections != Direction::UNKNOWN ) ? newRegionID : static_cast<uint32_t>( REGION_NODE_BLOCKED );
-        }
+        // The region is stored by the world, so these methods can be called only for the tiles of the world.
+        uint32_t GetRegion() const;
+        void UpdateRegion( const uint32_t newRegionID );
 
         // Set initial passability based on information read from mp2 and addon structures.
         void setInitialPassability();
@@ -249,10 +321,8 @@ namespace Maps
         void setOwnershipFlag( const MP2::MapObjectType objectType, PlayerColor color );
 
         // Return fog direction of tile. A tile without fog returns "Direction::UNKNOWN".
-        uint16_t getFogDirection() const
-        {
-            return _fogDirection;
-        }
+        // The fog direction is stored by the world, so this method can be called only for the tiles of the world.
+        uint16_t getFogDirection() const;
 
         void pushGroundObjectPart( ObjectPart part );
 
@@ -261,17 +331,17 @@ namespace Maps
             _topObjectPart.emplace_back( part );
         }
 
-        const std::list<ObjectPart> & getGroundObjectParts() const
+        const ObjectPartList & getGroundObjectParts() const
         {
             return _groundObjectPart;
         }
 
-        std::list<ObjectPart> & getGroundObjectParts()
+        ObjectPartList & getGroundObjectParts()
         {
             return _groundObjectPart;
         }
 
-        const std::list<ObjectPart> & getTopObjectParts() const
+        const ObjectPartList & getTopObjectParts() const
         {
             return _topObjectPart;
         }
@@ -309,6 +379,11 @@ namespace Maps
             return ( _fogColors & colors ) == colors;
         }
 
+        PlayerColorsSet getFogColors() const
+        {
+            return _fogColors;
+        }
+
         void ClearFog( const PlayerColorsSet colors );
 
         const std::array<uint32_t, 3> & metadata() const
@@ -328,13 +403,24 @@ namespace Maps
 
         uint16_t getTerrainImageIndex() const
         {
-            return _terrainImageIndex;
+            return _hot().terrainImageIndex;
         }
 
         void setTerrain( const uint16_t terrainImageIndex, const uint8_t terrainFlags )
         {
             _terrainFlags = terrainFlags;
-            _terrainImageIndex = terrainImageIndex;
+            _hot().terrainImageIndex = terrainImageIndex;
+        }
+
+        // Do NOT call these methods directly!!! They are used by the world to manage the storage of its tiles.
+        void attachHotData( TileHotData & storage )
+        {
+            _hotData.attach( storage );
+        }
+
+        void detachHotData()
+        {
+            _hotData.detach();
         }
 
         Heroes * getHero() const;
@@ -353,10 +439,7 @@ namespace Maps
         bool containsSprite( const MP2::ObjectIcnType objectIcnType, const uint32_t imageIdx ) const;
 
         // Do NOT call this method directly!!!
-        void setFogDirection( const uint16_t fogDirection )
-        {
-            _fogDirection = fogDirection;
-        }
+        void setFogDirection( const uint16_t fogDirection );
 
         // Some tiles have incorrect object type. This is due to original Editor issues.
         static void fixMP2MapTileObjectType( Tile & tile );
@@ -386,52 +469,59 @@ namespace Maps
 
         MP2::MapObjectType _getMainObjectTypeUnderHero() const;
 
+        const TileHotData & _hot() const
+        {
+            return _hotData.get();
+        }
+
+        TileHotData & _hot()
+        {
+            return _hotData.get();
+        }
+
         friend OStreamBase & operator<<( OStreamBase & stream, const Tile & tile );
         friend IStreamBase & operator>>( IStreamBase & stream, Tile & tile );
 
-        // The following members are used in the Editor and in the game.
+        friend void saveTiles( OStreamBase & stream, const std::vector<Tile> & tiles );
+        friend void loadTiles( IStreamBase & stream, std::vector<Tile> & tiles );
 
-        ObjectPart _mainObjectPart;
+        // Passability, terrain image index and main object type.
+        TileHotDataHolder _hotData;
 
-        std::list<ObjectPart> _groundObjectPart;
+        // This member is only used in the game.
+        PlayerColorsSet _fogColors{ Color::allPlayerColors() };
 
-        std::list<ObjectPart> _topObjectPart;
+        uint8_t _terrainFlags{ 0 };
 
-        int32_t _index{ 0 };
+        // The following members are used in the Editor and in the game.
 
-        uint16_t _terrainImageIndex{ 0 };
+        int32_t _index{ 0 };
 
-        // Each tile has a main object type which is served as an indicator
-        // whether the tile has any action type object and also as information
-        // for users to read about this tile.
-        MP2::MapObjectType _mainObjectType{ MP2::OBJ_NONE };
+        bool _isTileMarkedAsRoad{ false };
 
-        std::array<uint32_t, 3> _metadata{ 0 };
+        uint8_t _occupantHeroId{ Heroes::UNKNOWN };
 
-        uint16_t _tilePassabilityDirections{ DIRECTION_ALL };
+        ObjectPart _mainObjectPart;
 
-        uint8_t _terrainFlags{ 0 };
+        std::array<uint32_t, 3> _metadata{ 0 };
 
-        bool _isTileMarkedAsRoad{ false };
+        ObjectPartList _groundObjectPart;
 
-        uint8_t _occupantHeroId{ Heroes::UNKNOWN };
+        ObjectPartList _topObjectPart;
 
         // The following members are only used in the game.
 
-        PlayerColorsSet _fogColors{ Color::allPlayerColors() };
-
         // Heroes can only summon neutral empty boats or empty boats belonging to their kingdom.
         PlayerColor _boatOwnerColor{ PlayerColor::NONE };
-
-        // Fog direction to render fog in Game Area.
-        uint16_t _fogDirection{ DIRECTION_ALL };
-
-        // This field does not persist in savegame.
-        uint32_t _region{ REGION_NODE_BLOCKED };
     };
 
     OStreamBase & operator<<( OStreamBase & stream, const ObjectPart & ta );
     OStreamBase & operator<<( OStreamBase & stream, const Tile & tile );
     IStreamBase & operator>>( IStreamBase & stream, ObjectPart & ta );
     IStreamBase & operator>>( IStreamBase & stream, Tile & tile );
+
+    // Tiles are saved member by member: values of the same member of all tiles are stored as one array which is much faster
+    // to read and write than tiles one by one.
+    void saveTiles( OStreamBase & stream, const std::vector<Tile> & tiles );
+    void loadTiles( IStreamBase & stream, std::vector<Tile> & tiles );
 }
@@ -442,7 +442,9 @@ IStreamBase & operator>>( IStreamBase & stream, Artifact & art )
 
 BagArtifacts::BagArtifacts()
     : std::vector<Artifact>( maxCapacity, Artifact::UNKNOWN )
-{}
+{
+    updateEffectTable();
+}
 
 bool BagArtifacts::ContainSpell( const int spellId ) const
 {
@@ -491,35 +493,16 @@ int32_t BagArtifacts::getTotalArtifactEffectValue( const fheroes2::ArtifactBonus
     // If this assertion blows up you're calling the method for a wrong type.
     assert( !fheroes2::isBonusMultiplied( bonus ) && !fheroes2::isBonusUnique( bonus ) );
 
-    int32_t totalValue = 0;
-
-    if ( fheroes2::isBonusCumulative( bonus ) ) {
-        for ( const Artifact & artifact : *this ) {
-            const std::vector<fheroes2::ArtifactBonus> & bonuses = fheroes2::getArtifactData( artifact.GetID() ).bonuses;
-            auto bonusIter = std::find( bonuses.begin(), bonuses.end(), fheroes2::ArtifactBonus( bonus ) );
-            if ( bonusIter != bonuses.end() ) {
-                totalValue += bonusIter->value;
-            }
-        }
-    }
-    else {
-        std::set<int> usedArtifactIds;
-        for ( const Artifact & artifact : *this ) {
-            const int artifactId = artifact.GetID();
-            if ( !usedArtifactIds.insert( artifactId ).second ) {
-                // The artifact is present in multiple copies.
-                continue;
-            }
+    const size_t bonusIdx = static_cast<size_t>( bonus );
+    assert( bonusIdx < fheroes2::artifactBonusTypeCount );
 
-            const std::vector<fheroes2::ArtifactBonus> & bonuses = fheroes2::getArtifactData( artifactId ).bonuses;
-            auto bonusIter = std::find( bonuses.begin(), bonuses.end(), fheroes2::ArtifactBonus( bonus ) );
-            if ( bonusIter != bonuses.end() ) {
-                totalValue += bonusIter->value;
-            }
-        }
+    if ( _isEffectTableValid() ) {
+        return _effectTable.bonuses[bonusIdx];
     }
 
-    return totalValue;
+    // The artifacts were changed directly, the table is outdated. It is not updated here because this method can be called by several
+    // threads at once.
+    return _calculateEffectTable( *this ).bonuses[bonusIdx];
 }
 
 int32_t BagArtifacts::getTotalArtifactEffectValue( const fheroes2::ArtifactBonusType bonus, std::string & description ) const
@@ -581,35 +564,14 @@ int32_t BagArtifacts::getTotalArtifactEffectValue( const fheroes2::ArtifactCurse
     // If this assertion blows up you're calling the method for a wrong type.
     assert( !fheroes2::isCurseMultiplied( curse ) && !fheroes2::isCurseUnique( curse ) );
 
-    int32_t totalValue = 0;
+    const size_t curseIdx = static_cast<size_t>( curse );
+    assert( curseIdx < fheroes2::artifactCurseTypeCount );
 
-    if ( fheroes2::isCurseCumulative( curse ) ) {
-        for ( const Artifact & artifact : *this ) {
-            const std::vector<fheroes2::ArtifactCurse> & curses = fheroes2::getArtifactData( artifact.GetID() ).curses;
-            auto curseIter = std::find( curses.begin(), curses.end(), fheroes2::ArtifactCurse( curse ) );
-            if ( curseIter != curses.end() ) {
-                totalValue += curseIter->value;
-            }
-        }
+    if ( _isEffectTableValid() ) {
+        return _effectTable.curses[curseIdx];
     }
-    else {
-        std::set<int> usedArtifactIds;
-        for ( const Artifact & artifact : *this ) {
-            const int artifactId = artifact.GetID();
-            if ( !usedArtifactIds.insert( artifactId ).second ) {
-                // The artifact is present in multiple copies.
-                continue;
-            }
 
-            const std::vector<fheroes2::ArtifactCurse> & curses = fheroes2::getArtifactData( artifactId ).curses;
-            auto curseIter = std::find( curses.begin(), curses.end(), fheroes2::ArtifactCurse( curse ) );
-            if ( curseIter != curses.end() ) {
-                totalValue += curseIter->value;
-            }
-        }
-    }
-
-    return totalValue;
+    return _calculateEffectTable( *this ).curses[curseIdx];
 }
 
 int32_t BagArtifacts::getTotalArtifactEffectValue( const fheroes2::ArtifactCurseType curse, std::string & description ) const
@@ -770,6 +732,8 @@ bool BagArtifacts::PushArtifact( const Artifact & art )
     if ( art.GetID() != Artifact::MAGIC_BOOK ) {
         *firstEmptySlotIter = art;
 
+        updateEffectTable();
+
         return true;
     }
 
@@ -779,6 +743,8 @@ bool BagArtifacts::PushArtifact( const Artifact & art )
     // ... and then put the Magic Book to the first slot of the artifact bag.
     front() = art;
 
+    updateEffectTable();
+
     return true;
 }
 
@@ -790,6 +756,8 @@ void BagArtifacts::RemoveArtifact( const Artifact & art )
     }
 
     it->Reset();
+
+    updateEffectTable();
 }
 
 bool BagArtifacts::isFull() const
@@ -1282,9 +1250,65 @@ std::set<ArtifactSetData> BagArtifacts::assembleArtifactSetIfPossible()
         }
     }
 
+    // This method is usually called after the artifacts have been moved between bags directly.
+    updateEffectTable();
+
     return assembledArtifactSets;
 }
 
+void BagArtifacts::updateEffectTable()
+{
+    _effectTable = _calculateEffectTable( *this );
+}
+
+bool BagArtifacts::_isEffectTableValid() const
+{
+    if ( size() != maxCapacity ) {
+        return false;
+    }
+
+    for ( size_t i = 0; i < maxCapacity; ++i ) {
+        if ( operator[]( i ).GetID() != _effectTable.artifactIds[i] ) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+BagArtifacts::EffectTable BagArtifacts::_calculateEffectTable( const BagArtifacts & bag )
+{
+    EffectTable table;
+
+    for ( size_t i = 0; i < bag.size(); ++i ) {
+        const int32_t artifactId = bag[i].GetID();
+
+        if ( i < maxCapacity ) {
+            table.artifactIds[i] = artifactId;
+        }
+
+        // Only cumulative bonuses and curses are taken into account for each copy of the artifact.
+        const bool isFirstCopy = std::none_of( bag.begin(), bag.begin() + static_cast<ptrdiff_t>( i ),
+                                               [artifactId]( const Artifact & artifact ) { return artifact.GetID() == artifactId; } );
+
+        const fheroes2::ArtifactData & data = fheroes2::getArtifactData( artifactId );
+
+        for ( const fheroes2::ArtifactBonus & bonus : data.bonuses ) {
+            if ( isFirstCopy || fheroes2::isBonusCumulative( bonus.type ) ) {
+                table.bonuses[static_cast<size_t>( bonus.type )] += bonus.value;
+            }
+        }
+
+        for ( const fheroes2::ArtifactCurse & curse : data.curses ) {
+            if ( isFirstCopy || fheroes2::isCurseCumulative( curse.type ) ) {
+                table.curses[static_cast<size_t>( curse.type )] += curse.value;
+            }
+        }
+    }
+
+    return table;
+}
+
 bool ArtifactSetData::operator<( const ArtifactSetData & other ) const
 {
     return _assembledArtifactID < other._assembledArtifactID;
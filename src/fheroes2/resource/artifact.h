@@ -23,6 +23,7 @@
 
 #pragma once
 
+#include <array>
 #include <cstddef>
 #include <cstdint>
 #include <set>
@@ -341,7 +342,28 @@ public:
 
     std::set<ArtifactSetData> assembleArtifactSetIfPossible();
 
+    // Updates the table of total bonus and curse values. It is called by all methods of this class changing the artifacts, and it should
+    // also be called after the artifacts are changed directly. Otherwise, the totals are calculated from scratch on every query.
+    void updateEffectTable();
+
     std::string String() const;
+
+private:
+    // Total values of bonuses and curses (taking into account whether they are cumulative or not) indexed by their types, as well as
+    // the IDs of the artifacts in the bag for which these values were calculated.
+    struct EffectTable
+    {
+        std::array<int32_t, maxCapacity> artifactIds{};
+        std::array<int32_t, fheroes2::artifactBonusTypeCount> bonuses{};
+        std::array<int32_t, fheroes2::artifactCurseTypeCount> curses{};
+    };
+
+    // Returns true if the table was calculated for the current artifacts.
+    bool _isEffectTableValid() const;
+
+    static EffectTable _calculateEffectTable( const BagArtifacts & bag );
+
+    EffectTable _effectTable;
 };
 
 class ArtifactsBar : public Interface::ItemsActionBar<Artifact>
@@ -20,6 +20,7 @@
 
 #pragma once
 
+#include <cstddef>
 #include <cstdint>
 #include <string>
 #include <vector>
@@ -58,6 +59,10 @@ namespace fheroes2
         MORALE
     };
 
+    // These values must be updated when new bonus or curse types are added.
+    constexpr size_t artifactBonusTypeCount{ static_cast<size_t>( ArtifactBonusType::LUCK ) + 1 };
+    constexpr size_t artifactCurseTypeCount{ static_cast<size_t>( ArtifactCurseType::MORALE ) + 1 };
+
     struct ArtifactBonus
     {
         explicit ArtifactBonus( const ArtifactBonusType type_ )
@@ -23,6 +23,7 @@
 
 #include <algorithm>
 #include <cassert>
+#include <cstddef>
 #include <cstdlib>
 #include <sstream>
 #include <utility>
@@ -44,6 +45,7 @@
 #include "settings.h"
 #include "system.h"
 #include "tinyconfig.h"
+#include "tools.h"
 #include "translations.h"
 #include "ui_language.h"
 #include "version.h"
@@ -327,6 +329,21 @@ bool Settings::Read( const std::string & filePath )
         setVSync( config.StrParams( "v-sync" ) == "on" );
     }
 
+    if ( config.Exists( "preload resources" ) ) {
+        _preloadedResources.clear();
+
+        for ( const std::string & resource : StringSplit( config.StrParams( "preload resources" ), ',' ) ) {
+            std::string name = StringTrim( resource );
+            if ( !name.empty() ) {
+                _preloadedResources.emplace_back( std::move( name ) );
+            }
+        }
+    }
+
+    if ( config.Exists( "ai battle simulation time" ) ) {
+        _aiBattleSimulationTime = std::clamp( config.IntParams( "ai battle simulation time" ), 0, 10000 );
+    }
+
     if ( config.Exists( "text support mode" ) ) {
         setTextSupportMode( config.StrParams( "text support mode" ) == "on" );
     }
@@ -534,6 +551,16 @@ std::string Settings::String() const
     os << std::endl << "# Enable V-Sync (Vertical Synchronization) for rendering" << std::endl;
     os << "v-sync = " << ( _gameOptions.Modes( GAME_RENDER_VSYNC ) ? "on" : "off" ) << std::endl;
 
+    os << std::endl << "# Comma-separated list of resources to decode in the background at startup: adventure, battle, castle, dialogs or ICN/TIL file names" << std::endl;
+    os << "preload resources = ";
+    for ( size_t i = 0; i < _preloadedResources.size(); ++i ) {
+        os << ( i > 0 ? ", " : "" ) << _preloadedResources[i];
+    }
+    os << std::endl;
+
+    os << std::endl << "# Time in milliseconds per AI turn to simulate battles whose outcome is unclear from army strengths: 0 - 10000 (0 - disabled)" << std::endl;
+    os << "ai battle simulation time = " << _aiBattleSimulationTime << std::endl;
+
     os << std::endl << "# Enable text support mode that outputs extra information in console window: on/off" << std::endl;
     os << "text support mode = " << ( _gameOptions.Modes( GAME_TEXT_SUPPORT_MODE ) ? "on" : "off" ) << std::endl;
 
@@ -367,6 +367,19 @@ public:
         return _controllerPointerSpeed;
     }
 
+    // Resources that should be decoded in the background at startup. An empty list means that resources are decoded only on demand.
+    const std::vector<std::string> & getPreloadedResources() const
+    {
+        return _preloadedResources;
+    }
+
+    // Time in milliseconds which AI may spend during its turn on simulations of battles whose outcome is unclear from army strengths.
+    // Zero means that AI relies on army strengths only.
+    int aiBattleSimulationTime() const
+    {
+        return _aiBattleSimulationTime;
+    }
+
     ZoomLevel ViewWorldZoomLevel() const
     {
         return _viewWorldZoomLevel;
@@ -419,6 +432,9 @@ private:
     std::string _programPath;
 
     std::string _gameLanguage;
+
+    std::vector<std::string> _preloadedResources;
+
     // Not saved in the config file or savefile
     std::string _loadedFileLanguage;
 
@@ -430,6 +446,7 @@ private:
     int music_volume;
     MusicSource _musicType;
     int _controllerPointerSpeed;
+    int _aiBattleSimulationTime{ 0 };
     int heroes_speed;
     int ai_speed;
     int scroll_speed;
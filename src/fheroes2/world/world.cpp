@@ -295,6 +295,26 @@ void World::Defaults()
     vec_castles.Init();
 }
 
+void World::_resetTileData()
+{
+    // The hot data of the tiles is kept, only its storage is replaced
+    for ( Maps::Tile & tile : vec_tiles ) {
+        tile.detachHotData();
+    }
+
+    _tileHotData.assign( vec_tiles.size(), {} );
+
+    for ( size_t i = 0; i < vec_tiles.size(); ++i ) {
+        vec_tiles[i].attachHotData( _tileHotData[i] );
+    }
+
+    _tileRegions.assign( vec_tiles.size(), REGION_NODE_BLOCKED );
+    _tileFogDirections.assign( vec_tiles.size(), DIRECTION_ALL );
+
+    _changedTiles.clear();
+    ++_tileChangesEpoch;
+}
+
 void World::Reset()
 {
     width = 0;
@@ -302,6 +322,7 @@ void World::Reset()
 
     // maps tiles
     vec_tiles.clear();
+    _resetTileData();
 
     // kingdoms
     vec_kingdoms.clear();
@@ -381,6 +402,7 @@ void World::generateUninitializedMap( const int32_t size )
     // The tiles are cleared and resizing their vector also initializes tiles with the default values.
     assert( vec_tiles.empty() );
     vec_tiles.resize( static_cast<size_t>( width ) * height );
+    _resetTileData();
 }
 
 const Castle * World::getCastleEntrance( const fheroes2::Point & tilePosition ) const
@@ -424,6 +446,7 @@ const Week & World::GetWeekType() const
 void World::NewDay()
 {
     ++_day;
+    ++_revision;
 
     if ( BeginWeek() ) {
         ++_week;
@@ -1192,10 +1215,27 @@ std::list<Route::Step> World::getPath( const Heroes & hero, int targetIndex )
 
 void World::resetPathfinder()
 {
+    ++_revision;
+
     _pathfinder.reset();
     AI::Planner::Get().resetPathfinder();
 }
 
+void World::markTileChanged( const int32_t tileIndex )
+{
+    if ( tileIndex < 0 || static_cast<size_t>( tileIndex ) >= vec_tiles.size() ) {
+        return;
+    }
+
+    // It is cheaper to rebuild the grids from scratch than to process a log which is longer than the map itself
+    if ( _changedTiles.size() >= vec_tiles.size() ) {
+        _changedTiles.clear();
+        ++_tileChangesEpoch;
+    }
+
+    _changedTiles.push_back( tileIndex );
+}
+
 void World::updatePassabilities()
 {
     for ( Maps::Tile & tile : vec_tiles ) {
@@ -1211,6 +1251,9 @@ void World::updatePassabilities()
     for ( Maps::Tile & tile : vec_tiles ) {
         tile.updatePassability();
     }
+
+    _changedTiles.clear();
+    ++_tileChangesEpoch;
 }
 
 void World::PostLoad( const bool setTilePassabilities, const bool updateUidCounterToMaximum )
@@ -1469,7 +1512,11 @@ IStreamBase & operator>>( IStreamBase & stream, MapObjects & objs )
 
 OStreamBase & operator<<( OStreamBase & stream, const World & w )
 {
-    return stream << w.width << w.height << w.vec_tiles << w.vec_heroes << w.vec_castles << w.vec_kingdoms << w._customRumors << w.vec_eventsday << w.map_captureobj
+    stream << w.width << w.height;
+
+    Maps::saveTiles( stream, w.vec_tiles );
+
+    return stream << w.vec_heroes << w.vec_castles << w.vec_kingdoms << w._customRumors << w.vec_eventsday << w.map_captureobj
                   << w._ultimateArtifact << w._day << w._week << w._month << w.heroIdAsWinCondition << w.heroIdAsLossCondition << w.map_objects << w._seed;
 }
 
@@ -1488,7 +1535,17 @@ IStreamBase & operator>>( IStreamBase & stream, World & w )
         stream >> w.width >> w.height;
     }
 
-    stream >> w.vec_tiles >> w.vec_heroes >> w.vec_castles >> w.vec_kingdoms >> w._customRumors >> w.vec_eventsday >> w.map_captureobj >> w._ultimateArtifact >> w._day
+    static_assert( LAST_SUPPORTED_FORMAT_VERSION < FORMAT_VERSION_PRE1_1112_RELEASE, "Remove the logic below." );
+    if ( Game::GetVersionOfCurrentSaveFile() < FORMAT_VERSION_PRE1_1112_RELEASE ) {
+        stream >> w.vec_tiles;
+    }
+    else {
+        Maps::loadTiles( stream, w.vec_tiles );
+    }
+
+    w._resetTileData();
+
+    stream >> w.vec_heroes >> w.vec_castles >> w.vec_kingdoms >> w._customRumors >> w.vec_eventsday >> w.map_captureobj >> w._ultimateArtifact >> w._day
         >> w._week >> w._month >> w.heroIdAsWinCondition >> w.heroIdAsLossCondition;
 
     static_assert( LAST_SUPPORTED_FORMAT_VERSION < FORMAT_VERSION_1010_RELEASE, "Remove the logic below." );
@@ -271,6 +271,53 @@ public:
 #endif
     }
 
+    // Returns the passability, the terrain image index and the main object type of the tile. This is faster than getting them from
+    // the tile itself when many tiles are processed in a loop.
+    const Maps::TileHotData & getTileHotData( const int32_t tileId ) const
+    {
+#ifdef WITH_DEBUG
+        return _tileHotData.at( tileId );
+#else
+        return _tileHotData[tileId];
+#endif
+    }
+
+    uint32_t getTileRegion( const int32_t tileId ) const
+    {
+#ifdef WITH_DEBUG
+        return _tileRegions.at( tileId );
+#else
+        return _tileRegions[tileId];
+#endif
+    }
+
+    void setTileRegion( const int32_t tileId, const uint32_t regionId )
+    {
+#ifdef WITH_DEBUG
+        _tileRegions.at( tileId ) = regionId;
+#else
+        _tileRegions[tileId] = regionId;
+#endif
+    }
+
+    uint16_t getTileFogDirection( const int32_t tileId ) const
+    {
+#ifdef WITH_DEBUG
+        return _tileFogDirections.at( tileId );
+#else
+        return _tileFogDirections[tileId];
+#endif
+    }
+
+    void setTileFogDirection( const int32_t tileId, const uint16_t fogDirection )
+    {
+#ifdef WITH_DEBUG
+        _tileFogDirections.at( tileId ) = fogDirection;
+#else
+        _tileFogDirections[tileId] = fogDirection;
+#endif
+    }
+
     void InitKingdoms()
     {
         vec_kingdoms.Init();
@@ -501,6 +548,29 @@ public:
     std::list<Route::Step> getPath( const Heroes & hero, int targetIndex );
     void resetPathfinder();
 
+    // Records that the passability of the given tile (or the possibility of moving through it) may have changed, so
+    // pathfinders can update only the affected parts of their passability grids instead of rebuilding them.
+    void markTileChanged( const int32_t tileIndex );
+
+    // Returns the list of tiles changed since the last change of the epoch. Once the list becomes too long, it is
+    // cleared and the epoch is changed, which means that all tiles should be considered changed.
+    const std::vector<int32_t> & getChangedTiles() const
+    {
+        return _changedTiles;
+    }
+
+    uint32_t getTileChangesEpoch() const
+    {
+        return _tileChangesEpoch;
+    }
+
+    // Returns the revision of the world which is changed every time the pathfinders are reset or a new day begins, so the results
+    // of pathfinding obtained for an older revision are outdated.
+    uint32_t getRevision() const
+    {
+        return _revision;
+    }
+
     void ComputeStaticAnalysis();
 
     uint32_t GetMapSeed() const
@@ -546,6 +616,9 @@ private:
 
     bool setHeroIdsForMapConditions();
 
+    // Must be called every time the tiles are replaced or the number of tiles changes.
+    void _resetTileData();
+
     friend class Radar;
     friend OStreamBase & operator<<( OStreamBase & stream, const World & w );
     friend IStreamBase & operator>>( IStreamBase & stream, World & w );
@@ -582,6 +655,19 @@ private:
     std::map<uint8_t, Maps::Indexes> _allWhirlpools; // All indexes of tiles that contain a certain part (sprite index) of the whirlpool
     std::vector<int32_t> _allEyeOfMagi;
 
+    // Per-tile data kept in dense arrays outside of tiles because it is read for many tiles at once in hot loops (rendering, AI)
+    // and a tile is too big to be pulled into the cache just to read a couple of bytes. The hot data is owned by the tiles (see
+    // Maps::TileHotDataHolder), while regions and fog directions are computed by the world itself.
+    std::vector<Maps::TileHotData> _tileHotData;
+    std::vector<uint32_t> _tileRegions;
+    std::vector<uint16_t> _tileFogDirections;
+
+    // Log of changed tiles used for incremental updates of pathfinder passability grids
+    std::vector<int32_t> _changedTiles;
+    uint32_t _tileChangesEpoch{ 0 };
+
+    uint32_t _revision{ 0 };
+
     uint8_t _waterPercentage{ 0 };
     double _landRoughness{ 1.0 };
     std::vector<MapRegion> _regions;
@@ -239,6 +239,7 @@ bool World::LoadMapMP2( const std::string & filename, const bool isOriginalMp2Fi
     fs.seek( MP2::MP2_MAP_INFO_SIZE );
 
     vec_tiles.resize( worldSize );
+    _resetTileData();
 
     const bool checkPoLObjects = !Settings::Get().isPriceOfLoyaltySupported() && isOriginalMp2File;
 
@@ -734,6 +735,7 @@ bool World::loadResurrectionMap( const std::string & filename )
 
     assert( vec_tiles.empty() );
     vec_tiles.resize( static_cast<size_t>( width ) * height );
+    _resetTileData();
 
     if ( !Maps::readAllTiles( map ) ) {
         return false;
@@ -1791,6 +1793,7 @@ bool World::loadHoMM1Map( const std::vector<uint8_t> & data )
     }
 
     vec_tiles.resize( worldSize );
+    _resetTileData();
     for ( int32_t i = 0; i < worldSize; ++i ) {
         vec_tiles[i].setIndex( i );
     }
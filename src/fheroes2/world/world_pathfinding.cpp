@@ -22,9 +22,13 @@
 
 #include <algorithm>
 #include <array>
+#include <atomic>
 #include <cassert>
 #include <cmath>
 #include <cstdlib>
+#include <limits>
+#include <memory>
+#include <mutex>
 #include <set>
 #include <tuple>
 #include <utility>
@@ -54,6 +58,10 @@
 
 namespace
 {
+    std::atomic<uint64_t> pathfinderEvaluationCount{ 0 };
+    std::atomic<uint64_t> pathfinderNodeExpansionCount{ 0 };
+    std::atomic<WorldPathfinder::ExplorationAlgorithm> pathfinderExplorationAlgorithm{ WorldPathfinder::ExplorationAlgorithm::DIJKSTRA };
+
     bool isTileAvailableForWalkThrough( const int tileIndex, const bool fromWater )
     {
         const Maps::Tile & tile = world.getTile( tileIndex );
@@ -79,8 +87,9 @@ namespace
         const MP2::MapObjectType objectType = tile.getMainObjectType();
 
         const auto isTileAccessible = [color, armyStrength, minimalAdvantage, &tile]() {
-            // Creating an Army instance is a relatively heavy operation, so cache it to speed up calculations
-            static Army tileArmy;
+            // Creating an Army instance is a relatively heavy operation, so cache it to speed up calculations. Pathfinders can be
+            // run in parallel, so every thread has its own instance.
+            thread_local Army tileArmy;
             tileArmy.setFromTile( tile );
 
             const PlayerColor tileArmyColor = tileArmy.GetColor();
@@ -314,6 +323,84 @@ namespace
     }
 }
 
+void WorldPassabilityGrid::update()
+{
+    const size_t worldSize = world.getSize();
+    const uint32_t epoch = world.getTileChangesEpoch();
+    const std::vector<int32_t> & changedTiles = world.getChangedTiles();
+
+    if ( _nodes.size() != worldSize || _tileChangesEpoch != epoch || _appliedTileChanges > changedTiles.size() ) {
+        _nodes.resize( worldSize );
+
+        for ( size_t i = 0; i < worldSize; ++i ) {
+            updateNode( static_cast<int>( i ) );
+        }
+
+        _tileChangesEpoch = epoch;
+        _appliedTileChanges = changedTiles.size();
+
+        return;
+    }
+
+    for ( ; _appliedTileChanges < changedTiles.size(); ++_appliedTileChanges ) {
+        const int32_t tileIndex = changedTiles[_appliedTileChanges];
+
+        // The possibility of entering the changed tile affects the exits of all its neighbors
+        updateNode( tileIndex );
+
+        for ( const int32_t direction : Direction::allNeighboringDirections ) {
+            if ( Maps::isValidDirection( tileIndex, direction ) ) {
+                updateNode( Maps::GetDirectionIndex( tileIndex, direction ) );
+            }
+        }
+    }
+}
+
+void WorldPassabilityGrid::updateNode( const int index )
+{
+    const Maps::Tile & tile = world.getTile( index );
+    Node & node = _nodes[index];
+
+    node.exits = 0;
+
+    for ( const int32_t direction : Direction::allNeighboringDirections ) {
+        if ( Maps::isValidDirection( index, direction ) && isMovementAllowedForColor( index, direction, _color, false, false ) ) {
+            node.exits |= static_cast<uint8_t>( direction );
+        }
+    }
+
+    node.isWater = tile.isWater();
+    node.isRoad = tile.isRoad();
+
+    for ( uint8_t level = Skill::Level::NONE; level <= Skill::Level::EXPERT; ++level ) {
+        const uint32_t penalty = Maps::Ground::GetPenalty( tile, level );
+        assert( penalty <= std::numeric_limits<uint8_t>::max() );
+
+        node.groundPenalties[level] = static_cast<uint8_t>( penalty );
+    }
+}
+
+std::vector<int32_t> WorldPathfinderSnapshot::getPath( const int32_t targetIndex ) const
+{
+    std::vector<int32_t> path;
+
+    // Destination is not reachable
+    if ( getDistance( targetIndex ) == 0 ) {
+        return path;
+    }
+
+    for ( int32_t currentIndex = targetIndex; currentIndex != -1; currentIndex = _predecessors[currentIndex] ) {
+        path.push_back( currentIndex );
+    }
+
+    // The last added tile is the start tile
+    path.pop_back();
+
+    std::reverse( path.begin(), path.end() );
+
+    return path;
+}
+
 uint32_t WorldPathfinder::getDistance( int targetIndex ) const
 {
     assert( targetIndex >= 0 && static_cast<size_t>( targetIndex ) < _cache.size() );
@@ -321,12 +408,29 @@ uint32_t WorldPathfinder::getDistance( int targetIndex ) const
     return _cache[targetIndex]._cost;
 }
 
+std::shared_ptr<const WorldPathfinderSnapshot> WorldPathfinder::createSnapshot() const
+{
+    assert( _nodesToExplore.empty() && _lastProcessedReachedNode == _reachedNodes.size() );
+
+    std::vector<uint32_t> distances( _cache.size() );
+    std::vector<int32_t> predecessors( _cache.size() );
+
+    for ( size_t i = 0; i < _cache.size(); ++i ) {
+        distances[i] = _cache[i]._cost;
+        predecessors[i] = _cache[i]._from;
+    }
+
+    return std::make_shared<const WorldPathfinderSnapshot>( std::move( distances ), std::move( predecessors ) );
+}
+
 uint32_t WorldPathfinder::getMovementPenalty( const int from, const int to, const int direction ) const
 {
-    const Maps::Tile & fromTile = world.getTile( from );
-    const Maps::Tile & toTile = world.getTile( to );
+    assert( _passabilityGrid != nullptr );
+
+    const WorldPassabilityGrid & grid = *_passabilityGrid;
+    const bool isFromRoad = grid.isRoad( from );
 
-    uint32_t penalty = fromTile.isRoad() && toTile.isRoad() ? Maps::Ground::roadPenalty : Maps::Ground::GetPenalty( fromTile, _pathfindingSkill );
+    uint32_t penalty = isFromRoad && grid.isRoad( to ) ? Maps::Ground::roadPenalty : grid.getGroundPenalty( from, _pathfindingSkill );
 
     // Diagonal movement costs 50% more
     if ( Direction::isDiagonal( direction ) ) {
@@ -337,14 +441,14 @@ uint32_t WorldPathfinder::getMovementPenalty( const int from, const int to, cons
     // logic: if this move is the last one on the current turn, then we can move to any adjacent
     // tile (both in straight and diagonal direction) as long as we have enough movement points
     // to move over our current tile in the straight direction
-    if ( getMaxMovePoints( fromTile.isWater() ) > 0 ) {
+    if ( getMaxMovePoints( grid.isWater( from ) ) > 0 ) {
         const WorldNode & node = _cache[from];
 
         // No dead ends allowed
         assert( from == _pathStart || node._from != -1 );
 
         const uint32_t remainingMovePoints = node._remainingMovePoints;
-        const uint32_t fromTilePenalty = fromTile.isRoad() ? Maps::Ground::roadPenalty : Maps::Ground::GetPenalty( fromTile, _pathfindingSkill );
+        const uint32_t fromTilePenalty = isFromRoad ? Maps::Ground::roadPenalty : grid.getGroundPenalty( from, _pathfindingSkill );
 
         // If we still have enough movement points to move over the source tile in the straight
         // direction, but not enough to move to the destination tile, then the "last move" logic
@@ -378,31 +482,112 @@ void WorldPathfinder::reset()
     _color = PlayerColor::NONE;
     _remainingMovePoints = 0;
     _pathfindingSkill = Skill::Level::EXPERT;
+
+    _nodesToExplore.clear();
+    _reachedNodes.clear();
+    _lastProcessedReachedNode = 0;
+}
+
+uint64_t WorldPathfinder::getEvaluationCount()
+{
+    return pathfinderEvaluationCount;
+}
+
+uint64_t WorldPathfinder::getNodeExpansionCount()
+{
+    return pathfinderNodeExpansionCount;
 }
 
-void WorldPathfinder::processWorldMap()
+void WorldPathfinder::setExplorationAlgorithm( const ExplorationAlgorithm algorithm )
+{
+    pathfinderExplorationAlgorithm = algorithm;
+}
+
+void WorldPathfinder::updatePassabilityGrid()
+{
+    WorldPassabilityGrid & grid = _passabilityGrids.try_emplace( _color, _color ).first->second;
+    grid.update();
+
+    _passabilityGrid = &grid;
+}
+
+void WorldPathfinder::addNodeToExplore( const int nodeIdx )
+{
+    if ( pathfinderExplorationAlgorithm == ExplorationAlgorithm::LABEL_CORRECTING ) {
+        _reachedNodes.push_back( nodeIdx );
+        return;
+    }
+
+    _nodesToExplore.push( _cache[nodeIdx]._cost, nodeIdx );
+}
+
+void WorldPathfinder::startExploration()
 {
     assert( _cache.size() == world.getSize() && Maps::isValidAbsIndex( _pathStart ) );
 
+    ++pathfinderEvaluationCount;
+
+    updatePassabilityGrid();
+
     for ( WorldNode & node : _cache ) {
         node = {};
     }
 
+    _nodesToExplore.clear();
+    _reachedNodes.clear();
+    _lastProcessedReachedNode = 0;
+
     _cache[_pathStart].update( -1, 0, _remainingMovePoints );
 
-    std::vector<int> nodesToExplore;
-    nodesToExplore.push_back( _pathStart );
+    addNodeToExplore( _pathStart );
+}
 
-    for ( size_t lastProcessedNode = 0; lastProcessedNode < nodesToExplore.size(); ++lastProcessedNode ) {
-        processCurrentNode( nodesToExplore, nodesToExplore[lastProcessedNode] );
+void WorldPathfinder::exploreUntil( const int targetIndex )
+{
+    assert( targetIndex == -1 || ( targetIndex >= 0 && static_cast<size_t>( targetIndex ) < _cache.size() ) );
+
+    if ( pathfinderExplorationAlgorithm == ExplorationAlgorithm::LABEL_CORRECTING ) {
+        for ( ; _lastProcessedReachedNode < _reachedNodes.size(); ++_lastProcessedReachedNode ) {
+            ++pathfinderNodeExpansionCount;
+
+            processCurrentNode( _reachedNodes[_lastProcessedReachedNode] );
+        }
+
+        return;
+    }
+
+    while ( !_nodesToExplore.empty() ) {
+        if ( targetIndex != -1 ) {
+            const WorldNode & targetNode = _cache[targetIndex];
+
+            // The target tile has been reached and its cost cannot be improved anymore since all remaining tiles are more expensive.
+            // It is important to check that the target tile itself is not waiting to be processed because it can be found to be
+            // inaccessible during processing.
+            if ( ( targetIndex == _pathStart || targetNode._from != -1 ) && _nodesToExplore.topKey() > targetNode._cost ) {
+                return;
+            }
+        }
+
+        const auto [cost, nodeIdx] = _nodesToExplore.pop();
+        const WorldNode & node = _cache[nodeIdx];
+
+        // Skip outdated entries: either a cheaper path to this tile has been found (and the tile has been processed already) or
+        // the tile has been found to be inaccessible.
+        if ( node._cost != cost || ( node._from == -1 && nodeIdx != _pathStart ) ) {
+            continue;
+        }
+
+        ++pathfinderNodeExpansionCount;
+
+        processCurrentNode( nodeIdx );
     }
 }
 
-void WorldPathfinder::checkAdjacentNodes( std::vector<int> & nodesToExplore, const int currentNodeIdx )
+void WorldPathfinder::checkAdjacentNodes( const int currentNodeIdx )
 {
     const auto & directions = Direction::allNeighboringDirections;
     const WorldNode & currentNode = _cache[currentNodeIdx];
-    const uint32_t maxMovePoints = getMaxMovePoints( world.getTile( currentNodeIdx ).isWater() );
+    const uint32_t maxMovePoints = getMaxMovePoints( _passabilityGrid->isWater( currentNodeIdx ) );
 
     for ( size_t i = 0; i < directions.size(); ++i ) {
         if ( !Maps::isValidDirection( currentNodeIdx, directions[i] ) || !isMovementAllowed( currentNodeIdx, directions[i] ) ) {
@@ -422,14 +607,16 @@ void WorldPathfinder::checkAdjacentNodes( std::vector<int> & nodesToExplore, con
         if ( newNode._from == -1 || newNode._cost > movementCost ) {
             newNode.update( currentNodeIdx, movementCost, subtractMovePoints( currentNode._remainingMovePoints, movementPenalty, maxMovePoints ) );
 
-            nodesToExplore.push_back( newIndex );
+            addNodeToExplore( newIndex );
         }
     }
 }
 
 bool WorldPathfinder::isMovementAllowed( const int from, const int direction ) const
 {
-    return isMovementAllowedForColor( from, direction, _color, false, false );
+    assert( _passabilityGrid != nullptr );
+
+    return _passabilityGrid->isMovementAllowed( from, direction );
 }
 
 void PlayerWorldPathfinder::reset()
@@ -448,14 +635,23 @@ void PlayerWorldPathfinder::reEvaluateIfNeeded( const Heroes & hero )
     if ( currentSettings != newSettings ) {
         currentSettings = newSettings;
 
-        processWorldMap();
+        startExploration();
     }
 }
 
-std::list<Route::Step> PlayerWorldPathfinder::buildPath( const int targetIndex ) const
+uint32_t PlayerWorldPathfinder::getDistance( const int targetIndex )
+{
+    exploreUntil( targetIndex );
+
+    return WorldPathfinder::getDistance( targetIndex );
+}
+
+std::list<Route::Step> PlayerWorldPathfinder::buildPath( const int targetIndex )
 {
     assert( _cache.size() == world.getSize() && Maps::isValidAbsIndex( _pathStart ) && Maps::isValidAbsIndex( targetIndex ) );
 
+    exploreUntil( targetIndex );
+
     std::list<Route::Step> path;
 
     // Destination is not reachable
@@ -489,7 +685,7 @@ std::list<Route::Step> PlayerWorldPathfinder::buildPath( const int targetIndex )
     return path;
 }
 
-void PlayerWorldPathfinder::processCurrentNode( std::vector<int> & nodesToExplore, const int currentNodeIdx )
+void PlayerWorldPathfinder::processCurrentNode( const int currentNodeIdx )
 {
     const bool isFirstNode = ( currentNodeIdx == _pathStart );
     const WorldNode & currentNode = _cache[currentNodeIdx];
@@ -523,7 +719,7 @@ void PlayerWorldPathfinder::processCurrentNode( std::vector<int> & nodesToExplor
         }
     }
     else {
-        checkAdjacentNodes( nodesToExplore, currentNodeIdx );
+        checkAdjacentNodes( currentNodeIdx );
     }
 }
 
@@ -633,11 +829,22 @@ void AIWorldPathfinder::reEvaluateIfNeeded( const Heroes & hero )
     if ( currentSettings != newSettings ) {
         currentSettings = newSettings;
 
-        processWorldMap();
+        startExploration();
     }
+
+    // The previous exploration might have been stopped early by a bounded search
+    exploreUntil( -1 );
 }
 
 void AIWorldPathfinder::reEvaluateIfNeeded( const int start, const PlayerColor color, const double armyStrength, const uint8_t skill )
+{
+    startExplorationIfNeeded( start, color, armyStrength, skill );
+
+    // The previous exploration might have been stopped early by a bounded search
+    exploreUntil( -1 );
+}
+
+void AIWorldPathfinder::startExplorationIfNeeded( const int start, const PlayerColor color, const double armyStrength, const uint8_t skill )
 {
     auto currentSettings
         = std::tie( _pathStart, _color, _remainingMovePoints, _pathfindingSkill, _patrolCenter, _patrolDistance, _maxMovePointsOnLand, _maxMovePointsOnWater,
@@ -649,7 +856,7 @@ void AIWorldPathfinder::reEvaluateIfNeeded( const int start, const PlayerColor c
     if ( currentSettings != newSettings ) {
         currentSettings = newSettings;
 
-        processWorldMap();
+        startExploration();
     }
 }
 
@@ -675,20 +882,11 @@ bool AIWorldPathfinder::isTileAvailableForWalkThroughForAI( const int tileIndex,
     return *isAvailableForWalkThrough;
 }
 
-void AIWorldPathfinder::processWorldMap()
+void AIWorldPathfinder::startExploration()
 {
-    assert( _cache.size() == world.getSize() && Maps::isValidAbsIndex( _pathStart ) );
+    WorldPathfinder::startExploration();
 
-    for ( WorldNode & node : _cache ) {
-        node = {};
-    }
-
-    _cache[_pathStart].update( -1, 0, _remainingMovePoints );
-
-    std::vector<int> nodesToExplore;
-    nodesToExplore.push_back( _pathStart );
-
-    const auto processTownPortal = [this, &nodesToExplore]( const Spell & spell, const int32_t castleIndex ) {
+    const auto processTownPortal = [this]( const Spell & spell, const int32_t castleIndex ) {
         assert( castleIndex >= 0 && static_cast<size_t>( castleIndex ) < _cache.size() );
         assert( castleIndex != _pathStart && _cache[castleIndex]._from == -1 );
 
@@ -697,7 +895,7 @@ void AIWorldPathfinder::processWorldMap()
 
         _cache[castleIndex].update( _pathStart, cost, remaining );
 
-        nodesToExplore.push_back( castleIndex );
+        addNodeToExplore( castleIndex );
     };
 
     if ( _townGateCastleIndex != -1 ) {
@@ -711,18 +909,19 @@ void AIWorldPathfinder::processWorldMap()
 
         processTownPortal( Spell::TOWNPORTAL, idx );
     }
-
-    for ( size_t lastProcessedNode = 0; lastProcessedNode < nodesToExplore.size(); ++lastProcessedNode ) {
-        processCurrentNode( nodesToExplore, nodesToExplore[lastProcessedNode] );
-    }
 }
 
 bool AIWorldPathfinder::isMovementAllowed( const int from, const int direction ) const
 {
-    return isMovementAllowedForColor( from, direction, _color, false, _isSummonBoatSpellAvailable );
+    if ( WorldPathfinder::isMovementAllowed( from, direction ) ) {
+        return true;
+    }
+
+    // The Summon Boat spell depends on the hero, so this case is not covered by the passability grid
+    return _isSummonBoatSpellAvailable && isMovementAllowedForColor( from, direction, _color, false, true );
 }
 
-void AIWorldPathfinder::processCurrentNode( std::vector<int> & nodesToExplore, const int currentNodeIdx )
+void AIWorldPathfinder::processCurrentNode( const int currentNodeIdx )
 {
     const bool isFirstNode = ( currentNodeIdx == _pathStart );
     WorldNode & currentNode = _cache[currentNodeIdx];
@@ -784,7 +983,7 @@ void AIWorldPathfinder::processCurrentNode( std::vector<int> & nodesToExplore, c
             if ( teleportNode._from == -1 || teleportNode._cost > currentNode._cost ) {
                 teleportNode.update( currentNodeIdx, currentNode._cost, currentNode._remainingMovePoints );
 
-                nodesToExplore.push_back( teleportIdx );
+                addNodeToExplore( teleportIdx );
             }
         }
 
@@ -795,7 +994,7 @@ void AIWorldPathfinder::processCurrentNode( std::vector<int> & nodesToExplore, c
         }
     }
 
-    checkAdjacentNodes( nodesToExplore, currentNodeIdx );
+    checkAdjacentNodes( currentNodeIdx );
 }
 
 uint32_t AIWorldPathfinder::getMaxMovePoints( const bool onWater ) const
@@ -843,7 +1042,8 @@ uint32_t AIWorldPathfinder::getMovementPenalty( const int from, const int to, co
         return regularPenalty + WorldPathfinder::getMovementPenalty( node._from, from, prevStepDirection );
     }();
 
-    const uint32_t maxMovePoints = getMaxMovePoints( fromTile.isWater() );
+    const bool fromWater = _passabilityGrid->isWater( from );
+    const uint32_t maxMovePoints = getMaxMovePoints( fromWater );
     assert( maxMovePoints == 0 || defaultPenalty <= maxMovePoints );
 
     // If we perform pathfinding for a real AI-controlled hero on the map, we should correctly calculate
@@ -857,8 +1057,8 @@ uint32_t AIWorldPathfinder::getMovementPenalty( const int from, const int to, co
         const Maps::Tile & toTile = world.getTile( to );
 
         // AI-controlled hero may get from the shore to a suitable water tile using the Summon Boat spell
-        const bool isComesOnBoard = ( !fromTile.isWater() && ( toTile.getMainObjectType() == MP2::OBJ_BOAT || toTile.isSuitableForSummoningBoat() ) );
-        const bool isDisembarks = ( fromTile.isWater() && toTile.isSuitableForDisembarkation() );
+        const bool isComesOnBoard = ( !fromWater && ( toTile.getMainObjectType() == MP2::OBJ_BOAT || toTile.isSuitableForSummoningBoat() ) );
+        const bool isDisembarks = ( fromWater && toTile.isSuitableForDisembarkation() );
 
         // When the hero gets into a boat or disembarks, he spends all remaining movement points.
         if ( isComesOnBoard || isDisembarks ) {
@@ -1382,10 +1582,11 @@ std::list<Route::Step> AIWorldPathfinder::buildPath( const int targetIndex, cons
 uint32_t AIWorldPathfinder::getDistance( const int start, const int targetIndex, const PlayerColor color, const double armyStrength,
                                          const uint8_t skill /* = Skill::Level::EXPERT */ )
 {
-    reEvaluateIfNeeded( start, color, armyStrength, skill );
-
     assert( targetIndex >= 0 && static_cast<size_t>( targetIndex ) < _cache.size() );
 
+    startExplorationIfNeeded( start, color, armyStrength, skill );
+    exploreUntil( targetIndex );
+
     return _cache[targetIndex]._cost;
 }
 
@@ -1420,3 +1621,69 @@ void AIWorldPathfinder::setSpellPointsReserveRatio( const double ratio )
 
     reset();
 }
+
+bool AIWorldPathfinderSnapshotCache::Key::operator==( const Key & other ) const
+{
+    return std::tie( worldRevision, start, color, armyStrength, skill, minimalArmyStrengthAdvantage )
+           == std::tie( other.worldRevision, other.start, other.color, other.armyStrength, other.skill, other.minimalArmyStrengthAdvantage );
+}
+
+std::shared_ptr<const WorldPathfinderSnapshot> AIWorldPathfinderSnapshotCache::get( const int32_t start, const PlayerColor color, const double armyStrength,
+                                                                                    const uint8_t skill, const double minimalArmyStrengthAdvantage )
+{
+    const Key key{ world.getRevision(), start, color, armyStrength, skill, minimalArmyStrengthAdvantage };
+
+    const auto findEntry = [this, &key]() -> std::shared_ptr<const WorldPathfinderSnapshot> {
+        const auto iter = std::find_if( _entries.begin(), _entries.end(), [&key]( const auto & entry ) { return entry.first == key; } );
+        if ( iter == _entries.end() ) {
+            return {};
+        }
+
+        _entries.splice( _entries.begin(), _entries, iter );
+
+        return iter->second;
+    };
+
+    {
+        const std::scoped_lock<std::mutex> lock( _mutex );
+
+        if ( std::shared_ptr<const WorldPathfinderSnapshot> snapshot = findEntry(); snapshot ) {
+            return snapshot;
+        }
+    }
+
+    // Every thread has its own pathfinder instance to be able to evaluate the map in parallel. The instance is reset every time
+    // because the world might have changed since the last evaluation.
+    thread_local AIWorldPathfinder pathfinder;
+
+    pathfinder.reset();
+    pathfinder.setMinimalArmyStrengthAdvantage( minimalArmyStrengthAdvantage );
+    pathfinder.reEvaluateIfNeeded( start, color, armyStrength, skill );
+
+    std::shared_ptr<const WorldPathfinderSnapshot> snapshot = pathfinder.createSnapshot();
+
+    const std::scoped_lock<std::mutex> lock( _mutex );
+
+    // Another thread might have evaluated the map for the same army in the meantime
+    if ( std::shared_ptr<const WorldPathfinderSnapshot> existingSnapshot = findEntry(); existingSnapshot ) {
+        return existingSnapshot;
+    }
+
+    _entries.emplace_front( key, snapshot );
+
+    // Snapshots made for older world revisions are never used again
+    _entries.remove_if( [revision = key.worldRevision]( const auto & entry ) { return entry.first.worldRevision != revision; } );
+
+    if ( _entries.size() > _capacity ) {
+        _entries.pop_back();
+    }
+
+    return snapshot;
+}
+
+void AIWorldPathfinderSnapshotCache::clear()
+{
+    const std::scoped_lock<std::mutex> lock( _mutex );
+
+    _entries.clear();
+}
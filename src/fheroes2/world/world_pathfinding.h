@@ -20,13 +20,19 @@
 
 #pragma once
 
+#include <array>
+#include <cassert>
 #include <cstdint>
 #include <list>
+#include <map>
+#include <memory>
+#include <mutex>
 #include <optional>
 #include <utility>
 #include <vector>
 
 #include "color.h"
+#include "radix_heap.h"
 #include "skill.h"
 
 class Heroes;
@@ -71,6 +77,107 @@ struct WorldNode final
     }
 };
 
+// Packed per-tile passability information for a particular player color. The grid is built from the world tiles and then updated
+// incrementally using the world's log of changed tiles, so that pathfinders do not have to query tiles for every edge relaxation.
+class WorldPassabilityGrid final
+{
+public:
+    explicit WorldPassabilityGrid( const PlayerColor color )
+        : _color( color )
+    {
+        // Do nothing.
+    }
+
+    // Brings the grid in line with the current state of the world
+    void update();
+
+    // Returns true if moving from the given tile to the adjacent tile in the given direction is allowed by the regular passability rules
+    bool isMovementAllowed( const int from, const int direction ) const
+    {
+        assert( from >= 0 && static_cast<size_t>( from ) < _nodes.size() );
+
+        return ( _nodes[from].exits & direction ) != 0;
+    }
+
+    bool isWater( const int index ) const
+    {
+        assert( index >= 0 && static_cast<size_t>( index ) < _nodes.size() );
+
+        return _nodes[index].isWater;
+    }
+
+    bool isRoad( const int index ) const
+    {
+        assert( index >= 0 && static_cast<size_t>( index ) < _nodes.size() );
+
+        return _nodes[index].isRoad;
+    }
+
+    // Returns the base ground penalty of the given tile (roads are not taken into account)
+    uint32_t getGroundPenalty( const int index, const uint8_t pathfindingSkill ) const
+    {
+        assert( index >= 0 && static_cast<size_t>( index ) < _nodes.size() && pathfindingSkill < _nodes[index].groundPenalties.size() );
+
+        return _nodes[index].groundPenalties[pathfindingSkill];
+    }
+
+private:
+    struct Node
+    {
+        // Directions in which movement from this tile is allowed
+        uint8_t exits{ 0 };
+        bool isWater{ false };
+        bool isRoad{ false };
+        // Ground penalties for every level of the Pathfinding skill
+        std::array<uint8_t, 4> groundPenalties{};
+    };
+
+    void updateNode( const int index );
+
+    std::vector<Node> _nodes;
+
+    PlayerColor _color{ PlayerColor::NONE };
+    uint32_t _tileChangesEpoch{ 0 };
+    size_t _appliedTileChanges{ 0 };
+};
+
+// Immutable result of a map evaluation: the costs of the paths to all tiles and the tiles from which they are entered. Since it
+// cannot be changed, it can be shared between threads.
+class WorldPathfinderSnapshot final
+{
+public:
+    WorldPathfinderSnapshot( std::vector<uint32_t> distances, std::vector<int32_t> predecessors )
+        : _distances( std::move( distances ) )
+        , _predecessors( std::move( predecessors ) )
+    {
+        assert( _distances.size() == _predecessors.size() );
+    }
+
+    // Returns the cost of the path to the given tile (0 if the tile is not reachable)
+    uint32_t getDistance( const int32_t index ) const
+    {
+        assert( index >= 0 && static_cast<size_t>( index ) < _distances.size() );
+
+        return _distances[index];
+    }
+
+    // Returns the tile from which the given tile is entered (-1 for the start tile and for tiles which are not reachable)
+    int32_t getPredecessor( const int32_t index ) const
+    {
+        assert( index >= 0 && static_cast<size_t>( index ) < _predecessors.size() );
+
+        return _predecessors[index];
+    }
+
+    // Returns the indexes of the tiles of the path to the given tile starting from the first step (the start tile is not included).
+    // If the tile is not reachable, then an empty path is returned.
+    std::vector<int32_t> getPath( const int32_t targetIndex ) const;
+
+private:
+    std::vector<uint32_t> _distances;
+    std::vector<int32_t> _predecessors;
+};
+
 // Abstract class that provides basic functionality for navigating the World Map
 class WorldPathfinder
 {
@@ -82,21 +189,56 @@ public:
 
     WorldPathfinder & operator=( const WorldPathfinder & ) = delete;
 
+    // Algorithms used to explore the map. The label-correcting algorithm is the original one: it processes tiles in the order
+    // they were reached and processes a tile again every time a cheaper path to it is found. It is kept only to compare
+    // the algorithms in the pathfinder benchmark.
+    enum class ExplorationAlgorithm : uint8_t
+    {
+        DIJKSTRA,
+        LABEL_CORRECTING
+    };
+
     virtual void reset();
 
     uint32_t getDistance( int targetIndex ) const;
 
+    // Returns the total number of map evaluations performed by all pathfinder instances since the start of the application.
+    // Used for profiling purposes only.
+    static uint64_t getEvaluationCount();
+
+    // Returns the total number of tiles processed by all pathfinder instances since the start of the application. Used for
+    // profiling purposes only.
+    static uint64_t getNodeExpansionCount();
+
+    // Sets the algorithm used by all pathfinder instances. Used for profiling purposes only.
+    static void setExplorationAlgorithm( const ExplorationAlgorithm algorithm );
+
+    // Returns a copy of the results of the last map evaluation. The map should be fully explored.
+    std::shared_ptr<const WorldPathfinderSnapshot> createSnapshot() const;
+
 protected:
-    void checkAdjacentNodes( std::vector<int> & nodesToExplore, const int currentNodeIdx );
+    void checkAdjacentNodes( const int currentNodeIdx );
+
+    // Adds the tile to the list of tiles to explore using its current cost
+    void addNodeToExplore( const int nodeIdx );
 
-    virtual void processWorldMap();
+    // Resets the cache and starts a new exploration of the map from the start tile. Derived classes can add more starting tiles.
+    virtual void startExploration();
+
+    // Continues the exploration until the cost of the target tile is final. The whole map is explored if the target tile is -1.
+    // Tiles are processed in the order of their costs, so every tile is processed only once and the exploration can be stopped
+    // as soon as there are no tiles left which are cheaper than the target tile.
+    void exploreUntil( const int targetIndex );
+
+    // Selects the passability grid for the current color and brings it up to date. Should be called before evaluating the map.
+    void updatePassabilityGrid();
 
     // Checks whether moving from the source tile in the specified direction is allowed. The default implementation
     // can be overridden by a derived class.
     virtual bool isMovementAllowed( const int from, const int direction ) const;
 
     // Defines the pathfinding rules and should be implemented by a derived class.
-    virtual void processCurrentNode( std::vector<int> & nodesToExplore, const int currentNodeIdx ) = 0;
+    virtual void processCurrentNode( const int currentNodeIdx ) = 0;
 
     // Returns the maximum number of movement points, depending on whether the movement is performed by land or by
     // water. Should be implemented by a derived class.
@@ -112,6 +254,14 @@ protected:
     std::vector<WorldNode> _cache;
     std::vector<int> _mapOffset;
 
+    // Tiles to explore ordered by their costs at the moment they were added. A tile is added again every time a cheaper path to it
+    // is found, so outdated entries are skipped when they are extracted.
+    fheroes2::RadixHeap<int32_t> _nodesToExplore;
+
+    // Tiles to explore in the order they were reached, used only by the label-correcting algorithm
+    std::vector<int32_t> _reachedNodes;
+    size_t _lastProcessedReachedNode{ 0 };
+
     // The hero properties used by the pathfinder are cached here not just for optimization, but also because some
     // of them may change even if the position of the hero does not change, so it should be possible to compare the
     // old values with the new ones to determine whether the pathfinder cache needs to be recalculated.
@@ -119,6 +269,11 @@ protected:
     PlayerColor _color{ PlayerColor::NONE };
     uint32_t _remainingMovePoints{ 0 };
     uint8_t _pathfindingSkill{ Skill::Level::EXPERT };
+
+    // Passability grids are kept for every color this pathfinder has been used for, since the same instance can be used
+    // to evaluate armies of different colors in turn. They are not cleared on reset because they track world changes themselves.
+    std::map<PlayerColor, WorldPassabilityGrid> _passabilityGrids;
+    const WorldPassabilityGrid * _passabilityGrid{ nullptr };
 };
 
 class PlayerWorldPathfinder final : public WorldPathfinder
@@ -133,15 +288,20 @@ public:
 
     void reset() override;
 
+    // Starts a new exploration of the map if the hero properties have changed. The map is explored lazily: only as far as needed
+    // to answer the queries below.
     void reEvaluateIfNeeded( const Heroes & hero );
 
+    // Returns the cost of the path to the tile with the index 'targetIndex' (0 if the tile is not reachable).
+    uint32_t getDistance( const int targetIndex );
+
     // Builds and returns a path to the tile with the index 'targetIndex'. If the destination tile is not reachable,
     // then an empty path is returned.
-    std::list<Route::Step> buildPath( const int targetIndex ) const;
+    std::list<Route::Step> buildPath( const int targetIndex );
 
 private:
     // Follows regular passability rules (for the human player)
-    void processCurrentNode( std::vector<int> & nodesToExplore, const int currentNodeIdx ) override;
+    void processCurrentNode( const int currentNodeIdx ) override;
 
     // Returns the maximum number of movement points. This class is not intended for planning paths passing both on
     // land and on water at the same time, so the maximum number of movement points corresponding to the type of
@@ -193,7 +353,8 @@ public:
     // If the destination tile is not reachable in principle, then an empty path is returned.
     std::list<Route::Step> buildPath( const int targetIndex, const bool accountNearestObject ) const;
 
-    // Used for non-hero armies, like castles or monsters
+    // Used for non-hero armies, like castles or monsters. Only the part of the map needed to find the path to the target tile is
+    // explored, the exploration is continued by the subsequent calls with the same army properties.
     uint32_t getDistance( const int start, const int targetIndex, const PlayerColor color, const double armyStrength, const uint8_t skill = Skill::Level::EXPERT );
     // Faster, but does not re-evaluate the map (exposed method of the base class)
     using WorldPathfinder::getDistance;
@@ -224,13 +385,17 @@ private:
     bool isTileAccessibleForAI( const int tileIndex );
     bool isTileAvailableForWalkThroughForAI( const int tileIndex, const bool fromWater );
 
-    void processWorldMap() override;
+    // Starts a new exploration of the map if the properties of the non-hero army have changed
+    void startExplorationIfNeeded( const int start, const PlayerColor color, const double armyStrength, const uint8_t skill );
+
+    // Adds the destinations of the Town Gate and Town Portal spells as starting tiles
+    void startExploration() override;
 
     // Adds special logic for AI-controlled heroes to use Summon Boat spell to overcome water obstacles (if available)
     bool isMovementAllowed( const int from, const int direction ) const override;
 
     // Follows custom passability rules (for the AI)
-    void processCurrentNode( std::vector<int> & nodesToExplore, const int currentNodeIdx ) override;
+    void processCurrentNode( const int currentNodeIdx ) override;
 
     // Returns the maximum number of movement points, depending on whether the movement is performed by land or by
     // water
@@ -275,3 +440,48 @@ private:
     // (such as Dimension Door, Town Gate or Town Portal)
     double _spellPointsReserveRatio{ 0.5 };
 };
+
+// Cache of the AI pathfinder evaluations for non-hero armies (like castles or monsters) which can be used by several threads at once.
+// Each evaluation is identified by the army properties and the revision of the world it was made for, so the results are never used
+// after the world has changed. The least recently used evaluations are removed when the cache is full.
+class AIWorldPathfinderSnapshotCache final
+{
+public:
+    explicit AIWorldPathfinderSnapshotCache( const size_t capacity )
+        : _capacity( capacity )
+    {
+        assert( _capacity > 0 );
+    }
+
+    AIWorldPathfinderSnapshotCache( const AIWorldPathfinderSnapshotCache & ) = delete;
+
+    ~AIWorldPathfinderSnapshotCache() = default;
+
+    AIWorldPathfinderSnapshotCache & operator=( const AIWorldPathfinderSnapshotCache & ) = delete;
+
+    // Returns the evaluation of the map for the army with the given properties, evaluating the map if needed. The map is evaluated
+    // without holding the lock, so several threads can evaluate the map for different armies at the same time.
+    std::shared_ptr<const WorldPathfinderSnapshot> get( const int32_t start, const PlayerColor color, const double armyStrength, const uint8_t skill,
+                                                        const double minimalArmyStrengthAdvantage );
+
+    void clear();
+
+private:
+    struct Key
+    {
+        uint32_t worldRevision{ 0 };
+        int32_t start{ -1 };
+        PlayerColor color{ PlayerColor::NONE };
+        double armyStrength{ 0 };
+        uint8_t skill{ Skill::Level::EXPERT };
+        double minimalArmyStrengthAdvantage{ 1.0 };
+
+        bool operator==( const Key & other ) const;
+    };
+
+    // The most recently used entries go first
+    std::list<std::pair<Key, std::shared_ptr<const WorldPathfinderSnapshot>>> _entries;
+    const size_t _capacity{ 0 };
+
+    std::mutex _mutex;
+};
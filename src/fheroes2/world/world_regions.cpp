@@ -183,7 +183,7 @@ void World::ComputeStaticAnalysis()
     const uint32_t emptyLineFrequency = 7;
 
     // Reset the region information for all tiles
-    std::for_each( vec_tiles.begin(), vec_tiles.end(), []( Maps::Tile & tile ) { tile.UpdateRegion( REGION_NODE_BLOCKED ); } );
+    _tileRegions.assign( vec_tiles.size(), REGION_NODE_BLOCKED );
 
     // Step 1. Split map into terrain, water and ground points
     // Initialize the obstacles vector
@@ -211,23 +211,23 @@ void World::ComputeStaticAnalysis()
         const int rowIndex = y * width;
         for ( int x = 0; x < width; ++x ) {
             const int index = rowIndex + x;
-            const Maps::Tile & tile = vec_tiles[index];
+            const Maps::TileHotData & tileData = _tileHotData[index];
             // If tile is blocked (mountain, trees, etc) then it's applied to both
-            if ( tile.GetPassable() == 0 ) {
+            if ( tileData.passabilityDirections == 0 ) {
                 ++obstacleCount;
                 ++obstacles[0][x].second;
                 ++obstacles[1][y].second;
                 ++obstacles[2][x].second;
                 ++obstacles[3][y].second;
             }
-            else if ( tile.isWater() ) {
+            else if ( tileData.isWater() ) {
                 ++waterCount;
                 // if it's water then ground tiles consider it an obstacle
                 ++obstacles[2][x].second;
                 ++obstacles[3][y].second;
             }
             else {
-                terrainPenalty += Maps::Ground::GetPenalty( tile, 0 );
+                terrainPenalty += Maps::Ground::GetPenalty( vec_tiles[index], 0 );
                 // else then ground is an obstacle for water navigation
                 ++obstacles[0][x].second;
                 ++obstacles[1][y].second;
@@ -385,7 +385,7 @@ void World::ComputeStaticAnalysis()
 
             for ( const int exitIndex : exits ) {
                 // neighbours is a set that will force the uniqueness
-                reg._neighbours.insert( vec_tiles[exitIndex].GetRegion() );
+                reg._neighbours.insert( _tileRegions[exitIndex] );
             }
         }
 
@@ -0,0 +1,445 @@
+/***************************************************************************
+ *   fheroes2: https://github.com/ihhub/fheroes2                           *
+ *   Copyright (C) 2025                                                    *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
+ ***************************************************************************/
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "image.h"
+#include "image_row.h"
+#include "math_base.h"
+#include "system.h"
+#include "timing.h"
+
+namespace
+{
+    constexpr double defaultMinimumDurationS = 0.2;
+
+    constexpr uint32_t defaultVerificationIterations = 10000;
+
+    // The transform value of the shadow used by original game resources.
+    constexpr uint8_t shadowTransformId = 3;
+
+    struct BenchmarkResult
+    {
+        uint64_t calls{ 0 };
+        double seconds{ 0 };
+    };
+
+    // Generates a sprite resembling a typical game sprite: an opaque ellipse-like body with a shadow surrounded by transparent pixels.
+    fheroes2::Sprite generateSprite( const int32_t width, const int32_t height, std::mt19937 & generator )
+    {
+        fheroes2::Sprite sprite( width, height );
+        sprite.reset();
+
+        std::uniform_int_distribution<uint32_t> colorDistribution( 10, 245 );
+
+        const int32_t centerX = width / 2;
+        const int32_t centerY = height / 2;
+        const int64_t radiusX = std::max( width / 2 - 1, 1 );
+        const int64_t radiusY = std::max( height / 2 - 1, 1 );
+
+        uint8_t * image = sprite.image();
+        uint8_t * transform = sprite.transform();
+
+        for ( int32_t y = 0; y < height; ++y ) {
+            for ( int32_t x = 0; x < width; ++x, ++image, ++transform ) {
+                const int64_t dx = x - centerX;
+                const int64_t dy = y - centerY;
+                const int64_t distance = dx * dx * radiusY * radiusY + dy * dy * radiusX * radiusX;
+                const int64_t limit = radiusX * radiusX * radiusY * radiusY;
+
+                if ( distance <= limit * 3 / 4 ) {
+                    *image = static_cast<uint8_t>( colorDistribution( generator ) );
+                    *transform = 0;
+                }
+                else if ( distance <= limit && dx < 0 && dy > 0 ) {
+                    *transform = shadowTransformId;
+                }
+            }
+        }
+
+        return sprite;
+    }
+
+    // Generates a single-layer image of the given size filled with random colors, the same as the game display.
+    fheroes2::Image generateScreen( const int32_t width, const int32_t height, std::mt19937 & generator )
+    {
+        fheroes2::Image screen;
+        screen._disableTransformLayer();
+        screen.resize( width, height );
+
+        std::uniform_int_distribution<uint32_t> colorDistribution( 10, 245 );
+
+        uint8_t * image = screen.image();
+        const uint8_t * imageEnd = image + static_cast<size_t>( width ) * height;
+        for ( ; image != imageEnd; ++image ) {
+            *image = static_cast<uint8_t>( colorDistribution( generator ) );
+        }
+
+        return screen;
+    }
+
+    // Generates a double-layer image with random pixels and random runs of opaque, transparent, transformed and mixed pixels
+    // so that the transform layer contains all types of pixel blocks, including blocks crossing row boundaries.
+    fheroes2::Sprite generateRandomSprite( const int32_t width, const int32_t height, std::mt19937 & generator )
+    {
+        fheroes2::Sprite sprite( width, height );
+
+        std::uniform_int_distribution<uint32_t> colorDistribution( 0, 255 );
+        std::uniform_int_distribution<uint32_t> transformDistribution( 2, 15 );
+        std::uniform_int_distribution<uint32_t> runTypeDistribution( 0, 3 );
+        std::uniform_int_distribution<size_t> runLengthDistribution( 1, 48 );
+
+        uint8_t * image = sprite.image();
+        uint8_t * transform = sprite.transform();
+        const size_t size = static_cast<size_t>( width ) * height;
+
+        for ( size_t i = 0; i < size; ) {
+            const uint32_t runType = runTypeDistribution( generator );
+            const size_t runEnd = std::min( size, i + runLengthDistribution( generator ) );
+
+            for ( ; i < runEnd; ++i ) {
+                image[i] = static_cast<uint8_t>( colorDistribution( generator ) );
+
+                switch ( runType ) {
+                case 0:
+                    transform[i] = 0;
+                    break;
+                case 1:
+                    transform[i] = 1;
+                    break;
+                case 2:
+                    transform[i] = static_cast<uint8_t>( transformDistribution( generator ) );
+                    break;
+                default: {
+                    const uint32_t value = colorDistribution( generator ) % 3;
+                    transform[i] = ( value < 2 ) ? static_cast<uint8_t>( value ) : static_cast<uint8_t>( transformDistribution( generator ) );
+                    break;
+                }
+                }
+            }
+        }
+
+        return sprite;
+    }
+
+    struct ImageRow
+    {
+        std::vector<uint8_t> image;
+        std::vector<uint8_t> transform;
+    };
+
+    // Generates a row of a double-layer image, see generateRandomSprite().
+    ImageRow generateRandomRow( const int32_t width, std::mt19937 & generator )
+    {
+        const fheroes2::Sprite sprite = generateRandomSprite( width, 1, generator );
+
+        return { { sprite.image(), sprite.image() + width }, { sprite.transform(), sprite.transform() + width } };
+    }
+
+    // Applies the operation to copies of the given output row with and without the block processing and compares the results.
+    bool verifyOperation( const std::string & name, const std::string & parameters, const ImageRow & output,
+                          const std::function<void( ImageRow &, const bool )> & operation )
+    {
+        ImageRow blockOutput( output );
+        ImageRow pixelOutput( output );
+
+        operation( blockOutput, true );
+        operation( pixelOutput, false );
+
+        if ( blockOutput.image == pixelOutput.image && blockOutput.transform == pixelOutput.transform ) {
+            return true;
+        }
+
+        std::cerr << "Mismatch: " << name << ' ' << parameters << std::endl;
+        return false;
+    }
+
+    // Compares the results of the block processing and the pixel by pixel processing of image rows for random widths, offsets
+    // (the rows are not aligned) and transform layers.
+    int runVerification( const uint32_t iterations )
+    {
+        if ( !fheroes2::ImageRow::isBlockProcessingSupported() ) {
+            std::cout << "The block processing is not supported on this platform, there is nothing to verify." << std::endl;
+            return EXIT_SUCCESS;
+        }
+
+        // Use a fixed seed so that all failures can be reproduced.
+        std::mt19937 generator( 0 );
+
+        std::uniform_int_distribution<uint32_t> byteDistribution( 0, 255 );
+
+        // AlphaBlit blends colors using the game palette which consists of 6-bit values.
+        std::vector<uint8_t> gamePalette( 768 );
+        for ( uint8_t & value : gamePalette ) {
+            value = static_cast<uint8_t>( byteDistribution( generator ) % 64 );
+        }
+
+        std::vector<uint8_t> palette( 256 );
+        for ( uint8_t & value : palette ) {
+            value = static_cast<uint8_t>( byteDistribution( generator ) );
+        }
+
+        std::uniform_int_distribution<int32_t> widthDistribution( 1, 200 );
+        std::uniform_int_distribution<int32_t> offsetDistribution( 0, 31 );
+        std::uniform_int_distribution<uint32_t> alphaDistribution( 1, 254 );
+
+        uint32_t failures = 0;
+
+        for ( uint32_t i = 0; i < iterations; ++i ) {
+            const int32_t width = widthDistribution( generator );
+            const int32_t inOffset = offsetDistribution( generator );
+            const int32_t outOffset = offsetDistribution( generator );
+            const uint8_t alphaValue = static_cast<uint8_t>( alphaDistribution( generator ) );
+
+            const ImageRow input = generateRandomRow( inOffset + width, generator );
+            const ImageRow output = generateRandomRow( outOffset + width, generator );
+
+            std::ostringstream os;
+            os << "iteration=" << i << " width=" << width << " in=" << inOffset << " out=" << outOffset << " alpha=" << static_cast<int>( alphaValue );
+            const std::string parameters = os.str();
+
+            const uint8_t * imageIn = input.image.data() + inOffset;
+            const uint8_t * transformIn = input.transform.data() + inOffset;
+
+            const auto blitToSingleLayer = [imageIn, transformIn, outOffset, width]( ImageRow & row, const bool useBlocks ) {
+                uint8_t * imageOut = row.image.data() + outOffset;
+                if ( useBlocks ) {
+                    fheroes2::ImageRow::blit<true>( imageIn, transformIn, imageOut, nullptr, width );
+                }
+                else {
+                    fheroes2::ImageRow::blit<false>( imageIn, transformIn, imageOut, nullptr, width );
+                }
+            };
+
+            const auto blitToDoubleLayer = [imageIn, transformIn, outOffset, width]( ImageRow & row, const bool useBlocks ) {
+                uint8_t * imageOut = row.image.data() + outOffset;
+                uint8_t * transformOut = row.transform.data() + outOffset;
+                if ( useBlocks ) {
+                    fheroes2::ImageRow::blit<true>( imageIn, transformIn, imageOut, transformOut, width );
+                }
+                else {
+                    fheroes2::ImageRow::blit<false>( imageIn, transformIn, imageOut, transformOut, width );
+                }
+            };
+
+            const auto alphaBlit = [imageIn, transformIn, outOffset, width, alphaValue, &gamePalette]( ImageRow & row, const bool useBlocks ) {
+                uint8_t * imageOut = row.image.data() + outOffset;
+                if ( useBlocks ) {
+                    fheroes2::ImageRow::alphaBlit<true>( imageIn, transformIn, imageOut, width, alphaValue, gamePalette.data() );
+                }
+                else {
+                    fheroes2::ImageRow::alphaBlit<false>( imageIn, transformIn, imageOut, width, alphaValue, gamePalette.data() );
+                }
+            };
+
+            const auto applyPalette = [imageIn, transformIn, outOffset, width, &palette]( ImageRow & row, const bool useBlocks ) {
+                uint8_t * imageOut = row.image.data() + outOffset;
+                if ( useBlocks ) {
+                    fheroes2::ImageRow::applyPalette<true>( imageIn, transformIn, imageOut, width, palette.data() );
+                }
+                else {
+                    fheroes2::ImageRow::applyPalette<false>( imageIn, transformIn, imageOut, width, palette.data() );
+                }
+            };
+
+            // ApplyTransform applies a palette to the same row.
+            const auto applyPaletteInPlace = [inOffset, width, &palette]( ImageRow & row, const bool useBlocks ) {
+                uint8_t * image = row.image.data() + inOffset;
+                const uint8_t * transform = row.transform.data() + inOffset;
+                if ( useBlocks ) {
+                    fheroes2::ImageRow::applyPalette<true>( image, transform, image, width, palette.data() );
+                }
+                else {
+                    fheroes2::ImageRow::applyPalette<false>( image, transform, image, width, palette.data() );
+                }
+            };
+
+            const bool isValid = verifyOperation( "Blit to single-layer row", parameters, output, blitToSingleLayer )
+                                 & verifyOperation( "Blit to double-layer row", parameters, output, blitToDoubleLayer )
+                                 & verifyOperation( "AlphaBlit", parameters, output, alphaBlit )
+                                 & verifyOperation( "ApplyPalette", parameters, output, applyPalette )
+                                 & verifyOperation( "ApplyPalette to the same row", parameters, input, applyPaletteInPlace );
+
+            if ( !isValid ) {
+                ++failures;
+            }
+        }
+
+        std::cout << iterations << " iterations verified, " << failures << " of them failed." << std::endl;
+
+        return failures == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+    }
+
+    // Runs the function repeatedly for at least the given amount of time.
+    BenchmarkResult runBenchmark( const std::function<void()> & function, const double minimumDurationS )
+    {
+        // Warm up caches and lazily initialized tables.
+        function();
+
+        BenchmarkResult result;
+        uint64_t batchSize = 1;
+
+        const fheroes2::Time timer;
+
+        while ( true ) {
+            for ( uint64_t i = 0; i < batchSize; ++i ) {
+                function();
+            }
+
+            result.calls += batchSize;
+            result.seconds = timer.getS();
+
+            if ( result.seconds >= minimumDurationS ) {
+                break;
+            }
+
+            batchSize *= 2;
+        }
+
+        return result;
+    }
+
+    void reportResult( const std::string & name, const fheroes2::Size & size, const BenchmarkResult & result )
+    {
+        const double pixels = static_cast<double>( size.width ) * size.height;
+        const double latencyUs = result.seconds * 1000000 / static_cast<double>( result.calls );
+        const double throughputMPs = pixels * static_cast<double>( result.calls ) / result.seconds / 1000000;
+
+        std::cout << name << ',' << size.width << ',' << size.height << ',' << result.calls << ',' << std::fixed << std::setprecision( 3 ) << latencyUs << ','
+                  << throughputMPs << std::defaultfloat << std::endl;
+    }
+}
+
+int main( int argc, char ** argv )
+{
+    double minimumDurationS = defaultMinimumDurationS;
+
+    const bool isVerificationMode = ( argc > 1 && std::string( argv[1] ) == "--verify" );
+
+    if ( argc > ( isVerificationMode ? 3 : 2 ) ) {
+        const std::string toolName = System::GetFileName( argv[0] );
+
+        std::cerr << toolName << " measures the performance of the engine image routines and writes the results in CSV format." << std::endl
+                  << "In the verification mode it compares the results of the block processing with the pixel by pixel processing." << std::endl
+                  << "Syntax: " << toolName << " [minimum_duration_per_benchmark_in_ms]" << std::endl
+                  << "        " << toolName << " --verify [number_of_iterations]" << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    if ( isVerificationMode ) {
+        uint32_t iterations = defaultVerificationIterations;
+
+        if ( argc == 3 ) {
+            const int32_t value = std::atoi( argv[2] );
+            if ( value <= 0 ) {
+                std::cerr << "Invalid number of iterations " << argv[2] << std::endl;
+                return EXIT_FAILURE;
+            }
+
+            iterations = static_cast<uint32_t>( value );
+        }
+
+        return runVerification( iterations );
+    }
+
+    if ( argc == 2 ) {
+        const int32_t durationMs = std::atoi( argv[1] );
+        if ( durationMs <= 0 ) {
+            std::cerr << "Invalid benchmark duration " << argv[1] << std::endl;
+            return EXIT_FAILURE;
+        }
+
+        minimumDurationS = durationMs / 1000.0;
+    }
+
+    // Use a fixed seed so that all runs process exactly the same data.
+    std::mt19937 generator( 0 );
+
+    // Typical sizes of an adventure map tile, a battle creature, a castle building and a dialog window.
+    const std::vector<fheroes2::Size> spriteSizes{ { 32, 32 }, { 100, 120 }, { 200, 150 }, { 400, 300 } };
+
+    // The original game resolution and a common modern resolution.
+    const std::vector<fheroes2::Size> screenSizes{ { 640, 480 }, { 1920, 1080 } };
+
+    std::vector<uint8_t> palette( 256 );
+    for ( size_t i = 0; i < palette.size(); ++i ) {
+        palette[i] = static_cast<uint8_t>( 255 - i );
+    }
+
+    std::cout << "benchmark,width,height,calls,latency_us,throughput_mps" << std::endl;
+
+    for ( const fheroes2::Size & screenSize : screenSizes ) {
+        fheroes2::Image screen = generateScreen( screenSize.width, screenSize.height, generator );
+        const std::string suffix = "_" + std::to_string( screenSize.width ) + "x" + std::to_string( screenSize.height );
+
+        for ( const fheroes2::Size & spriteSize : spriteSizes ) {
+            const fheroes2::Sprite sprite = generateSprite( spriteSize.width, spriteSize.height, generator );
+            const int32_t outX = ( screenSize.width - spriteSize.width ) / 2;
+            const int32_t outY = ( screenSize.height - spriteSize.height ) / 2;
+
+            reportResult( "Blit" + suffix, spriteSize, runBenchmark( [&sprite, &screen, outX, outY]() { fheroes2::Blit( sprite, screen, outX, outY ); }, minimumDurationS ) );
+            reportResult( "BlitFlip" + suffix, spriteSize,
+                          runBenchmark( [&sprite, &screen, outX, outY]() { fheroes2::Blit( sprite, screen, outX, outY, true ); }, minimumDurationS ) );
+            reportResult( "AlphaBlit" + suffix, spriteSize,
+                          runBenchmark( [&sprite, &screen, outX, outY]() { fheroes2::AlphaBlit( sprite, screen, outX, outY, 128 ); }, minimumDurationS ) );
+        }
+
+        const fheroes2::Image original = screen;
+
+        reportResult( "ApplyPaletteScreen" + suffix, screenSize, runBenchmark( [&screen, &palette]() { fheroes2::ApplyPalette( screen, palette ); }, minimumDurationS ) );
+        reportResult( "CopyScreen" + suffix, screenSize, runBenchmark( [&original, &screen]() { fheroes2::Copy( original, screen ); }, minimumDurationS ) );
+        reportResult( "FlipScreen" + suffix, screenSize,
+                      runBenchmark( [&original, &screen]() { fheroes2::Flip( original, 0, 0, screen, 0, 0, original.width(), original.height(), true, false ); },
+                                    minimumDurationS ) );
+
+        // Scaling of the original game resolution screen to the current one.
+        const fheroes2::Image originalResolution = generateScreen( 640, 480, generator );
+        reportResult( "ResizeScreen" + suffix, screenSize,
+                      runBenchmark( [&originalResolution, &screen]() { fheroes2::Resize( originalResolution, screen ); }, minimumDurationS ) );
+        reportResult( "SubpixelResizeScreen" + suffix, screenSize,
+                      runBenchmark( [&originalResolution, &screen]() { fheroes2::SubpixelResize( originalResolution, screen ); }, minimumDurationS ) );
+    }
+
+    for ( const fheroes2::Size & spriteSize : spriteSizes ) {
+        const fheroes2::Sprite sprite = generateSprite( spriteSize.width, spriteSize.height, generator );
+        fheroes2::Sprite output( spriteSize.width, spriteSize.height );
+        fheroes2::Sprite resized( spriteSize.width * 2, spriteSize.height * 2 );
+
+        reportResult( "ApplyPalette", spriteSize, runBenchmark( [&sprite, &output, &palette]() { fheroes2::ApplyPalette( sprite, output, palette ); }, minimumDurationS ) );
+        reportResult( "CreateContour", spriteSize, runBenchmark( [&sprite]() { (void)fheroes2::CreateContour( sprite, 10 ); }, minimumDurationS ) );
+        reportResult( "addShadow", spriteSize,
+                      runBenchmark( [&sprite]() { (void)fheroes2::addShadow( sprite, { -2, 2 }, shadowTransformId ); }, minimumDurationS ) );
+        reportResult( "Flip", spriteSize, runBenchmark( [&sprite]() { (void)fheroes2::Flip( sprite, true, false ); }, minimumDurationS ) );
+        reportResult( "Resize", { resized.width(), resized.height() }, runBenchmark( [&sprite, &resized]() { fheroes2::Resize( sprite, resized ); }, minimumDurationS ) );
+        reportResult( "SubpixelResize", { resized.width(), resized.height() },
+                      runBenchmark( [&sprite, &resized]() { fheroes2::SubpixelResize( sprite, resized ); }, minimumDurationS ) );
+    }
+
+    return EXIT_SUCCESS;
+}